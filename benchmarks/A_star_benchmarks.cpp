@@ -0,0 +1,119 @@
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "benchmark.hpp"
+
+#include "AI/A_star.hpp"
+#include "tile_map.hpp"
+
+static constexpr int CELLS = 32;      ///< per side, of the maze and cluttered maps
+static constexpr int CELL_SIZE = 4;   ///< tiles per side of a cell, including one wall
+static constexpr int MAP_SIZE = CELLS * CELL_SIZE + 1;
+
+static TileMap make_open()
+{
+    return TileMap(MAP_SIZE, MAP_SIZE);
+}
+
+/** \brief A perfect maze of 3 tile wide corridors, so the only path winds through most of it. */
+static TileMap make_maze()
+{
+    TileMap map(MAP_SIZE, MAP_SIZE, Tile{false});
+    std::vector<bool> is_visited(CELLS * CELLS, false);
+    std::vector<sf::Vector2i> stack = {{0, 0}};
+    std::mt19937 random(7);
+
+    auto open = [&map](const sf::Vector2i& min, const sf::Vector2i& dimensions)
+    {
+        map.fill(min, dimensions, Tile{true});
+    };
+
+    is_visited[0] = true;
+    open({1, 1}, {CELL_SIZE - 1, CELL_SIZE - 1});
+    while (!stack.empty()) {
+        const auto cell = stack.back();
+
+        std::vector<sf::Vector2i> unvisited;
+        for(const auto& step : {sf::Vector2i(1, 0), sf::Vector2i(-1, 0),
+                                sf::Vector2i(0, 1), sf::Vector2i(0, -1)}) {
+            const auto next = cell + step;
+            if (next.x >= 0 && next.x < CELLS && next.y >= 0 && next.y < CELLS &&
+                !is_visited[next.y * CELLS + next.x]) {
+                unvisited.push_back(next);
+            }
+        }
+        if (unvisited.empty()) {
+            stack.pop_back();
+            continue;
+        }
+
+        // carve through the wall between the cells, and the next cell itself
+        const auto next = unvisited[random() % unvisited.size()];
+        const auto min = sf::Vector2i(std::min(cell.x, next.x), std::min(cell.y, next.y));
+        const auto max = sf::Vector2i(std::max(cell.x, next.x), std::max(cell.y, next.y));
+        open(min * CELL_SIZE + sf::Vector2i(1, 1),
+             (max - min) * CELL_SIZE + sf::Vector2i(CELL_SIZE - 1, CELL_SIZE - 1));
+
+        is_visited[next.y * CELLS + next.x] = true;
+        stack.push_back(next);
+    }
+
+    return map;
+}
+
+/** \brief Scattered 2x2 obstacles, always leaving corridors 2 tiles wide between them. */
+static TileMap make_cluttered()
+{
+    TileMap map(MAP_SIZE, MAP_SIZE);
+    std::mt19937 random(11);
+    std::bernoulli_distribution is_blocked(0.6);
+
+    for (int y = 0; y < CELLS; ++y) {
+        for (int x = 0; x < CELLS; ++x) {
+            const bool is_corner = (x == 0 && y == 0) || (x == CELLS - 1 && y == CELLS - 1);
+            if (!is_corner && is_blocked(random)) {
+                map.fill({x * CELL_SIZE + 2, y * CELL_SIZE + 2}, {2, 2}, Tile{false});
+            }
+        }
+    }
+
+    return map;
+}
+
+static const TileMap open = make_open();
+static const TileMap maze = make_maze();
+static const TileMap cluttered = make_cluttered();
+
+/** \brief Registers a search from the TL to the BR corner of the map, for each size and mode.
+ *
+ * \return Number of benchmarks registered. */
+static std::size_t register_searches(const std::string& map_name, const TileMap& map,
+                                     const std::vector<int>& sizes)
+{
+    std::size_t count = 0;
+    for(const auto size : sizes) {
+        for(const auto mode : {AStar::Mode::A_STAR, AStar::Mode::JUMP_POINT}) {
+            const auto name = "AStar::run/" + map_name + "/" + std::to_string(size) + "x" +
+                              std::to_string(size) +
+                              (mode == AStar::Mode::JUMP_POINT ? "/jump_point" : "/a_star");
+            const sf::Vector2i dimensions(size, size);
+            const sf::Vector2i start(1, 1);
+            const sf::Vector2i end = sf::Vector2i(MAP_SIZE - 1, MAP_SIZE - 1) - dimensions;
+
+            Benchmark(name, [&map, start, end, dimensions, mode](std::size_t iterations) {
+                for (std::size_t ndx = 0; ndx < iterations; ++ndx) {
+                    Benchmark::keep(AStar::run(start, end, dimensions, map, mode));
+                }
+            });
+            ++count;
+        }
+    }
+
+    return count;
+}
+
+static const auto open_searches = register_searches("open", open, {1, 2, 3});
+static const auto maze_searches = register_searches("maze", maze, {1, 2, 3});
+static const auto cluttered_searches = register_searches("cluttered", cluttered, {1, 2});
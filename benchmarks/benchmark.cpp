@@ -0,0 +1,148 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <thread>
+#include <utility>
+
+#include "benchmark.hpp"
+
+static constexpr int BATCHES = 3;
+static constexpr std::size_t MAX_ITERATIONS = 1000000000;
+
+Benchmark::Benchmark(std::string name, Body body, Fixture set_up, Fixture tear_down)
+{
+    get_entries().push_back(Entry{std::move(name), std::move(body), std::move(set_up),
+                                  std::move(tear_down)});
+}
+
+int
+Benchmark::run_all(int argc, char* argv[])
+{
+    std::string filter;
+    std::string json_path;
+    double min_seconds = 0.2;
+
+    for (int ndx = 1; ndx < argc; ++ndx) {
+        const std::string arg = argv[ndx];
+        if (arg.compare(0, 9, "--filter=") == 0) {
+            filter = arg.substr(9);
+        } else if (arg.compare(0, 11, "--min_time=") == 0) {
+            min_seconds = std::atof(arg.c_str() + 11);
+        } else if (arg.compare(0, 7, "--json=") == 0) {
+            json_path = arg.substr(7);
+        } else {
+            std::cerr << "usage: " << argv[0]
+                      << " [--filter=substring] [--min_time=seconds] [--json=path]" << std::endl;
+            return 1;
+        }
+    }
+
+    std::vector<Result> results;
+    std::printf("%-48s %14s %14s %12s\n", "Benchmark", "Time (ns)", "CPU (ns)", "Iterations");
+    for(const auto& entry : get_entries()) {
+        if (entry.name.find(filter) == std::string::npos) {
+            continue;
+        }
+
+        results.push_back(run(entry, min_seconds));
+        const auto& result = results.back();
+        std::printf("%-48s %14.1f %14.1f %12zu\n", result.name.c_str(), result.real_ns,
+                    result.cpu_ns, result.iterations);
+        std::fflush(stdout);
+    }
+
+    if (!json_path.empty()) {
+        std::ofstream out(json_path);
+        if (!out) {
+            std::cerr << "Can't write " << json_path << std::endl;
+            return 1;
+        }
+
+        char date[32];
+        const auto now = std::time(nullptr);
+        std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+        out << "{\n"
+            << "  \"context\": {\n"
+            << "    \"date\": \"" << date << "\",\n"
+            << "    \"executable\": \"" << argv[0] << "\",\n"
+            << "    \"num_cpus\": " << std::thread::hardware_concurrency() << ",\n"
+            << "    \"library_build_type\": \"release\"\n"
+            << "  },\n"
+            << "  \"benchmarks\": [";
+        for(const auto& result : results) {
+            out << (&result == &results.front() ? "\n" : ",\n")
+                << "    {\n"
+                << "      \"name\": \"" << result.name << "\",\n"
+                << "      \"run_type\": \"iteration\",\n"
+                << "      \"iterations\": " << result.iterations << ",\n"
+                << "      \"real_time\": " << result.real_ns << ",\n"
+                << "      \"cpu_time\": " << result.cpu_ns << ",\n"
+                << "      \"time_unit\": \"ns\"\n"
+                << "    }";
+        }
+        out << "\n  ]\n}\n";
+    }
+
+    return 0;
+}
+
+std::vector<Benchmark::Entry>&
+Benchmark::get_entries()
+{
+    static std::vector<Entry> entries;
+    return entries;
+}
+
+Benchmark::Result
+Benchmark::run(const Entry& entry, double min_seconds)
+{
+    auto time_batch = [&entry](std::size_t iterations, double& cpu_seconds)
+    {
+        if (entry.set_up) {
+            entry.set_up();
+        }
+
+        const auto cpu_begin = std::clock();
+        const auto begin = std::chrono::steady_clock::now();
+        entry.body(iterations);
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - begin;
+        cpu_seconds = static_cast<double>(std::clock() - cpu_begin) / CLOCKS_PER_SEC;
+
+        if (entry.tear_down) {
+            entry.tear_down();
+        }
+        return elapsed.count();
+    };
+
+    // grow the batch until it is long enough to time, which also warms up the caches
+    std::size_t iterations = 1;
+    double cpu_seconds = 0.0;
+    for (double seconds = time_batch(iterations, cpu_seconds);
+         seconds < min_seconds && iterations < MAX_ITERATIONS;
+         seconds = time_batch(iterations, cpu_seconds)) {
+        const double scale = seconds > 0.0 ? std::min(1.4 * min_seconds / seconds, 10.0) : 10.0;
+        const auto scaled = static_cast<std::size_t>(iterations * scale);
+        iterations = std::min(MAX_ITERATIONS, std::max(iterations * 2, scaled));
+    }
+
+    std::pair<double, double> batches[BATCHES]; ///< <real, cpu> seconds
+    for(auto& batch : batches) {
+        batch.first = time_batch(iterations, batch.second);
+    }
+    std::sort(std::begin(batches), std::end(batches));
+    const auto& median = batches[BATCHES / 2];
+
+    return Result{entry.name, iterations, 1e9 * median.first / iterations,
+                  1e9 * median.second / iterations};
+}
+
+int main(int argc, char* argv[])
+{
+    return Benchmark::run_all(argc, argv);
+}
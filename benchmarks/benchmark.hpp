@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+/** \brief A small stand-in for Google Benchmark, which times registered functions.
+ *
+ * Each benchmark registers itself with a static Benchmark object. Its body runs the timed code a
+ * given number of times, and the runner grows that number until a batch takes at least the
+ * minimum time, then reports the median time per iteration over a few such batches.
+ *
+ * Results are printed as a table, and can be written as JSON in the same layout as Google
+ * Benchmark's --benchmark_out, so its tools can compare two runs.
+ *
+ * usage: shooty_face_benchmarks [--filter=substring] [--min_time=seconds] [--json=path] */
+class Benchmark
+{
+public:
+    /** \brief Runs the timed code iterations times. */
+    using Body = std::function<void(std::size_t iterations)>;
+
+    /** \brief Runs around each timed batch, and isn't timed itself. */
+    using Fixture = std::function<void()>;
+
+    /** \brief Registers the benchmark, to be run by run_all(). */
+    Benchmark(std::string name, Body body, Fixture set_up = nullptr, Fixture tear_down = nullptr);
+
+    /** \brief Keeps the compiler from optimizing away the computation of value. */
+    template<class T>
+    static inline void keep(const T& value)
+    {
+        asm volatile("" : : "g"(&value) : "memory");
+    }
+
+    /** \brief Runs every registered benchmark matching the command line's filter.
+     *
+     * \return Exit code for main(), non-zero when the command line is bad. */
+    static int run_all(int argc, char* argv[]);
+
+private:
+    struct Entry
+    {
+        std::string name;
+        Body body;
+        Fixture set_up;
+        Fixture tear_down;
+    };
+
+    struct Result
+    {
+        std::string name;
+        std::size_t iterations; ///< per batch
+        double real_ns;         ///< per iteration, median over the batches
+        double cpu_ns;          ///< per iteration, of the same batch as real_ns
+    };
+
+    /** \brief Benchmarks in registration order, which is by file, then by order in the file. */
+    static std::vector<Entry>& get_entries();
+
+    static Result run(const Entry& entry, double min_seconds);
+};
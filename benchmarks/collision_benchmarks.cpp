@@ -0,0 +1,81 @@
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "benchmark.hpp"
+
+#include "AABB.hpp"
+#include "collision.hpp"
+
+using Pairs = std::vector<std::pair<AABB, AABB>>;
+
+/** \brief Pairs of a moving box and a still one, scattered so some are near and some are not, and
+ * the branches taken don't follow a pattern. */
+static Pairs make_pairs()
+{
+    std::mt19937 random(42);
+    std::uniform_real_distribution<float> position(0.f, 200.f);
+    std::uniform_real_distribution<float> dimension(5.f, 40.f);
+    std::uniform_real_distribution<float> trajectory(-20.f, 20.f);
+
+    Pairs pairs;
+    for (int ndx = 0; ndx < 1024; ++ndx) {
+        pairs.emplace_back(AABB({position(random), position(random)},
+                                {dimension(random), dimension(random)},
+                                {trajectory(random), trajectory(random)}),
+                           AABB({position(random), position(random)},
+                                {dimension(random), dimension(random)}));
+    }
+
+    return pairs;
+}
+
+/** \brief Only the pairs which pass the broad test, as the narrow test is only run on those. */
+static Pairs make_near_pairs()
+{
+    Pairs near_pairs;
+    for(const auto& pair : make_pairs()) {
+        if (Collision::broad_test(pair.first, pair.second)) {
+            near_pairs.push_back(pair);
+        }
+    }
+
+    return near_pairs;
+}
+
+static const Pairs pairs = make_pairs();
+static const Pairs near_pairs = make_near_pairs();
+
+static Benchmark broad_test("Collision::broad_test", [](std::size_t iterations) {
+    for (std::size_t ndx = 0; ndx < iterations; ++ndx) {
+        const auto& pair = pairs[ndx % pairs.size()];
+        Benchmark::keep(Collision::broad_test(pair.first, pair.second));
+    }
+});
+
+static Benchmark narrow_test("Collision::narrow_test", [](std::size_t iterations) {
+    for (std::size_t ndx = 0; ndx < iterations; ++ndx) {
+        const auto& pair = near_pairs[ndx % near_pairs.size()];
+        Benchmark::keep(Collision::narrow_test(pair.first, pair.second));
+    }
+});
+
+static Benchmark get_penetration("Collision::get_penetration", [](std::size_t iterations) {
+    for (std::size_t ndx = 0; ndx < iterations; ++ndx) {
+        const auto& pair = near_pairs[ndx % near_pairs.size()];
+        Benchmark::keep(Collision::get_penetration(pair.first, pair.second));
+    }
+});
+
+static Benchmark minkowski_difference("AABB::minkowski_difference", [](std::size_t iterations) {
+    for (std::size_t ndx = 0; ndx < iterations; ++ndx) {
+        const auto& pair = pairs[ndx % pairs.size()];
+        Benchmark::keep(AABB::minkowski_difference(pair.first, pair.second));
+    }
+});
+
+static Benchmark state_space_for("AABB::state_space_for", [](std::size_t iterations) {
+    for (std::size_t ndx = 0; ndx < iterations; ++ndx) {
+        Benchmark::keep(AABB::state_space_for(pairs[ndx % pairs.size()].first));
+    }
+});
@@ -0,0 +1,81 @@
+#include "benchmark.hpp"
+
+#include "demo_scene.hpp"
+#include "enemy.hpp"
+#include "game.hpp"
+#include "components/physics.hpp"
+
+static Enemy* enemy = nullptr; ///< One enemy of the scene, for the benchmark to move or ignore
+
+/** \brief The demo's walls and 24 enemies. */
+static void set_up_demo()
+{
+    Game::instance().reset();
+    enemy = DemoScene::build().enemy_example;
+}
+
+/** \brief The demo's walls, and a 20x20 grid of enemies, about a third of the map. */
+static void set_up_crowd()
+{
+    set_up_demo();
+
+    auto& game = Game::instance();
+    for (int y = 0; y < 20; ++y) {
+        for (int x = 0; x < 20; ++x) {
+            auto* crowd_enemy = new Enemy();
+            crowd_enemy->get_component<Physics>()->set_position({100.f + 50.f * x,
+                                                                 100.f + 50.f * y});
+            game.entity_collection().emplace_back(crowd_enemy);
+        }
+    }
+}
+
+static void tear_down()
+{
+    Game::instance().reset();
+    enemy = nullptr;
+}
+
+/** \brief Syncs the maps, as each simulation step does, then takes a view of them. */
+static void get_map(std::size_t iterations)
+{
+    auto& game = Game::instance();
+    for (std::size_t ndx = 0; ndx < iterations; ++ndx) {
+        game.sync_occupancy();
+        auto view = game.get_map();
+        Benchmark::keep(view.get_word(0, 0));
+    }
+}
+
+static void get_map_ignoring_an_enemy(std::size_t iterations)
+{
+    auto& game = Game::instance();
+    const auto* physics = enemy->get_component<Physics>();
+    for (std::size_t ndx = 0; ndx < iterations; ++ndx) {
+        game.sync_occupancy();
+        auto view = game.get_map(enemy);
+        Benchmark::keep(view.is_passable(Game::get_tile_for(physics->get_position())));
+    }
+}
+
+/** \brief The enemy steps a tile back and forth, so its footprint moves on every call. */
+static void get_map_with_an_enemy_moving(std::size_t iterations)
+{
+    auto& game = Game::instance();
+    auto* physics = enemy->get_component<Physics>();
+    for (std::size_t ndx = 0; ndx < iterations; ++ndx) {
+        physics->move({ndx % 2 == 0 ? 20.f : -20.f, 0.f});
+        game.sync_occupancy();
+        auto view = game.get_map(enemy);
+        Benchmark::keep(view.is_passable(Game::get_tile_for(physics->get_position())));
+    }
+}
+
+static Benchmark demo("Game::get_map/demo", get_map, set_up_demo, tear_down);
+static Benchmark demo_ignoring("Game::get_map/demo/ignoring_an_enemy",
+                               get_map_ignoring_an_enemy, set_up_demo, tear_down);
+static Benchmark demo_moving("Game::get_map/demo/an_enemy_moving",
+                             get_map_with_an_enemy_moving, set_up_demo, tear_down);
+static Benchmark crowd("Game::get_map/crowd", get_map, set_up_crowd, tear_down);
+static Benchmark crowd_moving("Game::get_map/crowd/an_enemy_moving",
+                              get_map_with_an_enemy_moving, set_up_crowd, tear_down);
@@ -0,0 +1,365 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "allocation_counter.hpp"
+#include "barrier.hpp"
+#include "bullet.hpp"
+#include "enemy.hpp"
+#include "game.hpp"
+#include "gun.hpp"
+#include "job_system.hpp"
+#include "player.hpp"
+#include "shape_batch.hpp"
+#include "simulation.hpp"
+
+#include "components/health.hpp"
+#include "components/physics.hpp"
+
+/** \brief A world sized to fit any number of enemies, all closing in on the player, who keeps a
+ * given number of bullets in the air.
+ *
+ * Built from the same pieces as the demo scene: walls around the world, a grid of Enemy, and a Gun
+ * of BulletAmmunition for the player. Enemies can't be killed, so the load stays the same however
+ * long the scene runs. The view is a window around the player, as the game would show. */
+struct StressScene
+{
+    static constexpr float SPACING = 60.f;          ///< between enemies on the grid, a tile apart
+    static constexpr float BORDER_THICKNESS = 20.f;
+    static constexpr int CLEARING = 2;              ///< cells left empty each side of the player
+
+    Player* player;
+    Gun* gun;
+    std::size_t bullet_count;
+    std::size_t fired;
+
+    /** \brief Resets the Game, and adds the scene's entities to it. */
+    static StressScene build(std::size_t enemy_count, std::size_t bullet_count, bool is_lod_enabled)
+    {
+        auto& game = Game::instance();
+        game.reset();
+
+        // enough cells for every enemy, once the clearing around the player is left empty
+        auto cells = static_cast<int>(std::ceil(std::sqrt(static_cast<float>(enemy_count))));
+        while (cells * cells - (2 * CLEARING + 1) * (2 * CLEARING + 1) <
+               static_cast<int>(enemy_count)) {
+            ++cells;
+        }
+        const float side = 2.f * BORDER_THICKNESS + cells * SPACING;
+        game.set_world_dimensions({side, side});
+
+        auto& player = *game.add_player();
+        const int center = cells / 2;
+        player.get_component<Physics>()->set_position(get_cell_position(center, center));
+        game.set_view(AABB(get_cell_position(center, center),
+                           sf::Vector2f(Game::WINDOW_WIDTH, Game::WINDOW_HEIGHT)));
+        game.set_lod_enabled(is_lod_enabled);
+
+        game.entity_collection().push_back(std::make_unique<Gun>(player));
+        Gun& gun = static_cast<Gun&>(*game.entity_collection().back().get());
+        gun.set_ammunition(std::make_unique<BulletAmmunition>());
+
+        const sf::Vector2f positions[] = {{side/2.f, BORDER_THICKNESS/2.f},
+                                          {BORDER_THICKNESS/2.f, side/2.f},
+                                          {side/2.f, side - BORDER_THICKNESS/2.f},
+                                          {side - BORDER_THICKNESS/2.f, side/2.f}};
+        for (int ndx = 0; ndx < 4; ++ndx) {
+            auto* barrier = new Barrier();
+            barrier->get_component<Physics>()->set_position(positions[ndx]);
+            barrier->get_component<Physics>()->set_dimensions(
+                ndx % 2 == 0 ? sf::Vector2f(side, BORDER_THICKNESS)
+                             : sf::Vector2f(BORDER_THICKNESS, side));
+            game.entity_collection().emplace_back(barrier);
+        }
+
+        std::size_t placed = 0;
+        for (int y = 0; y < cells && placed < enemy_count; ++y) {
+            for (int x = 0; x < cells && placed < enemy_count; ++x) {
+                if (std::abs(x - center) <= CLEARING && std::abs(y - center) <= CLEARING) {
+                    continue;
+                }
+
+                auto* enemy = new Enemy();
+                enemy->emplace_component<Health>(std::numeric_limits<float>::max());
+                enemy->get_component<Physics>()->set_position(get_cell_position(x, y));
+                game.entity_collection().emplace_back(enemy);
+                ++placed;
+            }
+        }
+
+        return StressScene{&player, &gun, bullet_count, 0};
+    }
+
+    static sf::Vector2f get_cell_position(int x, int y)
+    {
+        return sf::Vector2f(BORDER_THICKNESS + (x + 0.5f) * SPACING,
+                            BORDER_THICKNESS + (y + 0.5f) * SPACING);
+    }
+
+    /** \brief Fires as many bullets as have been lost since the last call, in a spiral. */
+    void top_up()
+    {
+        const auto position = player->get_component<Physics>()->get_position();
+        while (gun->get_projectile_count() < bullet_count) {
+            const float angle = 2.39996f * fired++; // the golden angle, for an even spread
+
+            // reloading skips the rate limit, to keep bullet_count in flight
+            gun->reload();
+            gun->fire(position + 200.f * sf::Vector2f(std::cos(angle), std::sin(angle)));
+        }
+    }
+};
+
+struct Result
+{
+    std::size_t enemy_count;
+    std::size_t bullet_count;
+    bool is_lod_enabled;       ///< for what is out of view
+    std::size_t entity_count;  ///< In the Game, once the scene is built
+    int ticks;
+    double ticks_per_second;
+    double p50_ms;
+    double p99_ms;
+    double max_ms;
+    double allocations;        ///< per tick
+    double bytes;              ///< allocated per tick
+    double render_allocations; ///< per frame rendered, one after each tick
+    double render_bytes;       ///< allocated per frame rendered
+};
+
+/** \brief Allocations made over some span of the run. */
+struct Allocations
+{
+    std::size_t count;
+    std::size_t bytes;
+};
+
+/** \brief Collects the renderings of a frame into ShapeBatch, as the game does, without drawing.
+ *
+ * \return Allocations made. */
+static Allocations
+render(Renderer::Renderings& renderings, ShapeBatch& batch)
+{
+    const auto allocations = AllocationCounter::get_count();
+    const auto bytes = AllocationCounter::get_bytes();
+
+    renderings.clear();
+    Game::instance().render(renderings);
+    batch.clear();
+    batch.add(renderings);
+
+    return {AllocationCounter::get_count() - allocations, AllocationCounter::get_bytes() - bytes};
+}
+
+/** \brief Runs a scene of the given size for warm_up_ticks, then times it for ticks.
+ *
+ * Each tick tops up the bullets, then steps the simulation once. A frame is rendered after each
+ * tick, outside of its time, to count the allocations made by rendering on their own. */
+static Result
+run(std::size_t enemy_count, std::size_t bullet_count, bool is_lod_enabled, int warm_up_ticks,
+    int ticks)
+{
+    auto scene = StressScene::build(enemy_count, bullet_count, is_lod_enabled);
+    Simulation simulation;
+    Renderer::Renderings renderings;
+    ShapeBatch batch;
+
+    for (int tick = 0; tick < warm_up_ticks; ++tick) {
+        scene.top_up();
+        simulation.step();
+        render(renderings, batch);
+    }
+
+    std::vector<double> tick_ms;
+    tick_ms.reserve(ticks);
+    Allocations rendered = {0, 0};
+    std::chrono::steady_clock::duration rendering(0);
+    const auto allocations = AllocationCounter::get_count();
+    const auto bytes = AllocationCounter::get_bytes();
+    const auto begin = std::chrono::steady_clock::now();
+    for (int tick = 0; tick < ticks; ++tick) {
+        const auto tick_begin = std::chrono::steady_clock::now();
+        scene.top_up();
+        simulation.step();
+        const auto tick_end = std::chrono::steady_clock::now();
+        tick_ms.push_back(std::chrono::duration<double, std::milli>(tick_end - tick_begin).count());
+
+        const auto frame = render(renderings, batch);
+        rendered.count += frame.count;
+        rendered.bytes += frame.bytes;
+        rendering += std::chrono::steady_clock::now() - tick_end;
+    }
+    const std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - begin - rendering;
+
+    Result result;
+    result.enemy_count = enemy_count;
+    result.bullet_count = bullet_count;
+    result.is_lod_enabled = is_lod_enabled;
+    result.entity_count = Game::instance().entities().size();
+    result.ticks = ticks;
+    result.ticks_per_second = ticks / elapsed.count();
+    result.render_allocations = static_cast<double>(rendered.count) / ticks;
+    result.render_bytes = static_cast<double>(rendered.bytes) / ticks;
+    result.allocations = static_cast<double>(AllocationCounter::get_count() - allocations -
+                                             rendered.count) / ticks;
+    result.bytes = static_cast<double>(AllocationCounter::get_bytes() - bytes -
+                                       rendered.bytes) / ticks;
+
+    // nearest rank, as for the profiler's stats
+    std::sort(tick_ms.begin(), tick_ms.end());
+    auto rank = [&tick_ms](double percentile)
+    {
+        const auto ndx = static_cast<std::size_t>(std::ceil(percentile * tick_ms.size()));
+        return tick_ms[std::max<std::size_t>(ndx, 1) - 1];
+    };
+    result.p50_ms = rank(0.50);
+    result.p99_ms = rank(0.99);
+    result.max_ms = tick_ms.back();
+
+    Game::instance().reset();
+    return result;
+}
+
+/** \return The comma separated counts, or nothing if any of them isn't a positive number. */
+static std::vector<std::size_t>
+parse_counts(const std::string& list)
+{
+    std::vector<std::size_t> counts;
+    std::size_t begin = 0;
+    while (begin <= list.size()) {
+        auto end = list.find(',', begin);
+        if (end == std::string::npos) {
+            end = list.size();
+        }
+
+        const auto count = std::atol(list.substr(begin, end - begin).c_str());
+        if (count <= 0) {
+            return {};
+        }
+        counts.push_back(count);
+        begin = end + 1;
+    }
+    return counts;
+}
+
+static void
+write_json(std::ostream& out, const char* executable, const std::vector<Result>& results)
+{
+    char date[32];
+    const auto now = std::time(nullptr);
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+    out << "{\n"
+        << "  \"context\": {\n"
+        << "    \"date\": \"" << date << "\",\n"
+        << "    \"executable\": \"" << executable << "\",\n"
+        << "    \"num_cpus\": " << std::thread::hardware_concurrency() << ",\n"
+        << "    \"worker_threads\": " << JobSystem::instance().get_thread_count() << ",\n"
+        << "    \"library_build_type\": \"release\"\n"
+        << "  },\n"
+        << "  \"benchmarks\": [";
+    for(const auto& result : results) {
+        out << (&result == &results.front() ? "\n" : ",\n")
+            << "    {\n"
+            << "      \"name\": \"StressScene/enemies:" << result.enemy_count
+            <<                            "/bullets:" << result.bullet_count
+            << (result.is_lod_enabled ? "/lod" : "") << "\",\n"
+            << "      \"run_type\": \"iteration\",\n"
+            << "      \"iterations\": " << result.ticks << ",\n"
+            << "      \"real_time\": " << 1e3 / result.ticks_per_second << ",\n"
+            << "      \"cpu_time\": " << 1e3 / result.ticks_per_second << ",\n"
+            << "      \"time_unit\": \"ms\",\n"
+            << "      \"ticks_per_second\": " << result.ticks_per_second << ",\n"
+            << "      \"p50_ms\": " << result.p50_ms << ",\n"
+            << "      \"p99_ms\": " << result.p99_ms << ",\n"
+            << "      \"max_ms\": " << result.max_ms << ",\n"
+            << "      \"allocations_per_tick\": " << result.allocations << ",\n"
+            << "      \"bytes_per_tick\": " << result.bytes << ",\n"
+            << "      \"render_allocations_per_frame\": " << result.render_allocations << ",\n"
+            << "      \"render_bytes_per_frame\": " << result.render_bytes << "\n"
+            << "    }";
+    }
+    out << "\n  ]\n}\n";
+}
+
+/** \brief Times whole simulation steps of ever larger scenes, to see how the game scales.
+ *
+ * usage: shooty_face_stress [--enemies=100,1000,10000] [--bullets=2000] [--lod] [--ticks=300]
+ *                           [--warm_up=60] [--json=path]
+ * Runs one scene for each enemy count, each with the same number of bullets. With --lod, what is
+ * out of view is simulated in less detail, as Game::set_lod_enabled(). */
+int main(int argc, char* argv[])
+{
+    std::vector<std::size_t> enemy_counts = {100, 1000, 10000};
+    std::size_t bullet_count = 2000;
+    bool is_lod_enabled = false;
+    int ticks = 300;
+    int warm_up_ticks = 60;
+    std::string json_path;
+
+    bool is_valid = true;
+    for (int ndx = 1; ndx < argc && is_valid; ++ndx) {
+        const std::string arg = argv[ndx];
+        if (arg.compare(0, 10, "--enemies=") == 0) {
+            enemy_counts = parse_counts(arg.substr(10));
+            is_valid = !enemy_counts.empty();
+        } else if (arg.compare(0, 10, "--bullets=") == 0) {
+            const auto count = std::atol(arg.c_str() + 10);
+            bullet_count = std::max(count, 0L);
+            is_valid = count >= 0;
+        } else if (arg == "--lod") {
+            is_lod_enabled = true;
+        } else if (arg.compare(0, 8, "--ticks=") == 0) {
+            ticks = std::atoi(arg.c_str() + 8);
+            is_valid = ticks > 0;
+        } else if (arg.compare(0, 10, "--warm_up=") == 0) {
+            warm_up_ticks = std::atoi(arg.c_str() + 10);
+            is_valid = warm_up_ticks >= 0;
+        } else if (arg.compare(0, 7, "--json=") == 0) {
+            json_path = arg.substr(7);
+        } else {
+            is_valid = false;
+        }
+    }
+    if (!is_valid) {
+        std::cerr << "usage: " << argv[0] << " [--enemies=count,...] [--bullets=count] [--lod]"
+                  << " [--ticks=count] [--warm_up=count] [--json=path]" << std::endl;
+        return 1;
+    }
+
+    std::vector<Result> results;
+    std::printf("%8s %8s %9s %10s %9s %9s %9s %12s %12s %14s %14s\n", "Enemies", "Bullets",
+                "Entities", "Ticks/s", "p50 (ms)", "p99 (ms)", "max (ms)", "Allocs/tick",
+                "Bytes/tick", "Allocs/render", "Bytes/render");
+    for(const auto enemy_count : enemy_counts) {
+        results.push_back(run(enemy_count, bullet_count, is_lod_enabled, warm_up_ticks, ticks));
+        const auto& result = results.back();
+        std::printf("%8zu %8zu %9zu %10.1f %9.3f %9.3f %9.3f %12.1f %12.0f %14.2f %14.0f\n",
+                    result.enemy_count, result.bullet_count, result.entity_count,
+                    result.ticks_per_second, result.p50_ms, result.p99_ms, result.max_ms,
+                    result.allocations, result.bytes, result.render_allocations,
+                    result.render_bytes);
+        std::fflush(stdout);
+    }
+
+    if (!json_path.empty()) {
+        std::ofstream out(json_path);
+        if (!out) {
+            std::cerr << "Can't write " << json_path << std::endl;
+            return 1;
+        }
+        write_json(out, argv[0], results);
+    }
+
+    return 0;
+}
@@ -4,6 +4,15 @@
 #include "components/physics.hpp"
 #include "game.hpp"
 
+void
+AIBullet::refresh(sf::Time frame_length)
+{
+    has_intent_ = !get_bullet().is_dead();
+    if (has_intent_) {
+        intent_ = find_hit(frame_length);
+    }
+}
+
 sf::Time
 AIBullet::update(sf::Time elapsed)
 {
@@ -12,13 +21,34 @@ AIBullet::update(sf::Time elapsed)
         return elapsed;
     }
 
+    const auto hit = has_intent_ && intent_.elapsed == elapsed ? intent_ : find_hit(elapsed);
+    has_intent_ = false;
+
+    auto used = elapsed * hit.percent_safe;
+    bullet.get_component<Physics>()->update(used.asSeconds());
+
+    if (hit.entity) {
+        bullet.apply_damage(*hit.entity);
+        bullet.kill();
+    }
+
+    return used;
+}
+
+AIBullet::Hit
+AIBullet::find_hit(sf::Time elapsed)
+{
+    auto& bullet = get_bullet();
     auto* bullet_physics = bullet.get_component<Physics>();
     auto bullet_box = bullet_physics->get_box(elapsed.asSeconds());
+    const bool is_detailed = Game::instance().is_detailed(bullet_box);
 
-    float min_percent_safe = 1.f;
-    Entity* damaged_entity = nullptr;
-    for(const auto& entity : Game::instance().entities()) {
-        if (entity.get() == Game::instance().get_player()) {
+    Hit hit{elapsed, 1.f, nullptr};
+
+    candidates_.clear();
+    Game::instance().get_collision_candidates(bullet_box, candidates_);
+    for(auto* entity : candidates_) {
+        if (entity == Game::instance().get_player()) {
             continue;
         }
 
@@ -28,23 +58,22 @@ AIBullet::update(sf::Time elapsed)
 
         auto entity_box = entity->get_component<Physics>()->get_box();
 
-        if (Collision::broad_test(bullet_box, entity_box)) {
-            float percent_safe = Collision::narrow_test(bullet_box, entity_box);
-
-            if (percent_safe < min_percent_safe) {
-                min_percent_safe = percent_safe;
-                damaged_entity = entity.get();
-            }
+        float percent_safe = 1.f;
+        if (!is_detailed) {
+            // grow the entity by the bullet, so the bullet's center can be cast as a ray
+            auto grown_box = AABB(entity_box.get_position(),
+                                  entity_box.get_dimensions() + bullet_box.get_dimensions());
+            percent_safe = Collision::ray_cast(bullet_box.get_position(),
+                                               bullet_box.get_trajectory(), grown_box);
+        } else if (Collision::broad_test(bullet_box, entity_box)) {
+            percent_safe = Collision::narrow_test(bullet_box, entity_box);
         }
-    }
-
-    auto used = elapsed * min_percent_safe;
-    bullet_physics->update(used.asSeconds());
 
-    if (min_percent_safe < 1.f) {
-        bullet.apply_damage(*damaged_entity);
-        bullet.kill();
+        if (percent_safe < hit.percent_safe) {
+            hit.percent_safe = percent_safe;
+            hit.entity = entity;
+        }
     }
 
-    return used;
+    return hit;
 }
@@ -2,6 +2,7 @@
 
 #include "components/AI.hpp"
 #include "bullet.hpp"
+#include "broad_phase.hpp"
 
 /** \brief AI Control for the Bullet Class.
  *
@@ -11,11 +12,38 @@ class AIBullet : public AI
 {
 public:
     AIBullet(Bullet& bullet) :
-        AI(bullet)
+        AI(bullet),
+        has_intent_(false)
     { }
     virtual ~AIBullet() = default;
 
+    /** \brief Finds what the bullet will hit over the frame, without moving it.
+     *
+     * Only reads the world, so bullets can refresh in parallel. */
+    void refresh(sf::Time frame_length) override;
+
+    /** \brief Moves the bullet, damaging whatever it hits.
+     *
+     * Uses the hit found by refresh() when it was over the same elapsed, or finds it again. */
     sf::Time update(sf::Time elapsed) override;
 
     inline Bullet& get_bullet() { return static_cast<Bullet&>(get_entity()); }
+
+private:
+    struct Hit
+    {
+        sf::Time elapsed;       ///< over which the hit was found
+        float percent_safe;     ///< of elapsed, before the hit
+        Entity* entity;         ///< hit, nullptr if none
+    };
+
+    /** \brief Finds the first entity the bullet hits over elapsed, other than the player.
+     *
+     * Out of view, when the game allows less detail, the bullet is cast as a ray instead. */
+    Hit find_hit(sf::Time elapsed);
+
+    bool has_intent_;     ///< intent_ was found by refresh(), and not yet used
+    Hit intent_;
+
+    BroadPhaseIF::Candidates candidates_; ///< Reused by find_hit(), to avoid reallocating each frame
 };
@@ -1,20 +1,66 @@
 #include "AI_enemy.hpp"
 
-#include "A_star.hpp"
+#include <cstdlib>
+
 #include "game.hpp"
 #include "components/physics.hpp"
 #include "collision.hpp"
 #include "utils.hpp"
 
-const float AIEnemy::ASTAR_REFRESH_RATE = 5.f; ///< Hz
-int AIEnemy::user_count_ = 0;
-int AIEnemy::next_user_ = 0;
+const float AIEnemy::PATH_REFRESH_RATE = 5.f; ///< Hz
+const int AIEnemy::HIERARCHICAL_DISTANCE = 20;
+const int AIEnemy::OFF_SCREEN_REFRESH_DIVISOR = 4;
+std::map<std::pair<int, int>, FlowField> AIEnemy::flow_fields_;
+AIEnemy::Navigation AIEnemy::navigation_ = AIEnemy::Navigation::FLOW_FIELD;
+
+AIEnemy::~AIEnemy()
+{
+    if (is_waiting_) {
+        path_service_->cancel(ticket_);
+    }
+}
 
 void
 AIEnemy::prepare()
 {
-    if (++next_user_ == user_count_) {
-        next_user_ = 0;
+    auto& game = Game::instance();
+    if (!game.get_player()) {
+        return;
+    }
+
+    const auto* physics = get_enemy().get_component<Physics>();
+    bool is_due = refresh_rate_->check();
+    if (is_due) {
+        refresh_rate_->renew();
+
+        // out of view, only one refresh in so many is done, keeping to the last path in between
+        skipped_refreshes_ = game.is_detailed(physics->get_box()) ?
+            0 : (skipped_refreshes_ + 1) % OFF_SCREEN_REFRESH_DIVISOR;
+        is_due = skipped_refreshes_ == 0;
+    }
+
+    if (is_due) {
+        const auto* player_physics = game.get_player()->get_component<Physics>();
+        const auto start = game.get_tile_for(physics->get_box().get_min_corner());
+        const auto end = game.get_tile_for(player_physics->get_box().get_min_corner());
+        const auto dimensions = game.to_tile_dimensions(physics->get_dimensions());
+
+        if (navigation_ == Navigation::PATH_REQUEST) {
+            flow_field_ = nullptr;
+            request_path(start, end, dimensions);
+        } else {
+            // only the first enemy of each size to refresh after the player moves searches again
+            auto& flow_field = flow_fields_[std::make_pair(dimensions.x, dimensions.y)];
+            flow_field.update(end, dimensions, game.get_static_map());
+
+            // the path itself is followed in refresh(), off the main thread
+            flow_field_ = &flow_field;
+        }
+    }
+
+    if (is_waiting_) {
+        // keeps following the last path (or the player) until the new one is ready
+        collect_path();
     }
 }
 
@@ -32,25 +78,12 @@ AIEnemy::refresh(sf::Time frame_length)
     const auto* player_physics = game.get_player()->get_component<Physics>();
     const float distance_can_move = util::length(physics->get_velocity()) * frame_length.asSeconds();
 
-    if (user_ndx_ == next_user_ && refresh_rate_->check()) {
-        refresh_rate_->renew();
-
+    if (flow_field_) {
+        // a path of only start is on the player's tile already, so track them directly instead
         const auto start = game.get_tile_for(physics->get_box().get_min_corner());
-        const auto end = game.get_tile_for(player_physics->get_box().get_min_corner());
-
-        auto distance = end - start;
-        if (std::abs(distance.x) < 20 && std::abs(distance.y) < 20) {
-            const auto dimensions = game.to_tile_dimensions(physics->get_dimensions());
-            const auto map = game.get_map(&get_entity());
-
-            auto result = AStar::run(start, end, dimensions, map);
-            has_path_ = result.has_path;
-            path_ = std::move(result.path);
-            path_ndx_ = 1;
-        } else {
-            has_path_ = false;
-            path_ = AStar::Path();
-        }
+        has_path_ = flow_field_->get_path(start, path_) && path_.size() > 1;
+        path_ndx_ = 1;
+        flow_field_ = nullptr;
     }
 
     if (has_path_ && path_.size() > 0) {
@@ -95,6 +128,77 @@ AIEnemy::refresh(sf::Time frame_length)
     fractional_move_ = std::min(std::max(0.f, fractional_move_), 1.f);
 }
 
+void
+AIEnemy::request_path(const sf::Vector2i& start, const sf::Vector2i& end,
+                      const sf::Vector2i& dimensions)
+{
+    auto& game = Game::instance();
+    auto& service = game.get_path_service();
+    if (is_waiting_) {
+        service.cancel(ticket_);
+        is_waiting_ = false;
+    }
+
+    // enemies heading the same way mostly walk the same path, so most searches are found here
+    const auto version = game.get_static_map_version();
+    if (get_path_cache().find(start, end, dimensions, version, path_)) {
+        has_path_ = path_.size() > 1;
+        path_ndx_ = 1;
+        return;
+    }
+
+    // the enemy always fits where it stands, even if it is pushed into an obstacle
+    const auto* physics = get_enemy().get_component<Physics>();
+    request_.start = start;
+    request_.end = end;
+    request_.dimensions = dimensions;
+    request_.ignore_min = start;
+    request_.ignore_max = game.get_tile_for(physics->get_box().get_max_corner());
+    request_version_ = version;
+
+    // a direct search of a far away player explores most of the map, the cluster graph skips it
+    const int distance = std::abs(end.x - start.x) + std::abs(end.y - start.y);
+    request_.search = distance >= HIERARCHICAL_DISTANCE ? PathService::Search::HIERARCHICAL
+                                                        : PathService::Search::DIRECT;
+
+    // a search which had to clear an obstacle from under the enemy found a path only it can take
+    const auto footprint = request_.ignore_max - request_.ignore_min + sf::Vector2i(1, 1);
+    is_request_shared_ = game.get_static_map().is_clear(request_.ignore_min, footprint);
+
+    auto request = request_;
+    request.map = game.get_static_map_snapshot();
+    ticket_ = service.submit(std::move(request));
+    path_service_ = &service;
+    is_waiting_ = true;
+}
+
+void
+AIEnemy::collect_path()
+{
+    PathService::Response response;
+    if (!path_service_->collect(ticket_, response)) {
+        return;
+    }
+    is_waiting_ = false;
+
+    if (is_request_shared_) {
+        get_path_cache().store(request_.start, request_.end, request_.dimensions,
+                               request_version_, response.result);
+    }
+
+    // a path of only start is on the player's tile already, so track them directly instead
+    path_ = std::move(response.result.path);
+    has_path_ = response.result.has_path && path_.size() > 1;
+    path_ndx_ = 1;
+}
+
+PathCache&
+AIEnemy::get_path_cache()
+{
+    static PathCache cache;
+    return cache;
+}
+
 sf::Time
 AIEnemy::update(sf::Time elapsed)
 {
@@ -108,7 +212,10 @@ AIEnemy::update(sf::Time elapsed)
     AABB collision_box({0.f, 0.f}, {0.f, 0.f});
 
     float min_percent_safe = fractional_move_;
-    for(auto& entity : Game::instance().entities()) {
+
+    candidates_.clear();
+    Game::instance().get_collision_candidates(box, candidates_);
+    for(auto* entity : candidates_) {
         if (!Collision::sanity_check(enemy, *entity)) {
             continue;
         }
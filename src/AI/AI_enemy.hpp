@@ -1,9 +1,16 @@
 #pragma once
 
+#include <map>
+#include <utility>
+
 #include "AI/A_star.hpp"
+#include "AI/flow_field.hpp"
+#include "AI/path_cache.hpp"
+#include "AI/path_service.hpp"
 #include "components/AI.hpp"
 #include "enemy.hpp"
 #include "rate_limit.hpp"
+#include "broad_phase.hpp"
 
 /** \brief AI control for the enemy class.
  *
@@ -13,17 +20,38 @@ class AIEnemy : public AI
 {
 friend class TestableAIEnemy;
 
-    static const float ASTAR_REFRESH_RATE;
+    static const float PATH_REFRESH_RATE;
+    static const int HIERARCHICAL_DISTANCE; ///< tiles, from which paths are searched over clusters
 
 public:
+    static const int OFF_SCREEN_REFRESH_DIVISOR; ///< only one in so many refreshes out of view
+
+    /** \brief How enemies find their way to the player.
+     *
+     * FLOW_FIELD by default, so the PathService and the PathCache are only used once switched to
+     * PATH_REQUEST, which the demo does with N. */
+    enum class Navigation
+    {
+        FLOW_FIELD,   ///< follow a flow field shared by all enemies, around static obstacles only
+        PATH_REQUEST, ///< reuse a cached path, or ask the PathService for one
+    };
+
     AIEnemy(Enemy& enemy) :
-        AIEnemy(enemy, std::make_unique<RateLimit>(ASTAR_REFRESH_RATE))
+        AIEnemy(enemy, std::make_unique<RateLimit>(PATH_REFRESH_RATE,
+                                                   std::make_unique<SimulationClock>()))
     { }
-    virtual ~AIEnemy() = default;
+    virtual ~AIEnemy();
 
+    /** \brief Refreshes the path to the player, when due.
+     *
+     * Out of view, when the game allows less detail, most refreshes are skipped, and the enemy
+     * keeps to its last path. Everything shared between enemies is touched here, as prepare() is
+     * called on one thread. */
     void prepare() override;
 
-    /** \brief Sets the physics state to track the player. */
+    /** \brief Sets the physics state to track the player.
+     *
+     * Only reads the world and writes this enemy, so enemies can refresh in parallel. */
     void refresh(sf::Time frame_length) override;
 
     /** \brief Updates the physics state until the nearest collision. */
@@ -34,26 +62,58 @@ public:
     inline const AStar::Path& get_path() const { return path_; }
     inline const int get_path_ndx() const { return path_ndx_; }
 
+    /** \brief Switches the navigation of every enemy, from their next path refresh. */
+    static inline void set_navigation(Navigation navigation) { navigation_ = navigation; }
+    static inline Navigation get_navigation() { return navigation_; }
+
 private:
     AIEnemy(Enemy& enemy, std::unique_ptr<RateLimitIF> refresh_rate) :
         AI(enemy),
         refresh_rate_(std::move(refresh_rate)),
+        skipped_refreshes_(OFF_SCREEN_REFRESH_DIVISOR - 1),
         has_path_(false),
-        fractional_move_(0.f),
-        user_ndx_(user_count_)
-    {
-        ++user_count_;
-    }
+        flow_field_(nullptr),
+        path_service_(nullptr),
+        is_waiting_(false),
+        ticket_(0),
+        request_version_(0),
+        is_request_shared_(false),
+        fractional_move_(0.f)
+    { }
 
-    std::unique_ptr<RateLimitIF> refresh_rate_; ///< limits (costly) path calculation
+    /** \brief Takes a cached path to the player, or asks the PathService for one, replacing any
+     * pending request. */
+    void request_path(const sf::Vector2i& start, const sf::Vector2i& end,
+                      const sf::Vector2i& dimensions);
+
+    /** \brief Takes the pending path from the PathService, if it is ready, and caches it. */
+    void collect_path();
+
+    /** \brief Paths found by the PathService, shared by all enemies. */
+    static PathCache& get_path_cache();
+
+    std::unique_ptr<RateLimitIF> refresh_rate_; ///< limits re-reading the path from the flow field
+    int skipped_refreshes_;         ///< out of view since the last refresh, so starts at the most
 
     bool has_path_;
     AStar::Path path_;
     int path_ndx_;
 
+    const FlowField* flow_field_;   ///< to read a new path_ from in refresh(), nullptr if none
+
+    PathService* path_service_;     ///< the Game's, once a path is requested from it
+    bool is_waiting_;               ///< for path_service_ to resolve ticket_
+    PathService::Ticket ticket_;
+    PathService::Request request_;  ///< pending, without its map, to cache the path under
+    std::size_t request_version_;   ///< of the map request_ is searched over
+    bool is_request_shared_;        ///< request_ is over the map as it is, so its path is cached
+
     float fractional_move_;
 
-    static int user_count_;
-    static int next_user_;
-    int user_ndx_;
+    BroadPhaseIF::Candidates candidates_; ///< Reused by update(), to avoid reallocating each frame
+
+    /** \brief Flow fields towards the player, shared by all enemies of the same <dx, dy> size. */
+    static std::map<std::pair<int, int>, FlowField> flow_fields_;
+
+    static Navigation navigation_;
 };
@@ -1,64 +1,165 @@
-#include <iostream>
-
-#include <stdexcept>
 #include <algorithm>
 
-#include <SFML/System/Clock.hpp>
-
 #include "A_star.hpp"
 #include "utils.hpp"
 #include "game.hpp"
 
-AStar::CostMap AStar::cost_so_far_;
-AStar::FromMap AStar::came_from_;
-AStar::PQ AStar::frontier_;
+thread_local std::vector<AStar::Node> AStar::nodes_;
+thread_local unsigned AStar::generation_ = 0;
+thread_local IndexedHeap<float> AStar::frontier_;
+thread_local ClearanceMap AStar::clearance_;
+thread_local std::vector<sf::Vector2i> AStar::successors_;
+
+static const sf::Vector2i directions[] = {{0, -1}, {-1, 0}, {0, 1}, {1, 0}};
 
-bool
-is_reachable(const sf::Vector2i& location, const sf::Vector2i& dimensions,
-             const TileMap& map)
+static int
+sign(int value)
 {
-    // subtract one from each dimension, because we assume the tile directly at location is
-    // always passable
-    for (int y = 0; y < dimensions.y; ++y) {
-        for (int x = 0; x < dimensions.x; ++x) {
-            try {
-                if (!map.at(location.y + y).at(location.x + x).passable) {
-                    return false;
-                }
-            } catch (std::out_of_range&) {
-                // we tried to index to a location outside the map range
-                // by definition, a tile outside the map range is impassable
-                return false;
+    return (0 < value) - (value < 0);
+}
+
+/** \brief Jumps vertically from the given location, until a location with a forced neighbor.
+ *
+ * Moving vertically, a horizontal neighbor is only forced when the tile beside the previous
+ * location is blocked; otherwise, the path through it (moving horizontally first) is preferred.
+ *
+ * \return true iff a jump point was found, in jump_point. */
+static bool
+jump_vertical(sf::Vector2i location, int dy, const sf::Vector2i& end,
+              const sf::Vector2i& dimensions, const ClearanceMap& map, sf::Vector2i& jump_point)
+{
+    while (true) {
+        const auto next = location + sf::Vector2i(0, dy);
+        if (!map.fits(next, dimensions)) {
+            return false;
+        }
+
+        if (next == end) {
+            jump_point = next;
+            return true;
+        }
+
+        for (int side : {-1, 1}) {
+            if (map.fits(next + sf::Vector2i(side, 0), dimensions) &&
+                !map.fits(location + sf::Vector2i(side, 0), dimensions)) {
+                jump_point = next;
+                return true;
             }
         }
-    }
 
-    return true;
+        location = next;
+    }
 }
 
-static const std::vector<sf::Vector2i>
-get_neighbors(const sf::Vector2i& location, const sf::Vector2i& dimensions,
-              const TileMap& map)
+/** \brief Jumps horizontally from the given location, until a location from which a vertical
+ * jump finds a jump point.
+ *
+ * \return true iff a jump point was found, in jump_point. */
+static bool
+jump_horizontal(sf::Vector2i location, int dx, const sf::Vector2i& end,
+                const sf::Vector2i& dimensions, const ClearanceMap& map, sf::Vector2i& jump_point)
 {
-    static const std::vector<sf::Vector2i> directions = {{0, -1}, {-1, 0}, {0, 1}, {1, 0}};
+    sf::Vector2i vertical_jump_point;
+
+    while (true) {
+        const auto next = location + sf::Vector2i(dx, 0);
+        if (!map.fits(next, dimensions)) {
+            return false;
+        }
+
+        if (next == end ||
+            jump_vertical(next, -1, end, dimensions, map, vertical_jump_point) ||
+            jump_vertical(next,  1, end, dimensions, map, vertical_jump_point)) {
+            jump_point = next;
+            return true;
+        }
+
+        location = next;
+    }
+}
 
-    std::vector<sf::Vector2i> neighbors;
+/** \brief Collects the jump points to visit from the given location.
+ *
+ * Arriving horizontally, the natural neighbors are ahead and to either side. Arriving vertically,
+ * only the location ahead is natural, along with any forced horizontal neighbors. The start
+ * location (came_from == location) has every neighbor. */
+static void
+get_jump_points(const sf::Vector2i& location, const sf::Vector2i& came_from,
+                const sf::Vector2i& end, const sf::Vector2i& dimensions, const ClearanceMap& map,
+                std::vector<sf::Vector2i>& jump_points)
+{
+    const sf::Vector2i direction(sign(location.x - came_from.x), sign(location.y - came_from.y));
+    sf::Vector2i jump_point;
 
-    for(const auto& direction : directions) {
-        if (is_reachable(location + direction, dimensions, map)) {
-            neighbors.emplace_back(location + direction);
+    auto add_horizontal = [&](int dx)
+    {
+        if (jump_horizontal(location, dx, end, dimensions, map, jump_point)) {
+            jump_points.push_back(jump_point);
+        }
+    };
+    auto add_vertical = [&](int dy)
+    {
+        if (jump_vertical(location, dy, end, dimensions, map, jump_point)) {
+            jump_points.push_back(jump_point);
         }
+    };
+
+    if (direction.x == 0 && direction.y == 0) {
+        add_vertical(-1);
+        add_horizontal(-1);
+        add_vertical(1);
+        add_horizontal(1);
+    } else if (direction.x != 0) {
+        add_vertical(-1);
+        add_vertical(1);
+        add_horizontal(direction.x);
+    } else {
+        add_vertical(direction.y);
+
+        const auto previous = location - direction;
+        for (int side : {-1, 1}) {
+            if (map.fits(location + sf::Vector2i(side, 0), dimensions) &&
+                !map.fits(previous + sf::Vector2i(side, 0), dimensions)) {
+                add_horizontal(side);
+            }
+        }
+    }
+}
+
+void
+AStar::begin_run(std::size_t node_count)
+{
+    if (nodes_.size() < node_count) {
+        nodes_.resize(node_count, Node{0.f, 0, 0});
     }
 
-    return std::move(neighbors);
+    // on wrap around, stamps from 2^32 runs ago would look current again
+    if (++generation_ == 0) {
+        std::fill(nodes_.begin(), nodes_.end(), Node{0.f, 0, 0});
+        generation_ = 1;
+    }
+
+    frontier_.reset(node_count);
 }
 
 AStar::Result
 AStar::run(const sf::Vector2i& start, const sf::Vector2i& end,
-           const sf::Vector2i& dimensions, const TileMap& map)
+           const sf::Vector2i& dimensions, const TileMap& map, Mode mode)
 {
+    // no need to build the clearance when the end is blocked
+    if (!map.contains(start) || !map.is_clear(end, dimensions)) {
+        return Result{false, Path()};
+    }
+
+    clearance_.build(map);
+    return run(start, end, dimensions, clearance_, mode);
+}
 
-    if (!is_reachable(end, dimensions, map)) {
+AStar::Result
+AStar::run(const sf::Vector2i& start, const sf::Vector2i& end,
+           const sf::Vector2i& dimensions, const ClearanceMap& map, Mode mode)
+{
+    if (!map.contains(start) || !map.fits(end, dimensions)) {
         return Result{false, Path()};
     }
 
@@ -66,59 +167,83 @@ AStar::run(const sf::Vector2i& start, const sf::Vector2i& end,
         return Result{true, Path{start}};
     }
 
-    cost_so_far_.clear();
-    came_from_.clear();
-    while(!frontier_.empty()) { frontier_.pop(); }
+    const int width = map.get_width();
+    auto index_for = [width](const sf::Vector2i& location)
+    {
+        return static_cast<std::size_t>(location.y) * width + location.x;
+    };
+    auto location_for = [width](std::size_t ndx)
+    {
+        return sf::Vector2i(ndx % width, ndx / width);
+    };
+
+    begin_run(map.get_height() * width);
 
-    cost_so_far_[start] = 0.f;
-    came_from_[start] = start;
-    frontier_.emplace(0.f, start);
+    const auto start_ndx = index_for(start);
+    const auto end_ndx = index_for(end);
+    nodes_[start_ndx] = Node{0.f, start_ndx, generation_};
+    frontier_.push_or_decrease(start_ndx, 0.f);
+
+    const auto end_position = Game::get_position_for(end);
+    const float step_cost = util::length(Game::get_position_for({1, 0}) - Game::get_position_for({0, 0}));
 
-    int loops = 0;
-    int max_size = 0;
-    sf::Clock clock;
     while(!frontier_.empty())
     {
-        ++loops;
-        auto current = frontier_.top().second;
+        const auto current_ndx = frontier_.top();
         frontier_.pop();
 
-        if (current == end) {
+        const auto& current_node = nodes_[current_ndx];
+        if (current_ndx == end_ndx) {
             break;
         }
 
-        const auto neighbors = get_neighbors(current, dimensions, map);
-        for(const auto& next : neighbors) {
-            float cost = cost_so_far_[current] +
-                util::length(Game::get_position_for(current) -
-                             Game::get_position_for(next));
-            if (!cost_so_far_.count(next) || cost < cost_so_far_[next]) {
-                cost_so_far_[next] = cost;
-                came_from_[next] = current;
-                float priority = cost +
-                    util::length(Game::get_position_for(end) -
-                                 Game::get_position_for(next));
-                frontier_.emplace(priority, next);
-
-                if (frontier_.size() > max_size) {
-                    max_size = frontier_.size();
+        const auto current = location_for(current_ndx);
+        successors_.clear();
+        if (mode == Mode::JUMP_POINT) {
+            get_jump_points(current, location_for(current_node.came_from), end, dimensions, map,
+                            successors_);
+        } else {
+            for(const auto& direction : directions) {
+                if (map.fits(current + direction, dimensions)) {
+                    successors_.push_back(current + direction);
                 }
             }
         }
+
+        for(const auto& next : successors_) {
+            // jump points are always in a straight line from the current location
+            const auto distance = std::abs(next.x - current.x) + std::abs(next.y - current.y);
+
+            const auto next_ndx = index_for(next);
+            auto& next_node = nodes_[next_ndx];
+            const float cost = current_node.cost + step_cost * distance;
+            if (next_node.generation != generation_ || cost < next_node.cost) {
+                next_node = Node{cost, current_ndx, generation_};
+                float priority = cost + util::length(end_position - Game::get_position_for(next));
+                frontier_.push_or_decrease(next_ndx, priority);
+            }
+        }
     }
-    Game::instance().set_timer(clock.getElapsedTime());
-    std::cout << "loops: " << loops << " size: " << max_size << std::endl;
 
     // we didn't find a way through
-    if (!came_from_.count(end)) {
+    if (nodes_[end_ndx].generation != generation_) {
         return {false, Path()};
     }
 
     Path path;
-    auto current = end;
-    while (current != start) {
-        path.push_back(current);
-        current = came_from_[current];
+    auto current_ndx = end_ndx;
+    while (current_ndx != start_ndx) {
+        const auto previous_ndx = nodes_[current_ndx].came_from;
+
+        // fill in the tiles skipped over between jump points
+        const auto current = location_for(current_ndx);
+        const auto previous = location_for(previous_ndx);
+        const sf::Vector2i step(sign(previous.x - current.x), sign(previous.y - current.y));
+        for (auto tile = current; tile != previous; tile += step) {
+            path.push_back(tile);
+        }
+
+        current_ndx = previous_ndx;
     }
     path.push_back(start);
 
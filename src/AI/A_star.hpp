@@ -4,9 +4,9 @@
 
 #include <SFML/System/Vector2.hpp>
 #include <vector>
-#include <queue>
-#include <unordered_map>
 
+#include "AI/clearance_map.hpp"
+#include "AI/indexed_heap.hpp"
 #include "tile_map.hpp"
 
 /** \brief Using www.redblobgames.com/pathfinding/a-star/implementation.html */
@@ -26,6 +26,13 @@ public:
         Path path;     ///< vector of location indices to traverse the map
     };
 
+    /** \brief How AStar::run() expands each location. */
+    enum class Mode
+    {
+        A_STAR,     ///< every reachable neighbor
+        JUMP_POINT, ///< only jump points, skipping over symmetric paths (Jump Point Search)
+    };
+
     /** \brief Runs the AStar algorithm.
      *
      * \note The entity this is being run for should not set the tiles underneath itself to
@@ -35,63 +42,49 @@ public:
      * \param[in] end TL (ie. min) corner of entity end position {Tile coordinates}.
      * \param[in] dimensions <dx, dy> dimensions of the entity.
      * \param[in] map Tile map of the traversable area.
+     * \param[in] mode How to expand locations. Both modes find a path of the same (shortest)
+     *                 length, but may choose a different one of several equally short paths.
      *
      * \return Best path from start to end in the map.*/
     static Result run(const sf::Vector2i& start, const sf::Vector2i& end,
-                      const sf::Vector2i& dimensions, const TileMap& map);
-
-private:
-
-    struct Hash
-    {
-        size_t operator()(const sf::Vector2i& value) const
-        {
-            std::string tmp = std::to_string(value.x) + "," + std::to_string(value.y);
-            return std::hash<std::string>()(tmp);
-        }
-    };
+                      const sf::Vector2i& dimensions, const TileMap& map,
+                      Mode mode = Mode::A_STAR);
 
-    /// Key == location, Value == cost function result for that tile
-    using CostMap = std::unordered_map<sf::Vector2i, float, Hash>;
-    static CostMap cost_so_far_;
-
-    /// Key == location, Value == which location comes before it in the traversal
-    using FromMap = std::unordered_map<sf::Vector2i, sf::Vector2i, Hash>;
-    static FromMap came_from_;
-
-    /// <cost, location> element pair
-    using PQElement = std::pair<float, sf::Vector2i>;
+    /** \brief Runs the AStar algorithm over a prebuilt clearance map.
+     *
+     * The TileMap overload builds the clearance, at O(width * height), on every call. Use this one
+     * when several searches run over the same map, so it is only built again when the map changes
+     * (see PathService).
+     *
+     * \sa AStar::run(). */
+    static Result run(const sf::Vector2i& start, const sf::Vector2i& end,
+                      const sf::Vector2i& dimensions, const ClearanceMap& map,
+                      Mode mode = Mode::A_STAR);
 
-    struct PQElementComp
+private:
+    /** \brief Search state for one tile, indexed by y * width + x. */
+    struct Node
     {
-        bool operator()(const PQElement& a, const PQElement& b) const { return a.first > b.first; }
+        float cost;              ///< cost function result for this tile
+        std::size_t came_from;   ///< index of the tile (or jump point) before this one
+        unsigned generation;     ///< run this node was last touched by, stale when != generation_
     };
 
-    /* struct myPQ */
-    /* { */
-    /*     std::vector<PQElement> elements_; */
-
-    /*     bool empty() { return elements_.empty(); } */
-    /*     size_t size() { return elements_.size(); } */
+    /// Search state, sized to the largest map seen so far and reused across runs without clearing.
+    /// Each thread has its own, so searches may run in parallel.
+    static thread_local std::vector<Node> nodes_;
+    static thread_local unsigned generation_;
 
-    /*     const PQElement& top() */
-    /*     { */
-    /*         return *std::max_element(elements_.begin(), elements_.end(), PQElementComp()); */
-    /*     } */
+    /// Locations to expand, by cost plus heuristic. Ties go to the lower index, so equally good
+    /// paths are chosen the same way each run
+    static thread_local IndexedHeap<float> frontier_;
 
-    /*     void pop() */
-    /*     { */
-    /*         elements_.erase(std::max_element(elements_.begin(), elements_.end(), PQElementComp())); */
-    /*     } */
+    /// Built by the TileMap overload of run(), reused across runs
+    static thread_local ClearanceMap clearance_;
 
-    /*     void emplace(float prio, sf::Vector2i location) */
-    /*     { */
-    /*         elements_.emplace_back(prio, location); */
-    /*     } */
-    /* }; */
+    /// Locations to visit from the current one, reused across expansions
+    static thread_local std::vector<sf::Vector2i> successors_;
 
-    /// Priority Queue for sorting the visited locations by their cost
-    using PQ = std::priority_queue<PQElement, std::vector<PQElement>, PQElementComp>;
-    /* using PQ = myPQ; */
-    static PQ frontier_;
+    /** \brief Starts a new run over a map of the given size, invalidating all nodes. */
+    static void begin_run(std::size_t node_count);
 };
@@ -0,0 +1,51 @@
+#include <algorithm>
+
+#include "AI/clearance_map.hpp"
+
+void
+ClearanceMap::build(const TileMap& map)
+{
+    height_ = map.get_height();
+    width_ = map.get_width();
+    clearance_.resize(width_ * height_);
+
+    // the square from a tile is one larger than the smallest square from its right, lower, and
+    // lower right neighbors, so fill in from the BR (max) corner
+    for (int y = height_ - 1; y >= 0; --y) {
+        for (int x = width_ - 1; x >= 0; --x) {
+            if (!map.is_passable({x, y})) {
+                clearance_[y * width_ + x] = 0;
+                continue;
+            }
+
+            clearance_[y * width_ + x] = 1 + std::min({get_clearance({x + 1, y}),
+                                                       get_clearance({x, y + 1}),
+                                                       get_clearance({x + 1, y + 1})});
+        }
+    }
+}
+
+bool
+ClearanceMap::fits(const sf::Vector2i& tile, const sf::Vector2i& dimensions) const
+{
+    const int side = std::min(dimensions.x, dimensions.y);
+    if (side <= 0) {
+        return get_clearance(tile) > 0;
+    }
+
+    const bool is_wide = dimensions.x > dimensions.y;
+    const int length = is_wide ? dimensions.x : dimensions.y;
+    const sf::Vector2i step = is_wide ? sf::Vector2i(1, 0) : sf::Vector2i(0, 1);
+
+    // squares may overlap, with the last one flush against the far side of the agent
+    for (int offset = 0; ; offset += side) {
+        offset = std::min(offset, length - side);
+        if (get_clearance(tile + step * offset) < side) {
+            return false;
+        }
+
+        if (offset == length - side) {
+            return true;
+        }
+    }
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <vector>
+
+#include <SFML/System/Vector2.hpp>
+
+#include "tile_map.hpp"
+
+/** \brief Per-tile clearance for a TileMap, for fitting multi-tile agents.
+ *
+ * The clearance of a tile is the side of the largest passable square with its TL (min) corner on
+ * that tile. An impassable tile has a clearance of 0, as does every location outside the map.
+ *
+ * Checking whether an agent fits at a location is then a single comparison for square agents,
+ * rather than a scan of every tile under the agent's footprint. */
+class ClearanceMap
+{
+public:
+    ClearanceMap() :
+        width_(0),
+        height_(0)
+    { }
+
+    explicit ClearanceMap(const TileMap& map) :
+        ClearanceMap()
+    {
+        build(map);
+    }
+
+    ~ClearanceMap() = default;
+
+    /** \brief Recalculates clearance for the given map, reusing the existing storage. */
+    void build(const TileMap& map);
+
+    /** \return true iff the given tile is inside the map. */
+    inline bool contains(const sf::Vector2i& tile) const
+    {
+        return tile.x >= 0 && tile.x < width_ && tile.y >= 0 && tile.y < height_;
+    }
+
+    /** \return Clearance of the given tile, 0 outside the map. */
+    inline int get_clearance(const sf::Vector2i& tile) const
+    {
+        return contains(tile) ? clearance_[tile.y * width_ + tile.x] : 0;
+    }
+
+    /** \brief Tests whether an agent of the given dimensions fits with its TL (min) corner on the
+     * given tile.
+     *
+     * Non-square agents are covered by squares the size of their shorter side, laid along their
+     * longer side, so this is one comparison per square. */
+    bool fits(const sf::Vector2i& tile, const sf::Vector2i& dimensions) const;
+
+    inline int get_width() const { return width_; }
+    inline int get_height() const { return height_; }
+
+private:
+    int width_;
+    int height_;
+    std::vector<int> clearance_; ///< Indexed by y * width + x
+};
@@ -0,0 +1,261 @@
+#include <algorithm>
+
+#include "AI/flow_field.hpp"
+
+constexpr int FlowField::NO_PATH;
+constexpr int FlowField::MAX_GOAL_STEPS;
+constexpr int FlowField::UNREACHABLE;
+
+static const sf::Vector2i directions[] = {{0, -1}, {-1, 0}, {0, 1}, {1, 0}};
+
+bool
+FlowField::update(const sf::Vector2i& goal, const sf::Vector2i& dimensions, const TileMap& map)
+{
+    expanded_count_ = 0;
+
+    const bool is_same_size = map.get_width() == map_.get_width() &&
+                              map.get_height() == map_.get_height();
+    if (is_built_ && dimensions == dimensions_ && is_same_size) {
+        if (goal == goal_ && map == map_) {
+            return false;
+        }
+
+        // the goal moves over the map it was searched on, then the map catches up
+        if (goal == goal_ || move_goal(goal)) {
+            if (map != map_) {
+                repair(map);
+            }
+            return true;
+        }
+    }
+
+    goal_ = goal;
+    dimensions_ = dimensions;
+    map_ = map;
+    build();
+
+    return true;
+}
+
+bool
+FlowField::get_path(const sf::Vector2i& start, AStar::Path& path) const
+{
+    path.clear();
+
+    int distance = get_distance(start);
+    if (distance == NO_PATH) {
+        return false;
+    }
+
+    path.reserve(distance + 1);
+    path.push_back(start);
+
+    auto current = start;
+    int heading = 0;
+    while (distance > 0) {
+        // there is always a neighbor one step closer, try the current heading first
+        for (int turn = 0; turn < 4; ++turn) {
+            const int direction = (heading + turn) % 4;
+            const auto next = current + directions[direction];
+            if (get_distance(next) == distance - 1) {
+                heading = direction;
+                current = next;
+                break;
+            }
+        }
+
+        path.push_back(current);
+        --distance;
+    }
+
+    return true;
+}
+
+void
+FlowField::build()
+{
+    ++build_count_;
+    is_built_ = true;
+
+    distances_.assign(map_.get_width() * map_.get_height(), UNREACHABLE);
+    while (!open_.empty()) { open_.pop(); }
+    if (!map_.contains(goal_)) {
+        lookaheads_ = distances_;
+        return;
+    }
+
+    const int width = map_.get_width();
+    distances_[goal_.y * width + goal_.x] = 0;
+    queue_.push(goal_);
+
+    while (!queue_.empty()) {
+        const auto tile = queue_.front();
+        queue_.pop();
+        const int distance = distances_[tile.y * width + tile.x];
+
+        for(const auto& direction : directions) {
+            const auto next = tile + direction;
+            if (!is_open(next) || distances_[next.y * width + next.x] != UNREACHABLE) {
+                continue;
+            }
+
+            distances_[next.y * width + next.x] = distance + 1;
+            queue_.push(next);
+        }
+    }
+
+    // a breadth first search leaves every tile consistent
+    lookaheads_ = distances_;
+}
+
+bool
+FlowField::move_goal(const sf::Vector2i& goal)
+{
+    // the goal steps back along the field's own path from the new goal, so each step is to a
+    // neighbor, through tiles the agent fits on, which is all step_goal() needs
+    const int distance = get_distance(goal);
+    if (distance == NO_PATH || distance > MAX_GOAL_STEPS || !map_.is_clear(goal_, dimensions_)) {
+        return false;
+    }
+
+    get_path(goal, steps_);
+    for (int ndx = int(steps_.size()) - 2; ndx >= 0; --ndx) {
+        step_goal(steps_[ndx]);
+    }
+
+    // every tile is left consistent
+    lookaheads_ = distances_;
+    return true;
+}
+
+void
+FlowField::step_goal(const sf::Vector2i& goal)
+{
+    // the grid's tiles alternate like a chessboard's, so a goal moved to a neighbor moves every
+    // reachable tile exactly a step closer or further: closer for the tiles with a shortest path
+    // through the new goal, and further for the rest. All go up first, then those walking up the
+    // field from the new goal, 3 steps above the tile they are reached from, come down by 2
+    for(auto& step_count : distances_) {
+        step_count += step_count != UNREACHABLE;
+    }
+
+    const int width = map_.get_width();
+    goal_ = goal;
+    distances_[goal.y * width + goal.x] = 0;
+    queue_.push(goal);
+
+    while (!queue_.empty()) {
+        const auto tile = queue_.front();
+        queue_.pop();
+        const int distance = distances_[tile.y * width + tile.x];
+        ++expanded_count_;
+
+        for(const auto& direction : directions) {
+            const auto next = tile + direction;
+            if (!map_.contains(next)) {
+                continue;
+            }
+
+            auto& next_distance = distances_[next.y * width + next.x];
+            if (next_distance == distance + 3) {
+                next_distance = distance + 1;
+                queue_.push(next);
+            }
+        }
+    }
+}
+
+void
+FlowField::repair(const TileMap& map)
+{
+    // find the changed tiles a word at a time, before taking on the new map
+    changed_.clear();
+    for (int y = 0; y < map.get_height(); ++y) {
+        for (int word = 0; word < map.get_words_per_row(); ++word) {
+            const auto bits = map.get_word(y, word) ^ map_.get_word(y, word);
+            for (int bit = 0; bits != 0 && bit < TileMap::WORD_BITS; ++bit) {
+                if ((bits >> bit) & 1) {
+                    changed_.emplace_back(word * TileMap::WORD_BITS + bit, y);
+                }
+            }
+        }
+    }
+    map_ = map;
+
+    // a changed tile changes whether the agent fits anywhere its footprint would cover that tile,
+    // and so the lookahead of those locations and of their neighbors
+    for(const auto& tile : changed_) {
+        for (int y = tile.y - dimensions_.y + 1; y <= tile.y; ++y) {
+            for (int x = tile.x - dimensions_.x + 1; x <= tile.x; ++x) {
+                const sf::Vector2i location(x, y);
+                update_tile(location);
+                for(const auto& direction : directions) {
+                    update_tile(location + direction);
+                }
+            }
+        }
+    }
+
+    expand();
+}
+
+void
+FlowField::update_tile(const sf::Vector2i& tile)
+{
+    if (!map_.contains(tile)) {
+        return;
+    }
+
+    const int width = map_.get_width();
+    const int ndx = tile.y * width + tile.x;
+    int lookahead = UNREACHABLE;
+    if (tile == goal_) {
+        lookahead = 0;
+    } else if (is_open(tile)) {
+        for(const auto& direction : directions) {
+            const auto next = tile + direction;
+            if (is_open(next)) {
+                const int through = distances_[next.y * width + next.x] + 1;
+                lookahead = std::min(lookahead, std::min(through, UNREACHABLE));
+            }
+        }
+    }
+
+    lookaheads_[ndx] = lookahead;
+    if (distances_[ndx] != lookahead) {
+        open_.emplace(std::min(distances_[ndx], lookahead), ndx);
+    }
+}
+
+void
+FlowField::expand()
+{
+    const int width = map_.get_width();
+
+    while (!open_.empty()) {
+        const auto entry = open_.top();
+        open_.pop();
+
+        // skip entries left behind by a later update of the same tile
+        auto& distance = distances_[entry.second];
+        const int lookahead = lookaheads_[entry.second];
+        if (distance == lookahead || entry.first != std::min(distance, lookahead)) {
+            continue;
+        }
+        ++expanded_count_;
+
+        const sf::Vector2i tile(entry.second % width, entry.second / width);
+        if (distance > lookahead) {
+            // closer than before, which settles it
+            distance = lookahead;
+        } else {
+            // further than before, so its neighbors are updated against it being unreachable
+            distance = UNREACHABLE;
+            update_tile(tile);
+        }
+
+        for(const auto& direction : directions) {
+            update_tile(tile + direction);
+        }
+    }
+}
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <functional>
+#include <limits>
+#include <queue>
+#include <utility>
+#include <vector>
+
+#include <SFML/System/Vector2.hpp>
+
+#include "AI/A_star.hpp"
+#include "tile_map.hpp"
+
+/** \brief Steps to a single goal from every tile of a TileMap, for one agent size.
+ *
+ * Built with a breadth first search out from the goal, so any number of agents heading to the same
+ * goal share one search, and each of them only follows the falling distances from its own tile.
+ *
+ * When only some tiles of the map change, the field is repaired in place, LPA* style: just the
+ * tiles whose distance changed are expanded again, so the cost follows the size of the change
+ * rather than the size of the map.
+ *
+ * A goal which moves a few steps, as the player does between updates, is moved a step at a time,
+ * expanding only the tiles which come closer (see step_goal()). A goal further away than that is
+ * searched again from scratch. */
+class FlowField
+{
+public:
+    static constexpr int NO_PATH = -1;
+    static constexpr int MAX_GOAL_STEPS = 3; ///< Furthest the goal is moved, rather than searched
+
+    FlowField() :
+        goal_(0, 0),
+        dimensions_(0, 0),
+        is_built_(false),
+        build_count_(0),
+        expanded_count_(0)
+    { }
+    ~FlowField() = default;
+
+    /** \brief Syncs the field with the given goal and map.
+     *
+     * \param[in] goal TL (ie. min) corner of the goal position (Tile coordinates). The goal is
+     *            always reached, even where the agent doesn't fit on it.
+     * \param[in] dimensions <dx, dy> dimensions of the agents using this field.
+     * \param[in] map Tile map of the traversable area.
+     *
+     * \return true iff the field was searched again or repaired. */
+    bool update(const sf::Vector2i& goal, const sf::Vector2i& dimensions, const TileMap& map);
+
+    /** \return Steps from the given tile to the goal, NO_PATH when unreachable or off the map. */
+    inline int get_distance(const sf::Vector2i& tile) const
+    {
+        if (!map_.contains(tile)) {
+            return NO_PATH;
+        }
+
+        const int distance = distances_[tile.y * map_.get_width() + tile.x];
+        return distance == UNREACHABLE ? NO_PATH : distance;
+    }
+
+    /** \brief Follows the field downhill from start to the goal.
+     *
+     * Where several neighbors are equally close to the goal, keeps going in the same direction.
+     *
+     * \param[in] start TL (ie. min) corner of entity start position (Tile coordinates).
+     * \param[out] path Tiles from start to the goal, inclusive. Cleared first.
+     *
+     * \return true iff the goal is reachable from start. */
+    bool get_path(const sf::Vector2i& start, AStar::Path& path) const;
+
+    inline const sf::Vector2i& get_goal() const { return goal_; }
+
+    /** \return Number of times the field was searched from scratch, since construction. */
+    inline std::size_t get_build_count() const { return build_count_; }
+
+    /** \return Number of tiles expanded by the last repair or move of the goal. */
+    inline std::size_t get_expanded_count() const { return expanded_count_; }
+
+private:
+    /** \brief Larger than any distance, yet safe to add a step to. */
+    static constexpr int UNREACHABLE = std::numeric_limits<int>::max() / 2;
+
+    /** \brief <min(distance, lookahead), tile index>, smallest first. */
+    using Entry = std::pair<int, int>;
+
+    void build();
+    void repair(const TileMap& map);
+
+    /** \brief Moves the goal to the given tile, a step at a time, over the current map.
+     *
+     * \return false, leaving the field as it is, if the goal is unreachable, more than
+     *         MAX_GOAL_STEPS away, or the agent doesn't fit on the current goal. */
+    bool move_goal(const sf::Vector2i& goal);
+
+    /** \brief Moves the goal to the given neighbor of it, which the agent fits on, as does the
+     * current goal. Leaves lookaheads_ to the caller. */
+    void step_goal(const sf::Vector2i& goal);
+
+    /** \brief Recalculates the lookahead of the given tile, queueing it if inconsistent. */
+    void update_tile(const sf::Vector2i& tile);
+
+    /** \brief Expands the queued tiles, until every distance is consistent. */
+    void expand();
+
+    /** \return true iff the agent can stand on the given tile. */
+    inline bool is_open(const sf::Vector2i& tile) const
+    {
+        return tile == goal_ ? map_.contains(tile) : map_.is_clear(tile, dimensions_);
+    }
+
+    sf::Vector2i goal_;
+    sf::Vector2i dimensions_;
+    bool is_built_;
+    std::size_t build_count_;
+    std::size_t expanded_count_;
+
+    TileMap map_;                  ///< as of the last update()
+    std::vector<int> distances_;   ///< steps to goal_, indexed by y * width + x
+    std::vector<int> lookaheads_;  ///< one more than the closest neighbor's distance, per tile
+
+    std::queue<sf::Vector2i> queue_;    ///< Reused by build() and step_goal()
+    std::vector<sf::Vector2i> changed_; ///< Reused by repair(), tiles which differ from map_
+    AStar::Path steps_;                 ///< Reused by move_goal(), from the new goal to the old
+
+    /// Inconsistent tiles, reused by expand()
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open_;
+};
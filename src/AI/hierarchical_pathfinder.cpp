@@ -0,0 +1,480 @@
+#include <algorithm>
+#include <climits>
+#include <functional>
+
+#include "AI/hierarchical_pathfinder.hpp"
+
+constexpr int HierarchicalPathfinder::NO_PATH;
+
+/// Entrances at least this long get a node at each end, rather than one in the middle
+static const int LONG_ENTRANCE = 6;
+
+static const sf::Vector2i directions[] = {{0, -1}, {-1, 0}, {0, 1}, {1, 0}};
+
+static int
+manhattan(const sf::Vector2i& first, const sf::Vector2i& second)
+{
+    return std::abs(first.x - second.x) + std::abs(first.y - second.y);
+}
+
+HierarchicalPathfinder::HierarchicalPathfinder(int cluster_size) :
+    cluster_size_(cluster_size),
+    rebuild_count_(0)
+{ }
+
+void
+HierarchicalPathfinder::update(std::shared_ptr<const TileMap> map)
+{
+    rebuild_count_ = 0;
+    if (map == map_) {
+        return;
+    }
+
+    // the last map is only kept until it is compared with this one
+    const auto previous = std::move(map_);
+    map_ = std::move(map);
+    clearance_.build(*map_);
+
+    const bool is_resized = !previous || map_->get_width() != previous->get_width() ||
+                            map_->get_height() != previous->get_height();
+    if (is_resized) {
+        const int height = map_->get_height();
+        const int width = map_->get_width();
+        clusters_ = sf::Vector2i((width + cluster_size_ - 1) / cluster_size_,
+                                 (height + cluster_size_ - 1) / cluster_size_);
+
+        // rebuilt on demand by the next run()
+        layers_.clear();
+        return;
+    }
+
+    // compare a word of tiles at a time, and only look for the changed bits within it
+    for (int y = 0; y < map_->get_height(); ++y) {
+        for (int word = 0; word < map_->get_words_per_row(); ++word) {
+            const auto changed = map_->get_word(y, word) ^ previous->get_word(y, word);
+            for (int bit = 0; changed != 0 && bit < TileMap::WORD_BITS; ++bit) {
+                if (((changed >> bit) & 1) == 0) {
+                    continue;
+                }
+
+                const sf::Vector2i tile(word * TileMap::WORD_BITS + bit, y);
+                for(auto& key_layer : layers_) {
+                    const sf::Vector2i dimensions(key_layer.first.first, key_layer.first.second);
+                    mark_dirty(key_layer.second, dimensions, tile);
+                }
+            }
+        }
+    }
+
+    for(auto& key_layer : layers_) {
+        auto& layer = key_layer.second;
+        if (std::find(layer.is_dirty.begin(), layer.is_dirty.end(), true) != layer.is_dirty.end()) {
+            rebuild(layer, sf::Vector2i(key_layer.first.first, key_layer.first.second));
+        }
+    }
+}
+
+AStar::Result
+HierarchicalPathfinder::run(const sf::Vector2i& start, const sf::Vector2i& end,
+                            const sf::Vector2i& dimensions, const ClearanceMap& local_map,
+                            int refine_count)
+{
+    // the graph is only ever built from update(), as local_map is one agent's own
+    if (!map_ || local_map.get_width() != map_->get_width() ||
+        local_map.get_height() != map_->get_height()) {
+        return AStar::Result{false, AStar::Path()};
+    }
+
+    if (!local_map.contains(start) || !local_map.fits(end, dimensions)) {
+        return AStar::Result{false, AStar::Path()};
+    }
+
+    if (start == end) {
+        return AStar::Result{true, AStar::Path{start}};
+    }
+
+    auto& layer = get_layer(dimensions);
+    const auto& clusters = layer.clusters;
+
+    // connect start and end to the entrances of their own clusters
+    const int start_cluster = cluster_for(start);
+    const int end_cluster = cluster_for(end);
+    const auto local_ndx = [](const Cluster& cluster, const sf::Vector2i& tile)
+    {
+        const int width = cluster.max.x - cluster.min.x;
+        return (tile.y - cluster.min.y) * width + (tile.x - cluster.min.x);
+    };
+
+    flood(local_map, dimensions, clusters[start_cluster], start, steps_);
+    start_steps_.clear();
+    for(const auto& node : clusters[start_cluster].nodes) {
+        start_steps_.push_back(steps_[local_ndx(clusters[start_cluster], node)]);
+    }
+    const int direct_steps =
+        start_cluster == end_cluster ? steps_[local_ndx(clusters[start_cluster], end)] : NO_PATH;
+
+    flood(local_map, dimensions, clusters[end_cluster], end, steps_);
+    end_steps_.clear();
+    for(const auto& node : clusters[end_cluster].nodes) {
+        end_steps_.push_back(steps_[local_ndx(clusters[end_cluster], node)]);
+    }
+
+    // search the abstract graph, where each entrance node has an id after those of earlier clusters
+    offsets_.assign(1, 0);
+    for(const auto& cluster : clusters) {
+        offsets_.push_back(offsets_.back() + static_cast<int>(cluster.nodes.size()));
+    }
+
+    const int start_id = offsets_.back();
+    const int end_id = start_id + 1;
+    costs_.assign(end_id + 1, INT_MAX);
+    came_from_.assign(end_id + 1, NO_PATH);
+    is_closed_.assign(end_id + 1, false);
+
+    auto cluster_of = [this](int id)
+    {
+        const auto next = std::upper_bound(offsets_.begin(), offsets_.end(), id);
+        return static_cast<int>(next - offsets_.begin()) - 1;
+    };
+    auto tile_for = [&](int id)
+    {
+        if (id == start_id) { return start; }
+        if (id == end_id)   { return end; }
+        const auto cluster_ndx = cluster_of(id);
+        return clusters[cluster_ndx].nodes[id - offsets_[cluster_ndx]];
+    };
+
+    using Element = std::pair<int, int>; ///< <cost + heuristic, id>
+    std::priority_queue<Element, std::vector<Element>, std::greater<Element>> frontier;
+
+    auto relax = [&](int id, int cost, int from)
+    {
+        if (cost < costs_[id]) {
+            costs_[id] = cost;
+            came_from_[id] = from;
+            frontier.emplace(cost + manhattan(tile_for(id), end), id);
+        }
+    };
+    auto cross = [&](int id, int cluster_ndx, const sf::Vector2i& tile, int cost)
+    {
+        const auto& nodes = clusters[cluster_ndx].nodes;
+        const auto node = std::find(nodes.begin(), nodes.end(), tile);
+        relax(offsets_[cluster_ndx] + static_cast<int>(node - nodes.begin()), cost, id);
+    };
+
+    costs_[start_id] = 0;
+    frontier.emplace(manhattan(start, end), start_id);
+    while (!frontier.empty()) {
+        const auto id = frontier.top().second;
+        frontier.pop();
+
+        if (is_closed_[id]) {
+            continue;
+        }
+        is_closed_[id] = true;
+
+        if (id == end_id) {
+            break;
+        }
+
+        if (id == start_id) {
+            for (int ndx = 0; ndx < static_cast<int>(start_steps_.size()); ++ndx) {
+                if (start_steps_[ndx] != NO_PATH) {
+                    relax(offsets_[start_cluster] + ndx, start_steps_[ndx], id);
+                }
+            }
+
+            if (direct_steps != NO_PATH) {
+                relax(end_id, direct_steps, id);
+            }
+            continue;
+        }
+
+        const auto cluster_ndx = cluster_of(id);
+        const auto& cluster = clusters[cluster_ndx];
+        const int node_count = static_cast<int>(cluster.nodes.size());
+        const int node_ndx = id - offsets_[cluster_ndx];
+        const auto tile = cluster.nodes[node_ndx];
+
+        for (int ndx = 0; ndx < node_count; ++ndx) {
+            const auto steps = cluster.distances[node_ndx * node_count + ndx];
+            if (ndx != node_ndx && steps != NO_PATH) {
+                relax(offsets_[cluster_ndx] + ndx, costs_[id] + steps, id);
+            }
+        }
+
+        if (cluster_ndx == end_cluster && end_steps_[node_ndx] != NO_PATH) {
+            relax(end_id, costs_[id] + end_steps_[node_ndx], id);
+        }
+
+        // step across into the neighboring clusters
+        for(const auto& transition : layer.right_borders[cluster_ndx]) {
+            if (transition.first == tile) {
+                cross(id, cluster_ndx + 1, transition.second, costs_[id] + 1);
+            }
+        }
+        for(const auto& transition : layer.lower_borders[cluster_ndx]) {
+            if (transition.first == tile) {
+                cross(id, cluster_ndx + clusters_.x, transition.second, costs_[id] + 1);
+            }
+        }
+        if (cluster_ndx % clusters_.x > 0) {
+            for(const auto& transition : layer.right_borders[cluster_ndx - 1]) {
+                if (transition.second == tile) {
+                    cross(id, cluster_ndx - 1, transition.first, costs_[id] + 1);
+                }
+            }
+        }
+        if (cluster_ndx >= clusters_.x) {
+            for(const auto& transition : layer.lower_borders[cluster_ndx - clusters_.x]) {
+                if (transition.second == tile) {
+                    cross(id, cluster_ndx - clusters_.x, transition.first, costs_[id] + 1);
+                }
+            }
+        }
+    }
+
+    if (costs_[end_id] == INT_MAX) {
+        return AStar::Result{false, AStar::Path()};
+    }
+
+    waypoints_.clear();
+    for (int id = end_id; id != start_id; id = came_from_[id]) {
+        waypoints_.push_back(tile_for(id));
+    }
+    waypoints_.push_back(start);
+    std::reverse(waypoints_.begin(), waypoints_.end());
+    waypoints_.erase(std::unique(waypoints_.begin(), waypoints_.end()), waypoints_.end());
+
+    // refine only the legs the agent will walk before its next search
+    AStar::Path path{start};
+    const int waypoint_count = static_cast<int>(waypoints_.size());
+    for (int ndx = 1; ndx < waypoint_count && ndx <= refine_count; ++ndx) {
+        auto leg = AStar::run(waypoints_[ndx - 1], waypoints_[ndx], dimensions, local_map,
+                              AStar::Mode::JUMP_POINT);
+        if (!leg.has_path) {
+            return AStar::Result{false, AStar::Path()};
+        }
+
+        path.insert(path.end(), leg.path.begin() + 1, leg.path.end());
+    }
+
+    return AStar::Result{true, path};
+}
+
+HierarchicalPathfinder::Layer&
+HierarchicalPathfinder::get_layer(const sf::Vector2i& dimensions)
+{
+    const LayerKey key(dimensions.x, dimensions.y);
+    auto found = layers_.find(key);
+    if (found != layers_.end()) {
+        return found->second;
+    }
+
+    auto& layer = layers_[key];
+    const int height = map_->get_height();
+    const int width = map_->get_width();
+
+    for (int y = 0; y < clusters_.y; ++y) {
+        for (int x = 0; x < clusters_.x; ++x) {
+            const sf::Vector2i min(x * cluster_size_, y * cluster_size_);
+            const sf::Vector2i max(std::min(min.x + cluster_size_, width),
+                                   std::min(min.y + cluster_size_, height));
+            layer.clusters.push_back(Cluster{min, max, {}, {}});
+        }
+    }
+
+    const auto count = layer.clusters.size();
+    layer.right_borders.resize(count);
+    layer.lower_borders.resize(count);
+    layer.is_dirty.assign(count, true);
+
+    rebuild(layer, dimensions);
+    return layer;
+}
+
+void
+HierarchicalPathfinder::mark_dirty(Layer& layer, const sf::Vector2i& dimensions,
+                                   const sf::Vector2i& tile)
+{
+    // the agent covers the changed tile from any TL corner up to dimensions - 1 before it
+    const int min_x = std::max(0, tile.x - dimensions.x + 1) / cluster_size_;
+    const int min_y = std::max(0, tile.y - dimensions.y + 1) / cluster_size_;
+
+    for (int y = min_y; y <= tile.y / cluster_size_; ++y) {
+        for (int x = min_x; x <= tile.x / cluster_size_; ++x) {
+            layer.is_dirty[y * clusters_.x + x] = true;
+        }
+    }
+}
+
+void
+HierarchicalPathfinder::rebuild(Layer& layer, const sf::Vector2i& dimensions)
+{
+    // entrances on every border of a dirty cluster move, which changes the nodes on both sides
+    std::vector<bool> is_relinked(layer.clusters.size(), false);
+    for (int ndx = 0; ndx < static_cast<int>(layer.clusters.size()); ++ndx) {
+        if (!layer.is_dirty[ndx]) {
+            continue;
+        }
+
+        const int x = ndx % clusters_.x;
+        const int y = ndx / clusters_.x;
+
+        is_relinked[ndx] = true;
+        if (x + 1 < clusters_.x) {
+            find_transitions(layer, dimensions, ndx, true);
+            is_relinked[ndx + 1] = true;
+        }
+        if (y + 1 < clusters_.y) {
+            find_transitions(layer, dimensions, ndx, false);
+            is_relinked[ndx + clusters_.x] = true;
+        }
+        if (x > 0) {
+            find_transitions(layer, dimensions, ndx - 1, true);
+            is_relinked[ndx - 1] = true;
+        }
+        if (y > 0) {
+            find_transitions(layer, dimensions, ndx - clusters_.x, false);
+            is_relinked[ndx - clusters_.x] = true;
+        }
+    }
+
+    for (int ndx = 0; ndx < static_cast<int>(layer.clusters.size()); ++ndx) {
+        if (is_relinked[ndx]) {
+            link(layer, dimensions, ndx);
+            ++rebuild_count_;
+        }
+    }
+
+    std::fill(layer.is_dirty.begin(), layer.is_dirty.end(), false);
+}
+
+void
+HierarchicalPathfinder::find_transitions(Layer& layer, const sf::Vector2i& dimensions,
+                                         int cluster_ndx, bool is_right)
+{
+    const auto& cluster = layer.clusters[cluster_ndx];
+    auto& transitions = is_right ? layer.right_borders[cluster_ndx]
+                                 : layer.lower_borders[cluster_ndx];
+    transitions.clear();
+
+    const sf::Vector2i along = is_right ? sf::Vector2i(0, 1) : sf::Vector2i(1, 0);
+    const sf::Vector2i across = is_right ? sf::Vector2i(1, 0) : sf::Vector2i(0, 1);
+    const sf::Vector2i first = is_right ? sf::Vector2i(cluster.max.x - 1, cluster.min.y)
+                                        : sf::Vector2i(cluster.min.x, cluster.max.y - 1);
+    const int length = is_right ? cluster.max.y - cluster.min.y : cluster.max.x - cluster.min.x;
+
+    auto add = [&](int ndx)
+    {
+        const auto tile = first + along * ndx;
+        transitions.emplace_back(tile, tile + across);
+    };
+
+    int run_start = -1;
+    for (int ndx = 0; ndx <= length; ++ndx) {
+        const auto tile = first + along * ndx;
+        const bool is_open = ndx < length &&
+                             clearance_.fits(tile, dimensions) &&
+                             clearance_.fits(tile + across, dimensions);
+
+        if (is_open && run_start < 0) {
+            run_start = ndx;
+        } else if (!is_open && run_start >= 0) {
+            const int run_end = ndx - 1;
+            if (run_end - run_start + 1 >= LONG_ENTRANCE) {
+                add(run_start);
+                add(run_end);
+            } else {
+                add((run_start + run_end) / 2);
+            }
+            run_start = -1;
+        }
+    }
+}
+
+void
+HierarchicalPathfinder::link(Layer& layer, const sf::Vector2i& dimensions, int cluster_ndx)
+{
+    auto& cluster = layer.clusters[cluster_ndx];
+    auto& nodes = cluster.nodes;
+    nodes.clear();
+
+    auto add = [&nodes](const sf::Vector2i& tile)
+    {
+        if (std::find(nodes.begin(), nodes.end(), tile) == nodes.end()) {
+            nodes.push_back(tile);
+        }
+    };
+
+    for(const auto& transition : layer.right_borders[cluster_ndx]) {
+        add(transition.first);
+    }
+    for(const auto& transition : layer.lower_borders[cluster_ndx]) {
+        add(transition.first);
+    }
+    if (cluster_ndx % clusters_.x > 0) {
+        for(const auto& transition : layer.right_borders[cluster_ndx - 1]) {
+            add(transition.second);
+        }
+    }
+    if (cluster_ndx >= clusters_.x) {
+        for(const auto& transition : layer.lower_borders[cluster_ndx - clusters_.x]) {
+            add(transition.second);
+        }
+    }
+
+    const int node_count = static_cast<int>(nodes.size());
+    const int width = cluster.max.x - cluster.min.x;
+    cluster.distances.assign(node_count * node_count, NO_PATH);
+
+    for (int from = 0; from < node_count; ++from) {
+        flood(clearance_, dimensions, cluster, nodes[from], steps_);
+
+        for (int to = 0; to < node_count; ++to) {
+            const auto& tile = nodes[to];
+            cluster.distances[from * node_count + to] =
+                steps_[(tile.y - cluster.min.y) * width + (tile.x - cluster.min.x)];
+        }
+    }
+}
+
+void
+HierarchicalPathfinder::flood(const ClearanceMap& map, const sf::Vector2i& dimensions,
+                              const Cluster& cluster, const sf::Vector2i& origin,
+                              std::vector<int>& steps)
+{
+    const int width = cluster.max.x - cluster.min.x;
+    const auto local_ndx = [&cluster, width](const sf::Vector2i& tile)
+    {
+        return (tile.y - cluster.min.y) * width + (tile.x - cluster.min.x);
+    };
+
+    steps.assign(width * (cluster.max.y - cluster.min.y), NO_PATH);
+    steps[local_ndx(origin)] = 0;
+    flood_queue_.push(origin);
+
+    while (!flood_queue_.empty()) {
+        const auto tile = flood_queue_.front();
+        flood_queue_.pop();
+
+        for(const auto& direction : directions) {
+            const auto next = tile + direction;
+            if (next.x < cluster.min.x || next.x >= cluster.max.x ||
+                next.y < cluster.min.y || next.y >= cluster.max.y ||
+                steps[local_ndx(next)] != NO_PATH ||
+                !map.fits(next, dimensions)) {
+                continue;
+            }
+
+            steps[local_ndx(next)] = steps[local_ndx(tile)] + 1;
+            flood_queue_.push(next);
+        }
+    }
+}
+
+int
+HierarchicalPathfinder::cluster_for(const sf::Vector2i& tile) const
+{
+    return (tile.y / cluster_size_) * clusters_.x + tile.x / cluster_size_;
+}
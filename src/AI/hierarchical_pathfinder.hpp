@@ -0,0 +1,126 @@
+#pragma once
+
+#include <map>
+#include <memory>
+#include <queue>
+#include <utility>
+#include <vector>
+
+#include <SFML/System/Vector2.hpp>
+
+#include "AI/A_star.hpp"
+#include "AI/clearance_map.hpp"
+#include "tile_map.hpp"
+
+/** \brief Hierarchical path finding (HPA*) over a TileMap.
+ *
+ * The map is divided into square clusters. Wherever an agent can step across the border between
+ * two clusters, an entrance node is placed on each side, and the distances between entrances
+ * within each cluster are precomputed. A search then only has to cross the small graph of
+ * entrances, and just the first few legs of that abstract path are refined into tiles.
+ *
+ * Graphs are cached per agent size, and update() only rebuilds the clusters affected by tiles which
+ * changed since the last update. */
+class HierarchicalPathfinder
+{
+public:
+    /** \param[in] cluster_size Width and height of each cluster, in tiles. */
+    explicit HierarchicalPathfinder(int cluster_size = 10);
+    ~HierarchicalPathfinder() = default;
+
+    /** \brief Syncs the cached graphs with the given map.
+     *
+     * The map is held on to rather than copied, as the next update() compares against it, so it
+     * must never be written to. Only clusters near a changed tile are rebuilt. A map of a different
+     * size rebuilds everything, and the map the graphs already have rebuilds nothing. */
+    void update(std::shared_ptr<const TileMap> map);
+
+    /** \return Map of the last update(), nullptr before the first. */
+    inline const std::shared_ptr<const TileMap>& get_map() const { return map_; }
+
+    /** \return Clearance of the map of the last update(). */
+    inline const ClearanceMap& get_clearance() const { return clearance_; }
+
+    /** \brief Finds a path from start to end, over the map of the last update().
+     *
+     * The connections from start and end to their clusters' entrances, and the refined legs, are
+     * searched over local_map, so an agent can pass in a map which ignores its own footprint. The
+     * legs in between come from the cached graph, which local_map never changes.
+     *
+     * \param[in] start TL (ie. min) corner of entity start position (Tile coordinates).
+     * \param[in] end TL (ie. min) corner of entity end position {Tile coordinates}.
+     * \param[in] dimensions <dx, dy> dimensions of the entity.
+     * \param[in] local_map Clearance of the traversable area, as seen by the entity. The size of
+     *                      the map of the last update().
+     * \param[in] refine_count Number of legs of the abstract path to refine into tiles.
+     *
+     * \return has_path iff there is an abstract path from start to end. The path starts at start,
+     *         and only reaches end when every leg was refined. */
+    AStar::Result run(const sf::Vector2i& start, const sf::Vector2i& end,
+                      const sf::Vector2i& dimensions, const ClearanceMap& local_map,
+                      int refine_count = 2);
+
+    /** \return Number of clusters rebuilt by the last update() or new agent size. */
+    inline std::size_t get_rebuild_count() const { return rebuild_count_; }
+
+private:
+    /** \brief Crossing between two neighboring clusters, <left or upper, right or lower>. */
+    using Transition = std::pair<sf::Vector2i, sf::Vector2i>;
+
+    struct Cluster
+    {
+        sf::Vector2i min;                ///< TL tile, inclusive
+        sf::Vector2i max;                ///< BR tile, exclusive
+        std::vector<sf::Vector2i> nodes; ///< entrance tiles
+        std::vector<int> distances;      ///< steps between entrances, [from * nodes + to], -1 if
+                                         ///< none
+    };
+
+    /** \brief Graph for one agent size. */
+    struct Layer
+    {
+        std::vector<Cluster> clusters;
+        std::vector<std::vector<Transition>> right_borders; ///< per cluster, with the one right
+        std::vector<std::vector<Transition>> lower_borders; ///< per cluster, with the one below
+        std::vector<bool> is_dirty;
+    };
+
+    using LayerKey = std::pair<int, int>;
+
+    static constexpr int NO_PATH = -1;
+
+    Layer& get_layer(const sf::Vector2i& dimensions);
+    void mark_dirty(Layer& layer, const sf::Vector2i& dimensions, const sf::Vector2i& tile);
+    void rebuild(Layer& layer, const sf::Vector2i& dimensions);
+
+    void find_transitions(Layer& layer, const sf::Vector2i& dimensions, int cluster_ndx,
+                          bool is_right);
+    void link(Layer& layer, const sf::Vector2i& dimensions, int cluster_ndx);
+
+    /** \brief Steps from the given tile to every tile of the cluster, staying inside it.
+     *
+     * The origin is always entered, even where the agent doesn't fit. */
+    void flood(const ClearanceMap& map, const sf::Vector2i& dimensions, const Cluster& cluster,
+               const sf::Vector2i& origin, std::vector<int>& steps);
+
+    int cluster_for(const sf::Vector2i& tile) const;
+
+    int cluster_size_;
+    sf::Vector2i clusters_;              ///< number of clusters <wide, high>
+    std::shared_ptr<const TileMap> map_; ///< as of the last update()
+    ClearanceMap clearance_;             ///< of map_, shared by every layer
+    std::map<LayerKey, Layer> layers_;
+    std::size_t rebuild_count_;
+
+    // Reused by run(), to avoid reallocating for each search
+    std::vector<int> start_steps_;      ///< steps from start to each entrance of its cluster
+    std::vector<int> end_steps_;        ///< steps from each entrance of its cluster to end
+    std::vector<int> offsets_;          ///< id of the first entrance node of each cluster
+    std::vector<int> costs_;            ///< steps from start, per node id
+    std::vector<int> came_from_;        ///< node id before this one, per node id
+    std::vector<bool> is_closed_;       ///< already expanded, per node id
+    std::vector<sf::Vector2i> waypoints_;
+
+    std::vector<int> steps_;               ///< Reused by flood(), steps per tile in the cluster
+    std::queue<sf::Vector2i> flood_queue_; ///< Reused by flood()
+};
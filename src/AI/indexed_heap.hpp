@@ -0,0 +1,83 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+/** \brief Min heap of indices in [0, capacity), keyed by a priority which can be lowered in place.
+ *
+ * A position table tracks where each index sits in the heap, so an index is never queued twice:
+ * lowering its priority moves it up rather than pushing a duplicate. Each node has Arity children,
+ * which keeps the heap shallow and its siblings on the same cache lines.
+ *
+ * Ties on priority go to the lower index, so equal priorities are popped in the same order each
+ * time. Indices are stored in 32 bits, to fit more items per cache line. Storage is kept across
+ * reset()s, to avoid reallocating for each use. */
+template<class Priority, std::size_t Arity = 4>
+class IndexedHeap
+{
+    static_assert(Arity >= 2, "a heap node needs at least two children");
+
+public:
+    IndexedHeap()  = default;
+    ~IndexedHeap() = default;
+
+    /** \brief Empties the heap, making room for the indices [0, capacity). */
+    void reset(std::size_t capacity);
+
+    inline bool empty() const { return heap_.empty(); }
+    inline std::size_t size() const { return heap_.size(); }
+
+    /** \return true iff the given index is queued. */
+    inline bool contains(std::size_t index) const
+    {
+        return index < positions_.size() && positions_[index] != NOT_QUEUED;
+    }
+
+    /** \brief Queues the index with the given priority, or lowers its priority if already queued.
+     *
+     * \return false iff the index was already queued with a priority no higher than the given
+     *         one, and was left as it was. */
+    bool push_or_decrease(std::size_t index, const Priority& priority);
+
+    /** \return The index with the lowest priority. The heap must not be empty. */
+    inline std::size_t top() const { return heap_.front().index; }
+    inline const Priority& top_priority() const { return heap_.front().priority; }
+
+    /** \brief Removes top(). The heap must not be empty. */
+    void pop();
+
+private:
+    static constexpr std::uint32_t NOT_QUEUED = std::numeric_limits<std::uint32_t>::max();
+
+    struct Item
+    {
+        Priority priority;
+        std::uint32_t index;
+
+        inline bool operator<(const Item& item) const
+        {
+            return priority < item.priority || (!(item.priority < priority) && index < item.index);
+        }
+    };
+
+    /** \brief Moves the item at the given position towards the root, until its parent is lower. */
+    void sift_up(std::size_t position);
+
+    /** \brief Moves the item at the given position towards the leaves, until it is lowest. */
+    void sift_down(std::size_t position);
+
+    /** \brief Puts the item at the given position, updating the position table. */
+    inline void place(const Item& item, std::size_t position)
+    {
+        heap_[position] = item;
+        positions_[item.index] = static_cast<std::uint32_t>(position);
+    }
+
+    std::vector<Item> heap_;
+    std::vector<std::uint32_t> positions_; ///< position in heap_, indexed by index
+};
+
+#include "AI/indexed_heap.inl"
@@ -0,0 +1,104 @@
+/** \brief Definitions for the templated functions declared in indexed_heap.hpp. */
+
+template<class Priority, std::size_t Arity>
+constexpr std::uint32_t IndexedHeap<Priority, Arity>::NOT_QUEUED;
+
+template<class Priority, std::size_t Arity>
+void
+IndexedHeap<Priority, Arity>::reset(std::size_t capacity)
+{
+    // only the queued indices are left to clear, the rest were cleared as they were popped
+    for(const auto& item : heap_) {
+        positions_[item.index] = NOT_QUEUED;
+    }
+    heap_.clear();
+
+    if (positions_.size() < capacity) {
+        positions_.resize(capacity, NOT_QUEUED);
+    }
+}
+
+template<class Priority, std::size_t Arity>
+bool
+IndexedHeap<Priority, Arity>::push_or_decrease(std::size_t index, const Priority& priority)
+{
+    if (index >= positions_.size()) {
+        positions_.resize(index + 1, NOT_QUEUED);
+    }
+
+    auto position = positions_[index];
+    if (position == NOT_QUEUED) {
+        position = heap_.size();
+        heap_.push_back(Item{priority, static_cast<std::uint32_t>(index)});
+        positions_[index] = static_cast<std::uint32_t>(position);
+    } else if (priority < heap_[position].priority) {
+        heap_[position].priority = priority;
+    } else {
+        return false;
+    }
+
+    sift_up(position);
+    return true;
+}
+
+template<class Priority, std::size_t Arity>
+void
+IndexedHeap<Priority, Arity>::pop()
+{
+    positions_[heap_.front().index] = NOT_QUEUED;
+
+    const auto last = heap_.back();
+    heap_.pop_back();
+    if (!heap_.empty()) {
+        place(last, 0);
+        sift_down(0);
+    }
+}
+
+template<class Priority, std::size_t Arity>
+void
+IndexedHeap<Priority, Arity>::sift_up(std::size_t position)
+{
+    const auto item = heap_[position];
+    while (position > 0) {
+        const auto parent = (position - 1) / Arity;
+        if (!(item < heap_[parent])) {
+            break;
+        }
+
+        place(heap_[parent], position);
+        position = parent;
+    }
+    place(item, position);
+}
+
+template<class Priority, std::size_t Arity>
+void
+IndexedHeap<Priority, Arity>::sift_down(std::size_t position)
+{
+    const auto item = heap_[position];
+    const auto size = heap_.size();
+    while (true) {
+        const auto first_child = position * Arity + 1;
+        if (first_child >= size) {
+            break;
+        }
+
+        // find the lowest child
+        auto lowest = first_child;
+        const auto end = std::min(first_child + Arity, size);
+        for (auto child = first_child + 1; child < end; ++child) {
+            if (heap_[child] < heap_[lowest]) {
+                lowest = child;
+            }
+        }
+
+        if (!(heap_[lowest] < item)) {
+            break;
+        }
+
+        place(heap_[lowest], position);
+        position = lowest;
+    }
+    place(item, position);
+}
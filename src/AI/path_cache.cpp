@@ -0,0 +1,137 @@
+#include <algorithm>
+#include <iterator>
+
+#include "AI/path_cache.hpp"
+
+PathCache::PathCache(std::size_t capacity, int cluster_size) :
+    capacity_(std::max<std::size_t>(capacity, 1)),
+    cluster_size_(std::max(cluster_size, 1)),
+    version_(0),
+    hit_count_(0),
+    miss_count_(0)
+{ }
+
+bool
+PathCache::find(const sf::Vector2i& start, const sf::Vector2i& end,
+                const sf::Vector2i& dimensions, std::size_t version, AStar::Path& path)
+{
+    if (!sync_version(version)) {
+        ++miss_count_;
+        return false;
+    }
+
+    const auto found = index_.equal_range(Key{cluster_for(start), cluster_for(end), dimensions});
+    for (auto indexed = found.first; indexed != found.second; ++indexed) {
+        if (indexed->second->end == end && take_tail(indexed->second, start, path)) {
+            return true;
+        }
+    }
+
+    ++miss_count_;
+    return false;
+}
+
+void
+PathCache::store(const sf::Vector2i& start, const sf::Vector2i& end,
+                 const sf::Vector2i& dimensions, std::size_t version,
+                 const AStar::Result& result)
+{
+    if (!result.has_path || result.path.empty() || !sync_version(version)) {
+        return;
+    }
+
+    const Key key{cluster_for(start), cluster_for(end), dimensions};
+    const auto found = index_.equal_range(key);
+    for (auto indexed = found.first; indexed != found.second; ++indexed) {
+        const auto entry = indexed->second;
+        if (entry->end == end && cluster_for(entry->path.front()) == key.cluster) {
+            erase(entry);
+            break;
+        }
+    }
+
+    entries_.push_front(Entry{end, result.path, {}});
+    add_to_index(entries_.begin(), dimensions);
+
+    if (entries_.size() > capacity_) {
+        erase(std::prev(entries_.end()));
+    }
+}
+
+void
+PathCache::clear()
+{
+    entries_.clear();
+    index_.clear();
+}
+
+sf::Vector2i
+PathCache::cluster_for(const sf::Vector2i& tile) const
+{
+    // round towards negative infinity, so the tiles left of 0 share a cluster too
+    const auto cluster_of = [this](int value) {
+        return value >= 0 ? value / cluster_size_ : (value + 1) / cluster_size_ - 1;
+    };
+
+    return sf::Vector2i(cluster_of(tile.x), cluster_of(tile.y));
+}
+
+void
+PathCache::add_to_index(Entries::iterator entry, const sf::Vector2i& dimensions)
+{
+    const auto goal_cluster = cluster_for(entry->end);
+    auto& keys = entry->keys;
+    for(const auto& tile : entry->path) {
+        const Key key{cluster_for(tile), goal_cluster, dimensions};
+        if (std::find(keys.begin(), keys.end(), key) == keys.end()) {
+            keys.push_back(key);
+            index_.emplace(key, entry);
+        }
+    }
+}
+
+void
+PathCache::erase(Entries::iterator entry)
+{
+    for(const auto& key : entry->keys) {
+        const auto found = index_.equal_range(key);
+        for (auto indexed = found.first; indexed != found.second; ++indexed) {
+            if (indexed->second == entry) {
+                index_.erase(indexed);
+                break;
+            }
+        }
+    }
+
+    entries_.erase(entry);
+}
+
+bool
+PathCache::take_tail(Entries::iterator entry, const sf::Vector2i& start, AStar::Path& path)
+{
+    const auto& cached = entry->path;
+    auto tail = std::find(cached.begin(), cached.end(), start);
+    if (tail == cached.end()) {
+        return false;
+    }
+
+    path.assign(tail, cached.end());
+    entries_.splice(entries_.begin(), entries_, entry);
+    ++hit_count_;
+    return true;
+}
+
+bool
+PathCache::sync_version(std::size_t version)
+{
+    if (version < version_) {
+        return false;
+    }
+
+    if (version > version_) {
+        clear();
+        version_ = version;
+    }
+
+    return true;
+}
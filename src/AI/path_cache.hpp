@@ -0,0 +1,117 @@
+#pragma once
+
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+#include <SFML/System/Vector2.hpp>
+
+#include "AI/A_star.hpp"
+
+/** \brief Least recently used cache of paths, for agents heading to the same goal.
+ *
+ * The map is divided into square clusters, and each path is indexed by <cluster, goal cluster,
+ * agent size> for every cluster it passes through. A lookup only checks the paths indexed under
+ * its own start and goal clusters, and is a hit where the start tile lies on one of them which ends
+ * on the same goal tile. It returns the tail of that path, from start on.
+ *
+ * Every path is only good for the map it was searched over, so each lookup and store carries the
+ * map's version (see OccupancyGrid::get_version()), and a new version drops every entry.
+ *
+ * Only enemies which request their paths use it (see AIEnemy::Navigation::PATH_REQUEST), which is
+ * off by default, and toggled with N in the demo. */
+class PathCache
+{
+public:
+    /** \param[in] capacity Number of paths kept, before the least recently used is dropped.
+     *  \param[in] cluster_size Width and height of each cluster, in tiles. */
+    explicit PathCache(std::size_t capacity = 64, int cluster_size = 10);
+    ~PathCache() = default;
+
+    /** \brief Looks for a cached path from start to end.
+     *
+     * \param[in] start TL (ie. min) corner of entity start position (Tile coordinates).
+     * \param[in] end TL (ie. min) corner of entity end position {Tile coordinates}.
+     * \param[in] dimensions <dx, dy> dimensions of the entity.
+     * \param[in] version Version of the map the path is for.
+     * \param[out] path Tiles from start to end, inclusive, on a hit. Untouched otherwise.
+     *
+     * \return true iff a path was found. */
+    bool find(const sf::Vector2i& start, const sf::Vector2i& end, const sf::Vector2i& dimensions,
+              std::size_t version, AStar::Path& path);
+
+    /** \brief Caches the result of a search from start to end.
+     *
+     * It replaces any path from the same start cluster to the same goal. Results without a path,
+     * or searched over an older version of the map than the latest seen, aren't kept. */
+    void store(const sf::Vector2i& start, const sf::Vector2i& end, const sf::Vector2i& dimensions,
+               std::size_t version, const AStar::Result& result);
+
+    void clear();
+
+    inline std::size_t get_size() const { return entries_.size(); }
+    inline std::size_t get_hit_count() const { return hit_count_; }
+    inline std::size_t get_miss_count() const { return miss_count_; }
+
+private:
+    struct Key
+    {
+        sf::Vector2i cluster;      ///< of a tile on the path
+        sf::Vector2i goal_cluster;
+        sf::Vector2i dimensions;
+
+        bool operator==(const Key& key) const
+        {
+            return cluster == key.cluster && goal_cluster == key.goal_cluster &&
+                   dimensions == key.dimensions;
+        }
+    };
+
+    struct KeyHash
+    {
+        std::size_t operator()(const Key& key) const
+        {
+            std::size_t hash = 0;
+            for(int value : {key.cluster.x, key.cluster.y, key.goal_cluster.x, key.goal_cluster.y,
+                             key.dimensions.x, key.dimensions.y}) {
+                hash = hash * 31 + std::hash<int>()(value);
+            }
+            return hash;
+        }
+    };
+
+    struct Entry
+    {
+        sf::Vector2i end;
+        AStar::Path path;
+        std::vector<Key> keys; ///< it is indexed under, one per cluster the path passes through
+    };
+
+    using Entries = std::list<Entry>;
+
+    sf::Vector2i cluster_for(const sf::Vector2i& tile) const;
+
+    /** \brief Indexes the entry under every cluster its path passes through. */
+    void add_to_index(Entries::iterator entry, const sf::Vector2i& dimensions);
+
+    /** \brief Drops the entry, and its keys from the index. */
+    void erase(Entries::iterator entry);
+
+    /** \brief Copies the tail of the entry's path from start, if start is on it. */
+    bool take_tail(Entries::iterator entry, const sf::Vector2i& start, AStar::Path& path);
+
+    /** \brief Drops every entry if the version is newer than the cached one.
+     *
+     * \return false iff the version is older than the cached one. */
+    bool sync_version(std::size_t version);
+
+    std::size_t capacity_;
+    int cluster_size_;
+    std::size_t version_;
+
+    Entries entries_;                                            ///< most recently used first
+    std::unordered_multimap<Key, Entries::iterator, KeyHash> index_;
+
+    std::size_t hit_count_;
+    std::size_t miss_count_;
+};
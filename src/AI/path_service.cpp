@@ -0,0 +1,140 @@
+#include <algorithm>
+#include <limits>
+
+#include <SFML/System/Clock.hpp>
+
+#include "AI/path_service.hpp"
+
+#include "profiler.hpp"
+
+PathService::PathService(std::size_t thread_count) :
+    next_ticket_(0),
+    is_stopping_(false)
+{
+    thread_count = std::max<std::size_t>(thread_count, 1);
+    workers_.reserve(thread_count);
+    for (std::size_t ndx = 0; ndx < thread_count; ++ndx) {
+        workers_.emplace_back(&PathService::work, this);
+    }
+}
+
+PathService::~PathService()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        is_stopping_ = true;
+    }
+    has_requests_.notify_all();
+
+    for(auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+PathService::Ticket
+PathService::submit(Request request)
+{
+    Ticket ticket;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ticket = next_ticket_++;
+        requests_.emplace_back(ticket, std::move(request));
+    }
+    has_requests_.notify_one();
+
+    return ticket;
+}
+
+bool
+PathService::collect(Ticket ticket, Response& response)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto found = responses_.find(ticket);
+    if (found == responses_.end()) {
+        return false;
+    }
+
+    response = std::move(found->second);
+    responses_.erase(found);
+    return true;
+}
+
+void
+PathService::cancel(Ticket ticket)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto queued = std::find_if(requests_.begin(), requests_.end(),
+                               [ticket](const auto& entry) { return entry.first == ticket; });
+    if (queued != requests_.end()) {
+        requests_.erase(queued);
+    }
+    running_.erase(ticket);
+    responses_.erase(ticket);
+}
+
+std::size_t
+PathService::get_default_thread_count()
+{
+    const std::size_t cores = std::thread::hardware_concurrency();
+    return cores > 1 ? cores - 1 : 1;
+}
+
+void
+PathService::work()
+{
+    // the Game shares one snapshot per version of the map, so its clearance and cluster graphs are
+    // synced once, and held with the snapshot, so a new snapshot is never mistaken for the old one
+    HierarchicalPathfinder hierarchical;
+
+    // for searches from inside an obstacle, reused to avoid reallocating for each of them
+    TileMap footprint_map;
+    ClearanceMap footprint_clearance;
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        has_requests_.wait(lock, [this] { return is_stopping_ || !requests_.empty(); });
+        if (is_stopping_) {
+            return;
+        }
+
+        const auto ticket = requests_.front().first;
+        const auto request = std::move(requests_.front().second);
+        requests_.pop_front();
+        running_.insert(ticket);
+        lock.unlock();
+
+        Response response;
+        {
+            Profiler::Zone zone("path_search");
+            sf::Clock clock;
+            hierarchical.update(request.map);
+
+            // only an entity pushed into an obstacle needs its own map, with its footprint cleared
+            const auto* map = &hierarchical.get_clearance();
+            const auto footprint = request.ignore_max - request.ignore_min + sf::Vector2i(1, 1);
+            if (!request.map->is_clear(request.ignore_min, footprint)) {
+                footprint_map = *request.map;
+                footprint_map.fill(request.ignore_min, footprint, Tile{true});
+                footprint_clearance.build(footprint_map);
+                map = &footprint_clearance;
+            }
+
+            if (request.search == Search::HIERARCHICAL) {
+                // every leg, so the path reaches the end as a direct one does, and can be cached
+                response.result = hierarchical.run(request.start, request.end, request.dimensions,
+                                                   *map, std::numeric_limits<int>::max());
+            } else {
+                response.result = AStar::run(request.start, request.end, request.dimensions,
+                                             *map, AStar::Mode::JUMP_POINT);
+            }
+            response.elapsed = clock.getElapsedTime();
+        }
+
+        lock.lock();
+        if (running_.erase(ticket) > 0) {
+            responses_.emplace(ticket, std::move(response));
+        }
+    }
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <SFML/System/Time.hpp>
+#include <SFML/System/Vector2.hpp>
+
+#include "AI/A_star.hpp"
+#include "AI/hierarchical_pathfinder.hpp"
+#include "tile_map.hpp"
+
+/** \brief Resolves path requests on worker threads, off the frame.
+ *
+ * Agents submit() a request and get a ticket back, then collect() the result on a later frame. Each
+ * worker has its own AStar search state, and its own HierarchicalPathfinder, synced with the
+ * snapshot in the request, so nothing a search touches is shared with the main thread. The
+ * clearance and the cluster graphs are only synced again when a request brings a different
+ * snapshot, so searches over an unchanged map skip it. */
+class PathService
+{
+public:
+    using Ticket = std::size_t;
+
+    /** \brief How a request is searched. */
+    enum class Search
+    {
+        DIRECT,       ///< AStar::Mode::JUMP_POINT over the whole map
+        HIERARCHICAL, ///< over the cached cluster graph, each leg refined with JUMP_POINT
+    };
+
+    struct Request
+    {
+        sf::Vector2i start;      ///< TL (ie. min) corner of entity start position (Tile coordinates)
+        sf::Vector2i end;        ///< TL (ie. min) corner of entity end position (Tile coordinates)
+        sf::Vector2i dimensions; ///< <dx, dy> dimensions of the entity
+        sf::Vector2i ignore_min; ///< TL tile of the entity's own footprint, passable for the search
+        sf::Vector2i ignore_max; ///< BR tile of the entity's own footprint, inclusive
+        std::shared_ptr<const TileMap> map; ///< snapshot to search, never written to. Share it
+                                            ///< while the map is unchanged (see class doc)
+        Search search = Search::DIRECT;
+    };
+
+    struct Response
+    {
+        AStar::Result result;
+        sf::Time elapsed;        ///< spent searching, on the worker
+    };
+
+    /** \param[in] thread_count Number of worker threads, at least 1. */
+    explicit PathService(std::size_t thread_count = get_default_thread_count());
+
+    /** \brief Stops the workers, once their current searches finish. Pending requests are
+     * dropped. */
+    ~PathService();
+
+    PathService(const PathService&)    = delete;
+    void operator=(const PathService&) = delete;
+
+    /** \brief Queues the given request, to be picked up by the next free worker. */
+    Ticket submit(Request request);
+
+    /** \brief Takes the response for the given ticket, if it is ready.
+     *
+     * \return true iff the response was ready, and moved into response. */
+    bool collect(Ticket ticket, Response& response);
+
+    /** \brief Drops the request for the given ticket, whether it is queued, running, or ready. */
+    void cancel(Ticket ticket);
+
+    inline std::size_t get_thread_count() const { return workers_.size(); }
+
+    /** \return One worker per core, leaving one for the main thread, but at least 1. */
+    static std::size_t get_default_thread_count();
+
+private:
+    void work();
+
+    std::mutex mutex_;                          ///< guards everything below but workers_
+    std::condition_variable has_requests_;
+    std::deque<std::pair<Ticket, Request>> requests_;
+    std::unordered_set<Ticket> running_;        ///< dropped by cancel(), so the response is too
+    std::unordered_map<Ticket, Response> responses_;
+    Ticket next_ticket_;
+    bool is_stopping_;
+
+    std::vector<std::thread> workers_;          ///< started last, once the rest is set up
+};
@@ -0,0 +1,82 @@
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include "allocation_counter.hpp"
+
+// plain atomics, rather than statics of a function, so counting never allocates or takes a lock
+static std::atomic<std::size_t> allocation_count(0);
+static std::atomic<std::size_t> allocation_bytes(0);
+
+std::size_t
+AllocationCounter::get_count()
+{
+    return allocation_count.load(std::memory_order_relaxed);
+}
+
+std::size_t
+AllocationCounter::get_bytes()
+{
+    return allocation_bytes.load(std::memory_order_relaxed);
+}
+
+static void*
+counted_allocate(std::size_t size) noexcept
+{
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    allocation_bytes.fetch_add(size, std::memory_order_relaxed);
+
+    return std::malloc(size > 0 ? size : 1);
+}
+
+void*
+operator new(std::size_t size)
+{
+    auto* allocation = counted_allocate(size);
+    if (allocation == nullptr) {
+        throw std::bad_alloc();
+    }
+    return allocation;
+}
+
+void*
+operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void*
+operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    return counted_allocate(size);
+}
+
+void*
+operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    return counted_allocate(size);
+}
+
+void
+operator delete(void* allocation) noexcept
+{
+    std::free(allocation);
+}
+
+void
+operator delete[](void* allocation) noexcept
+{
+    std::free(allocation);
+}
+
+void
+operator delete(void* allocation, std::size_t) noexcept
+{
+    std::free(allocation);
+}
+
+void
+operator delete[](void* allocation, std::size_t) noexcept
+{
+    std::free(allocation);
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstddef>
+
+/** \brief Counts the heap allocations made through the global operator new, on every thread.
+ *
+ * allocation_counter.cpp replaces the global operator new and delete to do the counting, so it is
+ * only linked into executables which measure allocations, never into the game itself. */
+class AllocationCounter
+{
+public:
+    /** \return Number of allocations made, since the program started. */
+    static std::size_t get_count();
+
+    /** \return Total bytes asked for by those allocations. */
+    static std::size_t get_bytes();
+};
@@ -8,7 +8,7 @@ Barrier::Barrier()
     auto* physics = add_component<Physics>();
     physics->set_static(true);
 
-    set_component<Graphics>(std::make_unique<Graphics>(*this, *this));
+    emplace_component<Graphics>(*this);
 }
 
 sf::Time
@@ -17,19 +17,11 @@ Barrier::update(sf::Time elapsed)
     return elapsed;
 }
 
-const Renderer::Renderings
-Barrier::render()
+void
+Barrier::render(Renderings& renderings)
 {
     auto* physics = get_component<Physics>();
 
-    graphic_.setSize(physics->get_dimensions());
-    graphic_.setOrigin(physics->get_extents());
-    graphic_.setPosition(util::pixelate(physics->get_position()));
-    graphic_.setFillColor(sf::Color::Black);
-
-    Renderings renderings;
-    renderings.reserve(1);
-    renderings.push_back(&graphic_);
-
-    return std::move(renderings);
+    renderings.push_back(Rendering::rectangle(util::pixelate(physics->get_position()),
+                                              physics->get_dimensions(), sf::Color::Black));
 }
@@ -1,7 +1,5 @@
 #pragma once
 
-#include <SFML/Graphics/RectangleShape.hpp>
-
 #include "entity.hpp"
 #include "components/graphics.hpp"
 
@@ -13,8 +11,5 @@ public:
     virtual ~Barrier() = default;
 
     sf::Time update(sf::Time elapsed) override;
-    const Renderings render() override;
-
-private:
-    sf::RectangleShape graphic_;
+    void render(Renderings& renderings) override;
 };
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "AABB.hpp"
+#include "entity.hpp"
+
+/** \brief Interface for the broad phase collision engines.
+ *
+ * A broad phase indexes the entities with physics, so clients can find the few entities which may
+ * collide with a given box without testing against every entity in the game.
+ *
+ * Queries may return false positives, but never false negatives for entities whose positions are
+ * up to date in the broad phase. Clients are expected to follow up with Collision::broad_test()
+ * and Collision::narrow_test(). */
+class BroadPhaseIF
+{
+public:
+    using Entities   = std::vector<std::unique_ptr<Entity>>;
+    using Candidates = std::vector<Entity*>;
+
+    BroadPhaseIF() = default;
+    virtual ~BroadPhaseIF() = default;
+
+    /** \brief Removes all entities, keeping the allocated storage for the next rebuild. */
+    virtual void clear() = 0;
+
+    /** \brief Indexes the given entities at their current positions.
+     *
+     * Entities without a Physics component are skipped. Entities are returned from query() in the
+     * order they are given here. */
+    virtual void rebuild(const Entities& entities) = 0;
+
+    /** \brief Moves the given entity to its current position.
+     *
+     * Has no effect for entities which were not part of the last rebuild(). */
+    virtual void update(const Entity& entity) = 0;
+
+    /** \brief Collects the entities which may overlap the state space of the given box.
+     *
+     * Candidates are appended in rebuild() order, without duplicates. */
+    virtual void query(const AABB& box, Candidates& candidates) const = 0;
+
+    /** \return The number of entities indexed. */
+    virtual std::size_t size() const = 0;
+};
@@ -17,7 +17,7 @@ Bullet::Bullet()
     physics->set_static(true);
     physics->set_move_speed(SPEED);
 
-    set_component<Graphics>(std::make_unique<Graphics>(*this, *this));
+    emplace_component<Graphics>(*this);
 }
 
 void
@@ -30,27 +30,27 @@ Bullet::fire()
     physics->set_static(false);
 }
 
+void
+Bullet::refresh(sf::Time frame_length)
+{
+    get_component<AI>()->refresh(frame_length);
+}
+
 sf::Time
 Bullet::update(sf::Time elapsed)
 {
     return get_component<AI>()->update(elapsed);
 }
 
-const Renderer::Renderings
-Bullet::render()
+void
+Bullet::render(Renderings& renderings)
 {
     auto* physics = get_component<Physics>();
+    const float alpha = Game::instance().get_interpolation();
 
-    graphic_.setRadius(physics->get_extents().x);
-    graphic_.setOrigin(physics->get_extents());
-    graphic_.setPosition(util::pixelate(physics->get_position()));
-    graphic_.setFillColor(sf::Color::Red);
-
-    Renderings renderings;
-    renderings.reserve(1);
-    renderings.push_back(&graphic_);
-
-    return std::move(renderings);
+    renderings.push_back(Rendering::circle(
+        util::pixelate(physics->get_interpolated_position(alpha)), physics->get_extents().x,
+        sf::Color::Red));
 }
 
 void
@@ -61,6 +61,16 @@ Bullet::apply_damage(const Entity& entity)
     }
 }
 
+void
+Bullet::reset()
+{
+    set_alive(true);
+
+    auto* physics = get_component<Physics>();
+    physics->set_velocity({0.f, 0.f});
+    physics->set_static(true);
+}
+
 Projectile*
 BulletAmmunition::create_projectile()
 {
@@ -68,12 +78,32 @@ BulletAmmunition::create_projectile()
         is_firing_ = true;
         firing_pin_->restart();
 
-        return new Bullet;
+        if (spares_.empty()) {
+            return new Bullet;
+        }
+
+        auto* bullet = spares_.back().release();
+        spares_.pop_back();
+        return bullet;
     }
 
     return nullptr;
 }
 
+void
+BulletAmmunition::recycle(Projectile* projectile)
+{
+    // other projectiles may be given back after the gun's ammunition is changed
+    auto* bullet = dynamic_cast<Bullet*>(projectile);
+    if (!bullet) {
+        delete projectile;
+        return;
+    }
+
+    bullet->reset();
+    spares_.emplace_back(bullet);
+}
+
 void
 BulletAmmunition::reload()
 {
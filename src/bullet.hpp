@@ -1,6 +1,6 @@
 #pragma once
 
-#include <SFML/Graphics/CircleShape.hpp>
+#include <vector>
 
 #include "clock.hpp"
 #include "projectile.hpp"
@@ -17,35 +17,44 @@ public:
     virtual ~Bullet() = default;
 
     void fire() override;
+    void refresh(sf::Time frame_length) override;
     sf::Time update(sf::Time elapsed) override;
-    const Renderings render() override;
+    void render(Renderings& renderings) override;
 
     void apply_damage(const Entity& entity);
 
-private:
-    sf::CircleShape graphic_;
+    /** \brief Readies a dead bullet to be fired again, alive and still, keeping its components. */
+    void reset();
 };
 
 /** \brief Ammunition Factory for bullets.
  *
- * Limits the firing of bullets. */
+ * Limits the firing of bullets, on simulated time. Bullets given back to recycle() are kept, and handed out again
+ * before any new bullet is made, so sustained fire reuses the bullets (and their components) of
+ * the shots which came before it, rather than allocating. */
 class BulletAmmunition : public Ammunition
 {
 public:
     static constexpr float FIRE_RATE = 5.f; ///< Bullets/Second
 
     BulletAmmunition() :
-        BulletAmmunition(std::make_unique<Clock>())
+        BulletAmmunition(std::make_unique<SimulationClock>())
     { }
     virtual ~BulletAmmunition() = default;
 
     Projectile* create_projectile() override;
+    void recycle(Projectile* projectile) override;
     void reload() override;
 
+    /** \return Number of bullets kept, to be handed out before any new bullet is made. */
+    inline std::size_t get_spare_count() const { return spares_.size(); }
+
 private:
     bool is_firing_; ///< With firing_pin_, limits the firing rate
     std::unique_ptr<ClockIF> firing_pin_; ///< with is_firing_, limits the firing rate
 
+    std::vector<std::unique_ptr<Bullet>> spares_; ///< Recycled, and reset ready to fire
+
 /// Test Methods
 private:
     friend class TestableBulletAmmunition;
@@ -0,0 +1,22 @@
+#include "clock.hpp"
+
+#include "game.hpp"
+
+SimulationClock::SimulationClock() :
+    start_(Game::instance().get_simulated_time())
+{ }
+
+sf::Time
+SimulationClock::getElapsedTime() const
+{
+    return Game::instance().get_simulated_time() - start_;
+}
+
+sf::Time
+SimulationClock::restart()
+{
+    const auto now = Game::instance().get_simulated_time();
+    const auto elapsed = now - start_;
+    start_ = now;
+    return elapsed;
+}
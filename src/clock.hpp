@@ -30,3 +30,20 @@ public:
 private:
     sf::Clock clock_;
 };
+
+/** \brief Clock of the simulated time, see Game::get_simulated_time().
+ *
+ * Only moves as the Simulation steps, by the same amount at any frame rate, so whatever is timed on
+ * it plays out the same way on every run. */
+class SimulationClock : public ClockIF
+{
+public:
+    SimulationClock();
+    virtual ~SimulationClock() = default;
+
+    sf::Time getElapsedTime() const override;
+    sf::Time restart() override;
+
+private:
+    sf::Time start_; ///< simulated time of construction or the last restart()
+};
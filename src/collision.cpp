@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <cmath>
 #include <limits>
 
@@ -100,3 +101,41 @@ Collision::get_penetration(const AABB& first, const AABB& second)
 
     return sf::Vector2f(0.f, near.y);
 }
+
+float
+Collision::ray_cast(sf::Vector2f origin, sf::Vector2f ray, const AABB& box)
+{
+    const auto min = box.get_min_corner();
+    const auto max = box.get_max_corner();
+
+    // slab test: the ray is inside the box while it is between both pairs of sides
+    float entry = -std::numeric_limits<float>::infinity();
+    float exit = std::numeric_limits<float>::infinity();
+
+    const float origins[] = {origin.x, origin.y};
+    const float rays[] = {ray.x, ray.y};
+    const float mins[] = {min.x, min.y};
+    const float maxes[] = {max.x, max.y};
+    for (int axis = 0; axis < 2; ++axis) {
+        if (rays[axis] == 0.f) {
+            if (origins[axis] < mins[axis] || origins[axis] > maxes[axis]) {
+                return 1.f;
+            }
+            continue;
+        }
+
+        float near = (mins[axis] - origins[axis]) / rays[axis];
+        float far = (maxes[axis] - origins[axis]) / rays[axis];
+        if (near > far) {
+            std::swap(near, far);
+        }
+        entry = std::max(entry, near);
+        exit = std::min(exit, far);
+    }
+
+    if (entry > exit || entry >= 1.f || exit <= 0.f) {
+        return 1.f;
+    }
+
+    return std::max(entry, 0.f);
+}
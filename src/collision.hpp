@@ -49,6 +49,15 @@ public:
      * \return Penetration of "first" into "second" iff narrow_test() returns 0.f. */
     static sf::Vector2f get_penetration(const AABB& first, const AABB& second);
 
+    /** \brief Casts a ray against a still AABB, ignoring its trajectory.
+     *
+     * A cheaper stand-in for broad_test() and narrow_test() with a moving point, which a small
+     * moving box can be cast as by growing the still box by its dimensions.
+     *
+     * \return Percentage of the ray until it enters the box, in range [0.f, 1.f], 0.f if the origin
+     *         is already inside, or 1.f if it misses. */
+    static float ray_cast(sf::Vector2f origin, sf::Vector2f ray, const AABB& box);
+
 private:
     static const sf::Vector2f ORIGIN; ///< Origin is <0, 0>
 };
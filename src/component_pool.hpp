@@ -0,0 +1,130 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include "components/component.hpp"
+
+/** \brief Entities are identified by a small integer, used to index the component pools.
+ *
+ * Ids of destroyed entities are recycled, which keeps the pools densely packed. */
+using EntityId = std::size_t;
+
+/** \brief Hands out the ids for live entities. */
+class EntityIds
+{
+public:
+    EntityIds() = delete;
+
+    /** \brief Returns an id not used by any other live entity, preferring recycled ids. */
+    static EntityId acquire();
+
+    /** \brief Returns the given id to the pool, to be reused by the next acquire(). */
+    static void release(EntityId id);
+
+private:
+    static std::vector<EntityId>& free_ids();
+    static EntityId& next_id();
+};
+
+/** \brief Type-erased base class for the per-type component pools.
+ *
+ * Every pool registers itself on construction, so an entity can be removed from all of them
+ * without knowing which component types it was given. */
+class ComponentPoolBase
+{
+public:
+    ComponentPoolBase(const ComponentPoolBase&) = delete;
+    void operator=(const ComponentPoolBase&)    = delete;
+
+    virtual ~ComponentPoolBase() = default;
+
+    /** \brief Destroys the component for the given entity, if it has one. */
+    virtual void remove(EntityId id) = 0;
+
+    /** \brief Destroys the components for the given entity, in every pool. */
+    static void remove_all(EntityId id);
+
+protected:
+    ComponentPoolBase() { registry().push_back(this); }
+
+private:
+    static std::vector<ComponentPoolBase*>& registry();
+};
+
+/** \brief Storage for all of the components of type T, indexed by entity id.
+ *
+ * Lookup is a single index into a dense table of pointers, one entry per entity id. Components
+ * built by emplace() are constructed in place in chunks of storage owned by the pool, so adding
+ * a component does not touch the allocator once the pool has warmed up. Chunks are never moved,
+ * so the pointers handed out stay valid until the component is removed or replaced.
+ *
+ * Components of a derived type (eg. an AIEnemy stored as the AI) do not fit in the storage for
+ * T, and are instead adopted from the heap via adopt().
+ *
+ * The pools are not thread-safe. Lookups may run concurrently, but adding or removing components
+ * must be done from one thread at a time. */
+template<class T>
+class ComponentPool : public ComponentPoolBase
+{
+public:
+    static constexpr std::size_t CHUNK_SIZE = 64; ///< Number of components allocated at once
+
+    /** \brief Returns the pool for component type T.
+     *
+     * The pool is intentionally never destroyed, so entities which outlive static destruction
+     * (eg. those owned by the Game singleton) can still release their components. */
+    static ComponentPool& instance();
+
+    /** \return The component for the given entity, or nullptr if it doesn't have one. */
+    inline T* get(EntityId id) const { return id < slots_.size() ? slots_[id].component : nullptr; }
+
+    /** \brief Constructs a new T in pool storage for the given entity.
+     *
+     * Any existing component for the entity is replaced, after the new one is constructed.
+     *
+     * \return The newly constructed component. */
+    template<class... Args> T* emplace(EntityId id, Args&&... args);
+
+    /** \brief Takes ownership of the given component for the given entity.
+     *
+     * Any existing component for the entity is replaced. Adopting a nullptr removes the component.
+     *
+     * \return The adopted component. */
+    T* adopt(EntityId id, std::unique_ptr<Component> component);
+
+    void remove(EntityId id) override;
+
+    /** \return The number of entities with a component in this pool. */
+    inline std::size_t size() const { return size_; }
+
+    /** \return The number of components which can be emplaced before the pool allocates. */
+    inline std::size_t available() const { return free_.size(); }
+
+private:
+    using Storage = typename std::aligned_storage<sizeof(T), alignof(T)>::type;
+
+    struct Slot
+    {
+        T* component;     ///< The component for this entity id, or nullptr
+        Storage* storage; ///< Where the component was emplaced, or nullptr if it was adopted
+    };
+
+    ComponentPool() :
+        size_(0)
+    { }
+
+    /** \brief Sets the slot for the given id, destroying the component it replaces. */
+    void assign(EntityId id, Slot slot);
+
+    Storage* allocate();
+
+    std::vector<Slot> slots_;                        ///< Indexed by entity id
+    std::vector<std::unique_ptr<Storage[]>> chunks_; ///< Backing storage for emplaced components
+    std::vector<Storage*> free_;                     ///< Unused storage in chunks_
+    std::size_t size_;                               ///< Number of non-null slots
+};
+
+#include "component_pool.inl"
@@ -0,0 +1,137 @@
+/** \brief Definitions for the inline and templated functions declared in component_pool.hpp. */
+
+inline EntityId
+EntityIds::acquire()
+{
+    auto& free = free_ids();
+    if (free.empty()) {
+        return next_id()++;
+    }
+
+    auto id = free.back();
+    free.pop_back();
+    return id;
+}
+
+inline void
+EntityIds::release(EntityId id)
+{
+    free_ids().push_back(id);
+}
+
+inline std::vector<EntityId>&
+EntityIds::free_ids()
+{
+    static auto* free_ids = new std::vector<EntityId>();
+    return *free_ids;
+}
+
+inline EntityId&
+EntityIds::next_id()
+{
+    static EntityId next_id = 0;
+    return next_id;
+}
+
+inline void
+ComponentPoolBase::remove_all(EntityId id)
+{
+    for(auto* pool : registry()) {
+        pool->remove(id);
+    }
+}
+
+inline std::vector<ComponentPoolBase*>&
+ComponentPoolBase::registry()
+{
+    static auto* registry = new std::vector<ComponentPoolBase*>();
+    return *registry;
+}
+
+template<class T>
+ComponentPool<T>&
+ComponentPool<T>::instance()
+{
+    static auto* pool = new ComponentPool<T>();
+    return *pool;
+}
+
+template<class T>
+template<class... Args>
+T*
+ComponentPool<T>::emplace(EntityId id, Args&&... args)
+{
+    auto* storage = allocate();
+
+    T* component;
+    try {
+        component = new (storage) T(std::forward<Args>(args)...);
+    } catch (...) {
+        free_.push_back(storage);
+        throw;
+    }
+
+    assign(id, Slot{component, storage});
+    return component;
+}
+
+template<class T>
+T*
+ComponentPool<T>::adopt(EntityId id, std::unique_ptr<Component> component)
+{
+    auto* adopted = static_cast<T*>(component.release());
+    assign(id, Slot{adopted, nullptr});
+    return adopted;
+}
+
+template<class T>
+void
+ComponentPool<T>::remove(EntityId id)
+{
+    if (id < slots_.size()) {
+        assign(id, Slot{nullptr, nullptr});
+    }
+}
+
+template<class T>
+void
+ComponentPool<T>::assign(EntityId id, Slot slot)
+{
+    if (id >= slots_.size()) {
+        slots_.resize(id + 1, Slot{nullptr, nullptr});
+    }
+
+    auto old = slots_[id];
+    slots_[id] = slot;
+
+    if (slot.component) { ++size_; }
+    if (!old.component) { return; }
+    --size_;
+
+    if (old.storage) {
+        old.component->~T();
+        free_.push_back(old.storage);
+    } else {
+        delete old.component;
+    }
+}
+
+template<class T>
+typename ComponentPool<T>::Storage*
+ComponentPool<T>::allocate()
+{
+    if (free_.empty()) {
+        chunks_.emplace_back(new Storage[CHUNK_SIZE]);
+        auto* chunk = chunks_.back().get();
+
+        // hand out the chunk front to back, so neighboring ids tend to be neighbors in memory
+        free_.reserve(free_.size() + CHUNK_SIZE);
+        for (std::size_t ndx = CHUNK_SIZE; ndx > 0; --ndx) {
+            free_.push_back(&chunk[ndx - 1]);
+        }
+    }
+
+    auto* storage = free_.back();
+    free_.pop_back();
+    return storage;
+}
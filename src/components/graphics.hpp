@@ -1,22 +1,58 @@
 #pragma once
 
-#include <SFML/Graphics/Drawable.hpp>
+#include <vector>
+
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/System/Vector2.hpp>
 
 #include "component.hpp"
 
+/** \brief A filled shape to draw to screen, described by value so that any number of them can be
+ * batched into a few draw calls (see ShapeBatch). */
+struct Rendering
+{
+    enum class Shape
+    {
+        RECTANGLE,
+        CIRCLE
+    };
+
+    Shape shape;
+    sf::Vector2f position;   ///< of the center, in pixels
+    sf::Vector2f dimensions; ///< <dx, dy> of the bounds, a circle's are both its diameter
+    sf::Color fill_color;
+    float outline_thickness; ///< of a rectangle, as for sf::Shape: < 0 inwards, 0 for none
+    sf::Color outline_color;
+
+    static Rendering rectangle(sf::Vector2f position, sf::Vector2f dimensions, sf::Color fill_color,
+                               float outline_thickness = 0.f,
+                               sf::Color outline_color = sf::Color::Black)
+    {
+        return Rendering{Shape::RECTANGLE, position, dimensions, fill_color, outline_thickness,
+                         outline_color};
+    }
+
+    static Rendering circle(sf::Vector2f position, float radius, sf::Color fill_color)
+    {
+        return Rendering{Shape::CIRCLE, position, sf::Vector2f(2.f * radius, 2.f * radius),
+                         fill_color, 0.f, sf::Color::Black};
+    }
+};
+
 /** \brief Interface for classes which handle rendering. */
 class Renderer
 {
 public:
-    using Renderings = std::vector<const sf::Drawable*>;
+    using Renderings = std::vector<Rendering>;
 
     Renderer() = default;
     virtual ~Renderer() = default;
 
-    /** \brief Returns a collection of the renderings to draw to screen.
+    /** \brief Appends the renderings to draw to screen, back to front.
      *
-     * Returned renderings should conform to the rules for sf::Draw(). */
-    virtual const Renderings render() = 0;
+     * The collection is owned by the caller, and reused from frame to frame so that collecting the
+     * renderings allocates nothing once it has grown large enough. Renderers must only append. */
+    virtual void render(Renderings& renderings) = 0;
 };
 
 /** \brief Entities which have a Graphics component draw things to the screen.
@@ -41,7 +77,7 @@ public:
      *
      * The renderer is initialized on construction, and is usally the same as the entity this
      * Graphics Component is for. */
-    const Renderings render() { return renderer_.render(); };
+    void render(Renderings& renderings) { renderer_.render(renderings); };
 
 private:
     Renderer& renderer_;
@@ -19,10 +19,20 @@ public:
     /** \brief Moves by velocity for given dt if not static. */
     inline void update(float dt) { if (!is_static_) move(velocity_ * dt); }
 
-    inline void set_position(sf::Vector2f position) { position_ = position; }
+    /** \brief Places the entity, without interpolating from where it was. */
+    inline void set_position(sf::Vector2f position) { position_ = previous_position_ = position; }
     inline void move(sf::Vector2f distance) { position_ += distance; }
     inline sf::Vector2f get_position() const { return position_; }
 
+    /** \brief Remembers the current position, as the start of the next simulation step. */
+    inline void save_position() { previous_position_ = position_; }
+
+    /** \brief Position part way through the last simulation step, for rendering between steps.
+     *
+     * \param[in] alpha Fraction of the step, from 0 (where it started) to 1 (where it is now). */
+    inline sf::Vector2f get_interpolated_position(float alpha) const
+    { return previous_position_ + (position_ - previous_position_) * alpha; }
+
     inline void set_velocity(sf::Vector2f velocity) { velocity_ = velocity; }
     inline sf::Vector2f get_velocity() const { return velocity_; }
 
@@ -55,6 +65,7 @@ public:
 
 private:
     sf::Vector2f position_; ///< Current <x, y> position
+    sf::Vector2f previous_position_; ///< <x, y> position at the start of the last step
     sf::Vector2f velocity_; ///< Current <vx, vy> velocity
     float move_speed_;      ///< Magnitude of velocity
 
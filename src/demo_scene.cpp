@@ -0,0 +1,106 @@
+#include "demo_scene.hpp"
+
+#include "barrier.hpp"
+#include "bullet.hpp"
+#include "game.hpp"
+#include "components/health.hpp"
+#include "components/physics.hpp"
+
+constexpr auto WINDOW_WIDTH  = Game::WINDOW_WIDTH;
+constexpr auto WINDOW_HEIGHT = Game::WINDOW_WIDTH;
+
+DemoScene
+DemoScene::build()
+{
+    auto& game = Game::instance();
+
+    auto& player = *game.add_player();
+    player.get_component<Physics>()->set_position(sf::Vector2f(WINDOW_WIDTH, WINDOW_HEIGHT)/2.f);
+
+    game.entity_collection().push_back(std::make_unique<Gun>(player));
+    Gun& gun = static_cast<Gun&>(*game.entity_collection().back().get());
+    gun.set_ammunition(std::make_unique<BulletAmmunition>());
+
+    std::vector<Barrier*> barriers(6); ///< top, left, bottom, right
+    for(auto& barrier : barriers) {
+        barrier = new Barrier();
+        game.entity_collection().emplace_back(barrier);
+    }
+
+    float border_thickness = 20.f;
+    barriers[0]->get_component<Physics>()->set_position({WINDOW_WIDTH/2.f, border_thickness/2.f});
+    barriers[0]->get_component<Physics>()->set_dimensions({WINDOW_WIDTH, border_thickness});
+    barriers[1]->get_component<Physics>()->set_position({border_thickness/2.f, WINDOW_HEIGHT/2.f});
+    barriers[1]->get_component<Physics>()->set_dimensions({border_thickness, WINDOW_HEIGHT});
+    barriers[2]->get_component<Physics>()->set_position({WINDOW_WIDTH/2.f, WINDOW_HEIGHT - border_thickness/2.f});
+    barriers[2]->get_component<Physics>()->set_dimensions({WINDOW_WIDTH, border_thickness});
+    barriers[3]->get_component<Physics>()->set_position({WINDOW_WIDTH - border_thickness/2.f, WINDOW_HEIGHT/2.f});
+    barriers[3]->get_component<Physics>()->set_dimensions({border_thickness, WINDOW_HEIGHT});
+
+    barriers[4]->get_component<Physics>()->set_position({WINDOW_WIDTH/2.f, 3.f*WINDOW_HEIGHT/8.f});
+    barriers[4]->get_component<Physics>()->set_dimensions({WINDOW_WIDTH/2.f, border_thickness});
+    barriers[5]->get_component<Physics>()->set_position({3.f*WINDOW_WIDTH/8.f, WINDOW_HEIGHT/2.f});
+    barriers[5]->get_component<Physics>()->set_dimensions({border_thickness, WINDOW_HEIGHT/2.f});
+    /* barriers[5]->get_component<Physics>()->set_position({border_thickness/2.f, WINDOW_HEIGHT/2.f}); */
+    /* barriers[5]->get_component<Physics>()->set_dimensions({border_thickness, WINDOW_HEIGHT}); */
+    /* barriers[6]->get_component<Physics>()->set_position({WINDOW_WIDTH/2.f, WINDOW_HEIGHT - border_thickness/2.f}); */
+    /* barriers[6]->get_component<Physics>()->set_dimensions({WINDOW_WIDTH, border_thickness}); */
+    /* barriers[7]->get_component<Physics>()->set_position({WINDOW_WIDTH - border_thickness/2.f, WINDOW_HEIGHT/2.f}); */
+    /* barriers[7]->get_component<Physics>()->set_dimensions({border_thickness, WINDOW_HEIGHT}); */
+
+    barriers.clear();
+
+    std::vector<Enemy*> enemies(24);
+    int ndx = 0;
+    for(auto& enemy : enemies) {
+        enemy = new Enemy();
+        enemy->get_component<Health>()->set_health(15.f);
+
+        auto* physics = enemy->get_component<Physics>();
+        if (ndx++ <= 3) {
+            physics->set_dimensions(physics->get_dimensions() * 1.5f);
+        } else {
+            physics->set_move_speed(physics->get_move_speed() * 0.5f);
+        }
+
+        game.entity_collection().emplace_back(enemy);
+    }
+
+
+    sf::Vector2f zero_offset = {border_thickness + enemies[0]->get_component<Physics>()->get_extents().x,
+                                border_thickness + enemies[0]->get_component<Physics>()->get_extents().y};
+    enemies[0]->get_component<Physics>()->set_position({zero_offset.x, zero_offset.y});
+    enemies[1]->get_component<Physics>()->set_position({zero_offset.x, WINDOW_HEIGHT - zero_offset.y});
+    enemies[2]->get_component<Physics>()->set_position({WINDOW_WIDTH - zero_offset.x, WINDOW_HEIGHT - zero_offset.y});
+    enemies[3]->get_component<Physics>()->set_position({WINDOW_WIDTH - zero_offset.x, zero_offset.y});
+
+    zero_offset = {WINDOW_WIDTH/2.f, WINDOW_HEIGHT/4.f};
+    enemies[4]->get_component<Physics>()->set_position({zero_offset.x - WINDOW_WIDTH/16.f, zero_offset.y});
+    enemies[5]->get_component<Physics>()->set_position({zero_offset.x - WINDOW_WIDTH/8.f, zero_offset.y});
+    enemies[6]->get_component<Physics>()->set_position({zero_offset.x, zero_offset.y});
+    enemies[7]->get_component<Physics>()->set_position({zero_offset.x + WINDOW_WIDTH/8.f, zero_offset.y});
+    enemies[8]->get_component<Physics>()->set_position({zero_offset.x + WINDOW_WIDTH/16.f, zero_offset.y});
+
+    zero_offset = {WINDOW_WIDTH/4.f, WINDOW_HEIGHT/2.f};
+    enemies[9]->get_component<Physics>()->set_position({zero_offset.x, zero_offset.y - WINDOW_HEIGHT/16.f});
+    enemies[10]->get_component<Physics>()->set_position({zero_offset.x, zero_offset.y - WINDOW_HEIGHT/8.f});
+    enemies[11]->get_component<Physics>()->set_position({zero_offset.x, zero_offset.y});
+    enemies[12]->get_component<Physics>()->set_position({zero_offset.x, zero_offset.y + WINDOW_HEIGHT/8.f});
+    enemies[13]->get_component<Physics>()->set_position({zero_offset.x, zero_offset.y + WINDOW_HEIGHT/16.f});
+
+    zero_offset = {WINDOW_WIDTH/2.f, WINDOW_HEIGHT*3.f/4.f};
+    enemies[14]->get_component<Physics>()->set_position({zero_offset.x - WINDOW_WIDTH/16.f, zero_offset.y});
+    enemies[15]->get_component<Physics>()->set_position({zero_offset.x - WINDOW_WIDTH/8.f, zero_offset.y});
+    enemies[16]->get_component<Physics>()->set_position({zero_offset.x, zero_offset.y});
+    enemies[17]->get_component<Physics>()->set_position({zero_offset.x + WINDOW_WIDTH/8.f, zero_offset.y});
+    enemies[18]->get_component<Physics>()->set_position({zero_offset.x + WINDOW_WIDTH/16.f, zero_offset.y});
+
+    zero_offset = {WINDOW_WIDTH*3.f/4.f, WINDOW_HEIGHT/2.f};
+    enemies[19]->get_component<Physics>()->set_position({zero_offset.x, zero_offset.y - WINDOW_HEIGHT/16.f});
+    enemies[20]->get_component<Physics>()->set_position({zero_offset.x, zero_offset.y - WINDOW_HEIGHT/8.f});
+    enemies[21]->get_component<Physics>()->set_position({zero_offset.x, zero_offset.y});
+    enemies[22]->get_component<Physics>()->set_position({zero_offset.x, zero_offset.y + WINDOW_HEIGHT/8.f});
+    enemies[23]->get_component<Physics>()->set_position({zero_offset.x, zero_offset.y + WINDOW_HEIGHT/16.f});
+
+    return DemoScene{&player, &gun, enemies[4]};
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+#include "enemy.hpp"
+#include "gun.hpp"
+#include "player.hpp"
+
+/** \brief The player, the walls and the enemies of the demo, shared by every executable.
+ *
+ * The entities are owned by the Game. */
+struct DemoScene
+{
+    Player* player;
+    Gun* gun;
+    Enemy* enemy_example; ///< One enemy of the crowd, to follow while debugging
+
+    /** \brief Adds the scene's entities to the Game. */
+    static DemoScene build();
+};
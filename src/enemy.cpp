@@ -3,6 +3,7 @@
 #include "AI/AI_enemy.hpp"
 #include "components/health.hpp"
 #include "components/physics.hpp"
+#include "game.hpp"
 #include "utils.hpp"
 
 Enemy::Enemy()
@@ -13,7 +14,7 @@ Enemy::Enemy()
     physics->set_dimensions({40.f, 40.f});
     physics->set_move_speed(SPEED);
 
-    auto* graphics = set_component<Graphics>(std::make_unique<Graphics>(*this, *this));
+    auto* graphics = emplace_component<Graphics>(*this);
 
     add_component<Health>();
 }
@@ -36,21 +37,13 @@ Enemy::flush()
     get_component<Health>()->update();
 }
 
-const Graphics::Renderings
-Enemy::render()
+void
+Enemy::render(Renderings& renderings)
 {
     auto* physics = get_component<Physics>();
+    const float alpha = Game::instance().get_interpolation();
 
-    graphic_.setSize(physics->get_dimensions());
-    graphic_.setOrigin(physics->get_extents());
-    graphic_.setPosition(util::pixelate(physics->get_position()));
-    graphic_.setFillColor(sf::Color::Green);
-    graphic_.setOutlineThickness(-1.f);
-    graphic_.setOutlineColor(sf::Color::Black);
-
-    Renderings renderings;
-    renderings.reserve(1);
-    renderings.push_back(&graphic_);
-
-    return std::move(renderings);
+    renderings.push_back(Rendering::rectangle(
+        util::pixelate(physics->get_interpolated_position(alpha)), physics->get_dimensions(),
+        sf::Color::Green, -1.f, sf::Color::Black));
 }
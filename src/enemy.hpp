@@ -1,7 +1,5 @@
 #pragma once
 
-#include <SFML/Graphics/RectangleShape.hpp>
-
 #include "entity.hpp"
 #include "components/graphics.hpp"
 #include "components/AI.hpp"
@@ -21,8 +19,5 @@ public:
     sf::Time update(sf::Time elapsed) override;
     void flush() override;
 
-    const Renderings render() override;
-
-private:
-    sf::RectangleShape graphic_;
+    void render(Renderings& renderings) override;
 };
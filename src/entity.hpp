@@ -1,22 +1,30 @@
 #pragma once
 
 #include <memory>
-#include <typeindex>
-#include <unordered_map>
 
 #include <SFML/System/Time.hpp>
 
+#include "component_pool.hpp"
 #include "components/component.hpp"
 
-/** \brief An Entitiy is a container class for components. */
+/** \brief An Entitiy is a container class for components.
+ *
+ * The components themselves live in the per-type ComponentPool, indexed by this entity's id. */
 class Entity {
 public:
-    using ComponentMap = std::unordered_map<std::type_index, std::unique_ptr<Component>>;
-
     Entity() :
+        id_(EntityIds::acquire()),
         is_alive_(true)
     { }
-    virtual ~Entity() = default;
+
+    Entity(const Entity&)        = delete;
+    void operator=(const Entity&) = delete;
+
+    virtual ~Entity()
+    {
+        ComponentPoolBase::remove_all(id_);
+        EntityIds::release(id_);
+    }
 
     virtual void prepare() { return; }
 
@@ -68,10 +76,20 @@ public:
      * \return The newly constructed component. */
     template<class T> T* add_component();
 
+    /** \brief Constructs a new component for this entity, in place in the component pool.
+     *
+     * The component is constructed with a reference to this entity, followed by the given args.
+     * If the component already exists, it is replaced unambiguously with the newly constructed one.
+     *
+     * \return The newly constructed component. */
+    template<class T, class... Args> T* emplace_component(Args&&... args);
+
     /** \brief Sets the given component type.
      *
-     * Necessary when the component has non-trivial construction requirements. If the component
-     * already exists, it is replaced unambiguously with the given component.
+     * Necessary when the component is a subclass of T (eg. an AIEnemy set as the AI). The given
+     * component is adopted by the pool, rather than stored in place, so prefer emplace_component()
+     * where possible. If the component already exists, it is replaced unambiguously with the given
+     * component.
      *
      * \return The newly set component. */
     template<class T> T* set_component(std::unique_ptr<Component> component);
@@ -83,13 +101,16 @@ public:
      * \return The given component for this entity, or nullptr if it doesn't have one. */
     template<class T> T* get_component() const;
 
+    /** \brief Unique among live entities, but recycled once this entity is destroyed. */
+    inline EntityId get_id() const { return id_; }
+
     inline void set_alive(bool is_alive) { is_alive_ = is_alive; }
     inline void kill() { is_alive_ = false; }
     inline bool is_alive() const { return is_alive_; }
     inline bool is_dead() const { return !is_alive_; }
 
 private:
-    ComponentMap components_; ///< Map of the components for this entity
+    const EntityId id_; ///< Index of this entity's components in each ComponentPool
 
     bool is_alive_; ///< "Dead" entities are eventually removed from the game
 };
@@ -3,28 +3,29 @@
 /** \brief Compile-Time assert that T is derived from Component. */
 template<class T> constexpr void check_T();
 
-/** \brief Checks if the given T has a value set in the map. */
-template<class T> bool exists_in_map(const Entity::ComponentMap& map);
-
-/** \brief Maps from type T to a unique Key for the map. */
-template<class T> const Entity::ComponentMap::key_type key_from_T();
-
 template<class T>
 bool
 Entity::has_component() const
 {
     check_T<T>();
 
-    return exists_in_map<T>(components_) && components_.at(key_from_T<T>());
+    return ComponentPool<T>::instance().get(id_) != nullptr;
 }
 
 template<class T>
 T*
 Entity::add_component()
+{
+    return emplace_component<T>();
+}
+
+template<class T, class... Args>
+T*
+Entity::emplace_component(Args&&... args)
 {
     check_T<T>();
 
-    return set_component<T>(std::make_unique<T>(*this));
+    return ComponentPool<T>::instance().emplace(id_, *this, std::forward<Args>(args)...);
 }
 
 template<class T>
@@ -33,15 +34,7 @@ Entity::set_component(std::unique_ptr<Component> component)
 {
     check_T<T>();
 
-    if (exists_in_map<T>(components_)) {
-        components_.at(key_from_T<T>()) = std::move(component);
-    } else {
-        components_.insert(
-            ComponentMap::value_type(key_from_T<T>(),
-                                      std::move(component)));
-    }
-
-    return static_cast<T*>(components_.at(key_from_T<T>()).get());
+    return ComponentPool<T>::instance().adopt(id_, std::move(component));
 }
 
 template<class T>
@@ -50,11 +43,7 @@ Entity::get_component() const
 {
     check_T<T>();
 
-    if (!exists_in_map<T>(components_)) {
-        return nullptr;
-    }
-
-    return static_cast<T*>(components_.at(key_from_T<T>()).get());
+    return ComponentPool<T>::instance().get(id_);
 }
 
 template<class T> constexpr
@@ -63,16 +52,3 @@ check_T()
 {
     static_assert(std::is_base_of<Component, T>(), "Require Component Subclass");
 }
-
-template<class T>
-bool exists_in_map(const Entity::ComponentMap& map)
-{
-    return !!map.count(key_from_T<T>());
-}
-
-template<class T>
-const Entity::ComponentMap::key_type
-key_from_T()
-{
-    return std::type_index(typeid(T));
-}
@@ -1,9 +1,25 @@
 #include <iostream>
-#include <stdexcept>
 
 #include "game.hpp"
+#include "spatial_hash.hpp"
+#include "AI/path_service.hpp"
+#include "components/graphics.hpp"
 #include "components/physics.hpp"
 
+Game::Game() :
+    player_(nullptr),
+    static_map_snapshot_version_(0),
+    broad_phase_(std::make_unique<SpatialHash>(get_tile_dimensions())),
+    is_broad_phase_synced_(false),
+    interpolation_(1.f),
+    simulated_time_(sf::Time::Zero),
+    world_dimensions_(WINDOW_WIDTH, WINDOW_HEIGHT),
+    view_(get_window_view()),
+    is_lod_enabled_(false)
+{ }
+
+Game::~Game() = default;
+
 Game&
 Game::instance()
 {
@@ -22,53 +38,154 @@ Game::add_player()
 
     player_ = new Player();
     entities_.emplace_back(player_);
+    is_broad_phase_synced_ = false;
 
     return player_;
 }
 
-const TileMap
-Game::get_map(const Entity* ignore_entity)
+void
+Game::render(Renderer::Renderings& renderings) const
 {
-    initialize_map();
-    TileMap copy = map_;
+    // candidates come in the order of entities_, so they are matched up as the entities are
+    // walked, and only the candidates need the exact test
+    visible_.clear();
+    get_collision_candidates(view_, visible_);
+    auto next_visible = visible_.begin();
 
-    for(auto& entity : entities_) {
-        if (ignore_entity == entity.get()     ||
-            player_ == entity.get()           ||
-            !entity->has_component<Physics>() ||
-            entity->get_component<Physics>()->is_passable()) {
-            continue;
+    for(const auto& entity : entities_) {
+        const bool is_candidate = next_visible != visible_.end() && *next_visible == entity.get();
+        if (is_candidate) {
+            ++next_visible;
         }
 
-        const auto* physics = entity->get_component<Physics>();
-        auto box = physics->get_box();
-        auto min_tile = get_tile_for(box.get_min_corner());
-        auto max_tile = get_tile_for(box.get_max_corner());
-        auto tile_dimensions = sf::Vector2i{1, 1} + (max_tile - min_tile);
-
-        for (int y = 0; y < tile_dimensions.y; ++y) {
-            for (int x = 0; x < tile_dimensions.x; ++x) {
-                try {
-                    copy.at(min_tile.y + y).at(min_tile.x + x).passable = false;
-                } catch (std::out_of_range&) {
-                    // nothing to do here, entity dimensions exceed map_ bounds
-                }
-            }
+        bool is_in_view = true;
+        if (entity->has_component<Physics>()) {
+            is_in_view = is_candidate && is_visible(entity->get_component<Physics>()->get_box());
+        }
+
+        if (is_in_view && entity->has_component<Graphics>()) {
+            entity->get_component<Graphics>()->render(renderings);
         }
     }
+}
+
+bool
+Game::is_visible(const AABB& box) const
+{
+    const auto min = box.get_min_corner();
+    const auto max = box.get_max_corner();
+    const auto view_min = view_.get_min_corner();
+    const auto view_max = view_.get_max_corner();
+
+    return min.x <= view_max.x && view_min.x <= max.x &&
+           min.y <= view_max.y && view_min.y <= max.y;
+}
+
+PathService&
+Game::get_path_service()
+{
+    if (!path_service_) {
+        path_service_ = std::make_unique<PathService>();
+    }
+    return *path_service_;
+}
+
+void
+Game::set_broad_phase(std::unique_ptr<BroadPhaseIF> broad_phase)
+{
+    broad_phase_ = std::move(broad_phase);
+    is_broad_phase_synced_ = false;
+}
+
+void
+Game::sync_broad_phase()
+{
+    broad_phase_->rebuild(entities_);
+    is_broad_phase_synced_ = true;
+}
+
+void
+Game::update_broad_phase(const Entity& entity)
+{
+    if (is_broad_phase_synced_) {
+        broad_phase_->update(entity);
+    }
+}
+
+void
+Game::get_collision_candidates(const AABB& box, Candidates& candidates) const
+{
+    if (is_broad_phase_synced_) {
+        broad_phase_->query(box, candidates);
+        return;
+    }
 
-    return copy;
+    for(const auto& entity : entities_) {
+        candidates.push_back(entity.get());
+    }
+}
+
+OccupancyGrid::View
+Game::get_map(const Entity* ignore_entity) const
+{
+    if (ignore_entity == nullptr) {
+        return OccupancyGrid::View(occupancy_);
+    }
+    return OccupancyGrid::View(occupancy_, ignore_entity->get_id());
+}
+
+const TileMap&
+Game::get_static_map() const
+{
+    return static_occupancy_.get_map();
+}
+
+std::shared_ptr<const TileMap>
+Game::get_static_map_snapshot()
+{
+    const auto version = static_occupancy_.get_version();
+    if (!static_map_snapshot_ || static_map_snapshot_version_ != version) {
+        static_map_snapshot_ = std::make_shared<const TileMap>(static_occupancy_.get_map());
+        static_map_snapshot_version_ = version;
+    }
+
+    return static_map_snapshot_;
+}
+
+std::size_t
+Game::get_static_map_version() const
+{
+    return static_occupancy_.get_version();
 }
 
 void
-Game::initialize_map()
+Game::sync_occupancy()
 {
-    const auto tiles_high = std::ceil(WINDOW_HEIGHT / get_tile_dimensions().y);
-    const auto tiles_wide = std::ceil(WINDOW_WIDTH / get_tile_dimensions().x);
+    const sf::Vector2i tiles(std::ceil(world_dimensions_.x / get_tile_dimensions().x),
+                             std::ceil(world_dimensions_.y / get_tile_dimensions().y));
+    occupancy_.resize(tiles);
+    static_occupancy_.resize(tiles);
+
+    occupancy_.begin_sync();
+    static_occupancy_.begin_sync();
+    for(auto& entity : entities_) {
+        if (!entity->has_component<Physics>() ||
+            entity->get_component<Physics>()->is_passable()) {
+            continue;
+        }
+
+        const auto* physics = entity->get_component<Physics>();
+        auto box = physics->get_box();
+        auto min_tile = get_tile_for(box.get_min_corner());
+        auto max_tile = get_tile_for(box.get_max_corner());
 
-    map_.clear();
-    map_.reserve(tiles_high);
-    for (int y = 0; y < tiles_high; ++y) {
-        map_.emplace_back(tiles_wide, Tile{true});
+        if (player_ != entity.get()) {
+            occupancy_.place(entity->get_id(), min_tile, max_tile);
+        }
+        if (physics->is_static()) {
+            static_occupancy_.place(entity->get_id(), min_tile, max_tile);
+        }
     }
+    occupancy_.end_sync();
+    static_occupancy_.end_sync();
 }
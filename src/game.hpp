@@ -5,8 +5,12 @@
 
 #include "entity.hpp"
 #include "player.hpp"
+#include "broad_phase.hpp"
+#include "occupancy_grid.hpp"
 #include "tile_map.hpp"
 
+class PathService;
+
 class Game
 {
 public:
@@ -14,6 +18,9 @@ public:
     static constexpr float WINDOW_HEIGHT = 1200.f;
 
     using Entities = std::vector<std::unique_ptr<Entity>>;
+    using Candidates = BroadPhaseIF::Candidates;
+
+    ~Game();
 
     Game(const Game&)           = delete;
     void operator=(const Game&) = delete;
@@ -21,22 +28,126 @@ public:
     void reset()
     {
         entities_.clear();
-        map_.clear();
+        occupancy_.clear();
+        static_occupancy_.clear();
+        static_map_snapshot_.reset();
         player_ = nullptr;
+        broad_phase_->clear();
+        is_broad_phase_synced_ = false;
+        world_dimensions_ = sf::Vector2f(WINDOW_WIDTH, WINDOW_HEIGHT);
+        view_ = get_window_view();
+        is_lod_enabled_ = false;
+        simulated_time_ = sf::Time::Zero;
     }
 
     static Game& instance();
 
     inline const Entities& entities() const { return entities_; }
-    inline Entities& entity_collection() { return entities_; }
+
+    /** \brief Mutable access to the entities.
+     *
+     * The collection may be changed through the returned reference, so the broad phase is
+     * unsynced until the next sync_broad_phase(). */
+    inline Entities& entity_collection()
+    {
+        is_broad_phase_synced_ = false;
+        return entities_;
+    }
 
     Player* add_player();
     inline Player* get_player() { return player_; };
 
-    /** \brief Returns a Tile Map with the given entity marked as passable.
+    /** \brief Appends the renderings of every entity with Graphics in view, in the order of
+     * entities().
+     *
+     * Entities with physics are culled to the view through the broad phase while it is synced, or
+     * one at a time otherwise. Entities without physics, like the Gun, always render, and cull
+     * what they draw themselves.
+     *
+     * Pass the same collection, cleared, every frame, and once it has grown to fit the largest
+     * frame, rendering allocates nothing. */
+    void render(Renderer::Renderings& renderings) const;
+
+    /** \brief Sets the part of the world shown on screen.
+     *
+     * The whole window by default, and again after reset(). */
+    inline void set_view(const AABB& view) { view_ = view; }
+    inline const AABB& get_view() const { return view_; }
+
+    /** \return true iff the given box, without its trajectory, overlaps or touches the view. */
+    bool is_visible(const AABB& box) const;
+
+    /** \brief Lets entities out of view be simulated in less detail, on maps larger than the view.
+     *
+     * Off by default, and again after reset(). See AIEnemy::prepare() and AIBullet::refresh(). */
+    inline void set_lod_enabled(bool is_enabled) { is_lod_enabled_ = is_enabled; }
+    inline bool is_lod_enabled() const { return is_lod_enabled_; }
+
+    /** \return true iff an entity with the given box is to be simulated in full detail. */
+    inline bool is_detailed(const AABB& box) const { return !is_lod_enabled_ || is_visible(box); }
+
+    /** \brief Sets the size of the world covered by the Tile Map, from (0, 0).
+     *
+     * The window's size by default, and again after reset(). */
+    inline void set_world_dimensions(sf::Vector2f dimensions) { world_dimensions_ = dimensions; }
+    inline sf::Vector2f get_world_dimensions() const { return world_dimensions_; }
+
+    /** \brief Returns a view of the Tile Map with the given entity marked as passable.
+     *
+     * Tiles set as impassable by the given entity alone are passable in the view, while the map
+     * itself is left as it is, and nothing is copied. The player is always passable. As of the
+     * last sync_occupancy(), so only good until the next one. */
+    OccupancyGrid::View get_map(const Entity* ignore_entity = nullptr) const;
+
+    /** \brief Returns a Tile Map with only static entities marked as impassable.
+     *
+     * Moving entities steer around each other as they collide, so this is the map shared by
+     * everything which navigates towards the same goal. As of the last sync_occupancy(). */
+    const TileMap& get_static_map() const;
+
+    /** \brief Returns a copy of the static Tile Map, shared until the map next changes.
+     *
+     * Unlike the live map, it is safe to read from other threads. */
+    std::shared_ptr<const TileMap> get_static_map_snapshot();
+
+    /** \brief Returns a counter which changes whenever the static Tile Map does.
      *
-     * Will ignore tiles that would be set as impassable by the given entity. */
-    const TileMap get_map(const Entity* ignore_entity = nullptr);
+     * Anything derived from the map, such as a path, is only good while this is unchanged. */
+    std::size_t get_static_map_version() const;
+
+    /** \brief Moves the footprints of entities whose tiles changed since the last sync.
+     *
+     * Walks every entity, so it is called once per step, before the entities prepare(), rather
+     * than by each read of the maps. */
+    void sync_occupancy();
+
+    /** \brief Returns the service resolving path requests off the frame, started on first use.
+     *
+     * It outlives the entities, so they may cancel their requests as they are destroyed. */
+    PathService& get_path_service();
+
+    /** \brief Replaces the broad phase engine.
+     *
+     * The new engine is unsynced until the next sync_broad_phase(). */
+    void set_broad_phase(std::unique_ptr<BroadPhaseIF> broad_phase);
+    inline const BroadPhaseIF& get_broad_phase() const { return *broad_phase_; }
+
+    /** \brief Rebuilds the broad phase from the current entities.
+     *
+     * Called once per frame, before the entities are updated. */
+    void sync_broad_phase();
+
+    /** \brief Moves the given entity to its current position in the broad phase.
+     *
+     * Called whenever an entity has moved, so later queries in the same frame see it where it is. */
+    void update_broad_phase(const Entity& entity);
+
+    /** \brief Collects the entities which may collide with the given box over its trajectory.
+     *
+     * Candidates are appended in the same order as entities(), and are a superset of the entities
+     * for which Collision::broad_test() would pass. Until the broad phase is synced, this is every
+     * entity. */
+    void get_collision_candidates(const AABB& box, Candidates& candidates) const;
 
     static sf::Vector2f get_tile_dimensions() { return sf::Vector2f(20.f, 20.f); }
 
@@ -61,20 +172,51 @@ public:
                             tile.y * get_tile_dimensions().y);
     }
 
-    inline void set_timer(sf::Time time) { timer_ = time; }
-    inline sf::Time get_timer() { return timer_; }
+    /** \brief Returns the time simulated since construction or the last reset().
+     *
+     * It moves a whole step at a time, so it reads the same throughout a step, and on every run
+     * which runs the same steps. See SimulationClock. */
+    inline sf::Time get_simulated_time() const { return simulated_time_; }
+
+    /** \brief Moves the simulated time on, once each step is done. */
+    inline void advance_simulated_time(sf::Time step) { simulated_time_ += step; }
+
+    /** \brief Sets how far the rendered frame is into the next simulation step, in [0, 1].
+     *
+     * Moving entities are drawn that fraction of the way along their last step. */
+    inline void set_interpolation(float alpha) { interpolation_ = alpha; }
+    inline float get_interpolation() const { return interpolation_; }
 
 private:
-    Game() :
-        player_(nullptr)
-    { }
+    Game();
 
-    void initialize_map();
+    static AABB get_window_view()
+    {
+        return AABB(sf::Vector2f(WINDOW_WIDTH, WINDOW_HEIGHT) / 2.f,
+                    sf::Vector2f(WINDOW_WIDTH, WINDOW_HEIGHT));
+    }
+
+    std::unique_ptr<PathService> path_service_; ///< declared first, so destroyed after entities_
 
     Entities entities_;
     Player* player_;
 
-    TileMap map_;
+    OccupancyGrid occupancy_;        ///< solid entities, other than the player
+    OccupancyGrid static_occupancy_; ///< solid, static entities
+
+    /// of static_occupancy_, as of static_map_snapshot_version_
+    std::shared_ptr<const TileMap> static_map_snapshot_;
+    std::size_t static_map_snapshot_version_;
+
+    std::unique_ptr<BroadPhaseIF> broad_phase_; ///< Entities with physics, indexed by position
+    bool is_broad_phase_synced_;                ///< false when entities_ may have changed since sync
+
+    float interpolation_; ///< See set_interpolation()
+    sf::Time simulated_time_; ///< See get_simulated_time()
+
+    sf::Vector2f world_dimensions_; ///< See set_world_dimensions()
 
-    sf::Time timer_;
+    AABB view_;                      ///< See set_view()
+    mutable Candidates visible_;     ///< Reused by render(), to avoid reallocating each frame
+    bool is_lod_enabled_;
 };
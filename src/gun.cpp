@@ -1,11 +1,15 @@
 #include "gun.hpp"
 
+#include "game.hpp"
+#include "job_system.hpp"
 #include "components/physics.hpp"
 
+const std::size_t Gun::REFRESH_GRAIN = 16;
+
 Gun::Gun(const Entity& the_operator) :
     operator_(the_operator)
 {
-    set_component<Graphics>(std::make_unique<Graphics>(*this, *this));
+    emplace_component<Graphics>(*this);
 }
 
 void
@@ -27,14 +31,41 @@ Gun::reload()
     ammunition_->reload();
 }
 
+void
+Gun::prepare()
+{
+    for(auto& projectile : magazine_) {
+        projectile->get_component<Physics>()->save_position();
+    }
+}
+
+void
+Gun::refresh(sf::Time frame_length)
+{
+    JobSystem::instance().parallel_for(magazine_.size(), REFRESH_GRAIN,
+        [this, frame_length](std::size_t begin, std::size_t end)
+        {
+            for (auto ndx = begin; ndx < end; ++ndx) {
+                magazine_[ndx]->refresh(frame_length);
+            }
+        });
+}
+
 sf::Time
 Gun::update(sf::Time elapsed)
 {
-    // remove all the dead projectiles
-    magazine_.erase(
-        std::remove_if(magazine_.begin(), magazine_.end(),
-                       [](const auto& projectile){ return projectile->is_dead(); }),
-        magazine_.end());
+    // give all the dead projectiles back to the ammunition, keeping the live ones in order
+    auto live = magazine_.begin();
+    for(auto& projectile : magazine_) {
+        if (projectile->is_alive()) {
+            *live++ = std::move(projectile);
+        } else if (ammunition_) {
+            ammunition_->recycle(projectile.release());
+        } else {
+            projectile.reset();
+        }
+    }
+    magazine_.erase(live, magazine_.end());
 
     // update the remaining live projectiles
     for(auto& projectile : magazine_) {
@@ -44,16 +75,13 @@ Gun::update(sf::Time elapsed)
     return elapsed;
 }
 
-const Graphics::Renderings
-Gun::render()
+void
+Gun::render(Renderings& renderings)
 {
-    Graphics::Renderings renderings;
-    renderings.reserve(magazine_.size());
-
+    const auto& game = Game::instance();
     for(auto& projectile : magazine_) {
-        const auto& projectile_renderings = projectile->render();
-        renderings.insert(renderings.end(), projectile_renderings.begin(), projectile_renderings.end());
+        if (game.is_visible(projectile->get_component<Physics>()->get_box())) {
+            projectile->render(renderings);
+        }
     }
-
-    return std::move(renderings);
 }
@@ -12,6 +12,8 @@ class Gun : public Entity, public Renderer
 public:
     using Magazine = std::vector<std::unique_ptr<Projectile>>;
 
+    static const std::size_t REFRESH_GRAIN; ///< Most projectiles refreshed by one job
+
     Gun(const Entity& the_operator);
     virtual ~Gun() = default;
 
@@ -21,11 +23,22 @@ public:
     /** \brief Fire a projectile of the set ammunition type at the given target. */
     void fire(sf::Vector2f target);
 
+    /** \return Number of projectiles tracked, including any killed since the last update(). */
+    inline std::size_t get_projectile_count() const { return magazine_.size(); }
+
     /** \brief Delegates to Ammunition::reload(). */
     void reload();
 
+    /** \brief Saves the positions of the projectiles, which aren't entities of the game. */
+    void prepare() override;
+
+    /** \brief Refreshes the live projectiles, in parallel on the JobSystem. */
+    void refresh(sf::Time frame_length) override;
+
+    /** \brief Gives the dead projectiles back to the ammunition, then updates the live ones. */
     sf::Time update(sf::Time elapsed) override;
-    const Graphics::Renderings render() override;
+
+    void render(Renderings& renderings) override;
 
 private:
     const Entity& operator_; ///< The entity operating this gun
@@ -0,0 +1,114 @@
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+
+#include <SFML/System/Clock.hpp>
+
+#include "config.h"
+
+#include "demo_scene.hpp"
+#include "game.hpp"
+#include "profiler.hpp"
+#include "simulation.hpp"
+
+#include "components/physics.hpp"
+
+/** \brief Plays the demo scene without a window, from a fixed script rather than the keyboard and
+ * mouse, so every run simulates the same game. */
+class Script
+{
+public:
+    static constexpr int TURN_TICKS = 240; ///< the player walks each way for 2 seconds
+    static constexpr int FIRE_TICKS = 24;  ///< and fires 5 bullets a second, at a circling target
+
+    explicit Script(const DemoScene& scene) :
+        scene_(scene)
+    { }
+
+    void play(int tick)
+    {
+        static const Player::Direction turns[] = {Player::Direction::UP,
+                                                  Player::Direction::RIGHT,
+                                                  Player::Direction::DOWN,
+                                                  Player::Direction::LEFT};
+
+        if (tick % TURN_TICKS == 0) {
+            const int turn = tick / TURN_TICKS;
+            if (turn > 0) {
+                scene_.player->stop_move(turns[(turn - 1) % 4]);
+            }
+            scene_.player->start_move(turns[turn % 4]);
+        }
+
+        if (tick % FIRE_TICKS == 0) {
+            const float angle = 0.3f * (tick / FIRE_TICKS);
+            const auto position = scene_.player->get_component<Physics>()->get_position();
+
+            // 24 steps of 8333us fall just short of the rate limit's 0.2s, so reload to let it fire
+            scene_.gun->reload();
+            scene_.gun->fire(position + 200.f * sf::Vector2f(std::cos(angle), std::sin(angle)));
+        }
+    }
+
+private:
+    DemoScene scene_;
+};
+
+/** \brief Runs the demo scene as fast as possible, with no window and no rendering.
+ *
+ * usage: shooty_face_headless [ticks [trace.json]], 12000 ticks (100 seconds of game) by default.
+ * Each tick is profiled as a frame, and the last few seconds of it can be written out as a Chrome
+ * trace. */
+int main(int argc, char *argv[])
+{
+    std::cout << "Version " << shooty_face_VERSION_MAJOR
+              << "."        << shooty_face_VERSION_MINOR
+              << "."        << shooty_face_VERSION_REVIS
+              << std::endl;
+
+    const int ticks = argc > 1 ? std::atoi(argv[1]) : 12000;
+    if (ticks <= 0) {
+        std::cerr << "usage: " << argv[0] << " [ticks [trace.json]]" << std::endl;
+        return 1;
+    }
+
+    Script script(DemoScene::build());
+    Simulation simulation;
+    auto& profiler = Profiler::instance();
+
+    sf::Clock clock;
+    for (int tick = 0; tick < ticks; ++tick) {
+        script.play(tick);
+        simulation.step();
+        profiler.end_frame();
+    }
+    const auto elapsed = clock.getElapsedTime();
+
+    const auto simulated = simulation.get_step() * static_cast<sf::Int64>(ticks);
+    std::cout << "Ticks: "            << ticks
+              << ", Simulated: "      << simulated.asSeconds() << " s"
+              << ", Elapsed: "        << elapsed.asSeconds() << " s"
+              << std::endl
+              << "Ticks per second: " << ticks / elapsed.asSeconds()
+              << " (" << simulated.asSeconds() / elapsed.asSeconds() << "x real time)"
+              << ", Entities left: "  << Game::instance().entities().size()
+              << std::endl;
+
+    std::printf("%-12s %7s %7s %7s %7s  (ms per tick, last %zu ticks)\n",
+                "zone", "p50", "p95", "p99", "max", Profiler::FRAME_CAPACITY);
+    for(const auto* zone : profiler.get_zones()) {
+        const auto stats = profiler.get_stats(zone);
+        std::printf("%-12s %7.3f %7.3f %7.3f %7.3f\n",
+                    zone, stats.p50, stats.p95, stats.p99, stats.max);
+    }
+
+    if (argc > 2) {
+        std::ofstream trace(argv[2]);
+        profiler.write_chrome_trace(trace);
+        std::cout << "Trace: " << argv[2] << std::endl;
+    }
+
+    return 0;
+}
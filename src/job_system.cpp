@@ -0,0 +1,156 @@
+#include <algorithm>
+
+#include "job_system.hpp"
+
+// the system and queue of a worker thread, so nested parallel_for() calls queue to the worker
+static thread_local const JobSystem* worker_system = nullptr;
+static thread_local std::size_t worker_queue_ndx = 0;
+
+JobSystem::JobSystem(std::size_t thread_count) :
+    queued_(0),
+    is_stopping_(false)
+{
+    for (std::size_t ndx = 0; ndx <= thread_count; ++ndx) {
+        queues_.push_back(std::make_unique<Queue>());
+    }
+
+    workers_.reserve(thread_count);
+    for (std::size_t ndx = 0; ndx < thread_count; ++ndx) {
+        workers_.emplace_back(&JobSystem::work, this, ndx);
+    }
+}
+
+JobSystem::~JobSystem()
+{
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex_);
+        is_stopping_ = true;
+    }
+    has_jobs_.notify_all();
+
+    for(auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+void
+JobSystem::parallel_for(std::size_t count, std::size_t grain, const Body& body)
+{
+    grain = std::max<std::size_t>(grain, 1);
+    if (count == 0) {
+        return;
+    }
+    if (count <= grain || workers_.empty()) {
+        body(0, count);
+        return;
+    }
+
+    const auto job_count = (count + grain - 1) / grain;
+    Batch batch;
+    batch.body = &body;
+    batch.remaining = job_count;
+
+    const auto queue_ndx = get_queue_ndx();
+    {
+        auto& queue = *queues_[queue_ndx];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        for (std::size_t begin = 0; begin < count; begin += grain) {
+            queue.jobs.push_back(Job{&batch, begin, std::min(begin + grain, count)});
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex_);
+        queued_ += job_count;
+    }
+    has_jobs_.notify_all();
+
+    // help out until the whole batch is done, running whatever is found, nested batches included
+    while (batch.remaining.load(std::memory_order_acquire) > 0) {
+        Job job;
+        if (find(queue_ndx, job)) {
+            run(job);
+        } else {
+            std::this_thread::yield();
+        }
+    }
+}
+
+JobSystem&
+JobSystem::instance()
+{
+    static JobSystem system;
+    return system;
+}
+
+std::size_t
+JobSystem::get_default_thread_count()
+{
+    const std::size_t cores = std::thread::hardware_concurrency();
+    return cores > 1 ? cores - 1 : 0;
+}
+
+void
+JobSystem::work(std::size_t queue_ndx)
+{
+    worker_system = this;
+    worker_queue_ndx = queue_ndx;
+
+    while (true) {
+        Job job;
+        if (find(queue_ndx, job)) {
+            run(job);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleep_mutex_);
+        has_jobs_.wait(lock, [this] { return is_stopping_ || queued_ > 0; });
+        if (is_stopping_) {
+            return;
+        }
+    }
+}
+
+bool
+JobSystem::find(std::size_t queue_ndx, Job& job)
+{
+    if (queued_.load(std::memory_order_acquire) == 0) {
+        return false;
+    }
+
+    {
+        auto& own = *queues_[queue_ndx];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.jobs.empty()) {
+            job = own.jobs.back();
+            own.jobs.pop_back();
+            --queued_;
+            return true;
+        }
+    }
+
+    for (std::size_t offset = 1; offset < queues_.size(); ++offset) {
+        auto& victim = *queues_[(queue_ndx + offset) % queues_.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.jobs.empty()) {
+            job = victim.jobs.front();
+            victim.jobs.pop_front();
+            --queued_;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void
+JobSystem::run(const Job& job)
+{
+    (*job.batch->body)(job.begin, job.end);
+    job.batch->remaining.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+std::size_t
+JobSystem::get_queue_ndx() const
+{
+    return worker_system == this ? worker_queue_ndx : workers_.size();
+}
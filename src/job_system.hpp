@@ -0,0 +1,90 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/** \brief Runs loops across every core, on a pool of work-stealing worker threads.
+ *
+ * parallel_for() splits its range into jobs, queues them on the calling thread's own deque, and
+ * helps to run them until they are all done. Each thread takes the newest job from the back of its
+ * own deque, and when that is empty steals the oldest job from the front of another's, so an idle
+ * worker takes the largest share of work left rather than waiting on a busy one.
+ *
+ * Since the calling thread runs jobs too, parallel_for() can be called from within a job, and a
+ * system with no workers runs everything on the calling thread. */
+class JobSystem
+{
+public:
+    /** \brief Runs the loop body over [begin, end), one chunk of the whole range. */
+    using Body = std::function<void(std::size_t begin, std::size_t end)>;
+
+    /** \param[in] thread_count Number of worker threads, besides any thread calling in. */
+    explicit JobSystem(std::size_t thread_count = get_default_thread_count());
+
+    /** \brief Stops the workers. There are never jobs left, as parallel_for() waits on its own. */
+    ~JobSystem();
+
+    JobSystem(const JobSystem&)      = delete;
+    void operator=(const JobSystem&) = delete;
+
+    /** \brief Runs body over [0, count), returning once all of it has run.
+     *
+     * \param[in] grain Most indices per job, so the body runs at least count / grain times. Chunks
+     *            of the range may run in any order, on any thread, at the same time, so the body
+     *            must only write to state owned by the indices it is given. */
+    void parallel_for(std::size_t count, std::size_t grain, const Body& body);
+
+    inline std::size_t get_thread_count() const { return workers_.size(); }
+
+    /** \brief System shared by the game, started on first use. */
+    static JobSystem& instance();
+
+    /** \return One worker per core, leaving one for the main thread. */
+    static std::size_t get_default_thread_count();
+
+private:
+    struct Batch
+    {
+        const Body* body;
+        std::atomic<std::size_t> remaining; ///< jobs not yet finished
+    };
+
+    struct Job
+    {
+        Batch* batch;
+        std::size_t begin;
+        std::size_t end;
+    };
+
+    struct Queue
+    {
+        std::mutex mutex;
+        std::deque<Job> jobs;
+    };
+
+    void work(std::size_t queue_ndx);
+
+    /** \brief Takes a job from the back of the given queue, or else steals one from the front of
+     * another queue. */
+    bool find(std::size_t queue_ndx, Job& job);
+
+    void run(const Job& job);
+
+    /** \return Queue of the calling thread, shared by all threads which aren't workers. */
+    std::size_t get_queue_ndx() const;
+
+    std::vector<std::unique_ptr<Queue>> queues_; ///< One per worker, then one for other threads
+    std::atomic<std::size_t> queued_;            ///< jobs in queues_, not yet taken
+
+    std::mutex sleep_mutex_;                     ///< guards is_stopping_, and increases of queued_
+    std::condition_variable has_jobs_;
+    bool is_stopping_;
+
+    std::vector<std::thread> workers_;           ///< started last, once the rest is set up
+};
@@ -1,4 +1,7 @@
+#include <fstream>
+#include <functional>
 #include <iostream>
+#include <thread>
 
 #include <SFML/Graphics/RenderWindow.hpp>
 #include <SFML/Graphics/Text.hpp>
@@ -6,16 +9,18 @@
 
 #include "config.h"
 
+#include "demo_scene.hpp"
 #include "game.hpp"
-#include "player.hpp"
-#include "gun.hpp"
-#include "bullet.hpp"
-#include "barrier.hpp"
-#include "enemy.hpp"
+#include "profiler.hpp"
+#include "profiler_overlay.hpp"
 #include "rate_limit.hpp"
+#include "render_snapshots.hpp"
+#include "shape_batch.hpp"
+#include "simulation.hpp"
+#include "spatial_hash.hpp"
+#include "sweep_and_prune.hpp"
 
 #include "components/physics.hpp"
-#include "components/health.hpp"
 
 #include "AI/AI_enemy.hpp"
 
@@ -23,11 +28,6 @@ using namespace std;
 constexpr auto WINDOW_WIDTH  = Game::WINDOW_WIDTH;
 constexpr auto WINDOW_HEIGHT = Game::WINDOW_WIDTH;
 
-void add_renderings(Renderer::Renderings& to, const Renderer::Renderings& from)
-{
-    to.insert(to.end(), from.begin(), from.end());
-}
-
 struct FrameLength
 {
     sf::Time current;
@@ -60,6 +60,61 @@ struct FrameLength
     }
 };
 
+/** \brief Draws each snapshot the simulation publishes, until they are closed.
+ *
+ * Runs on its own thread, which owns the window's drawing and the profiler's frames, so waiting on
+ * the display overlaps with simulating the next frame. */
+static void
+render_frames(sf::RenderWindow& app, RenderSnapshots& snapshots, sf::Text& frame_rate,
+              ProfilerOverlay& overlay)
+{
+    auto& profiler = Profiler::instance();
+    app.setActive(true);
+
+    ShapeBatch batch; ///< Every shape of the frame, drawn at once
+    FrameLength frame_length;
+    sf::Clock clock;
+    RateLimit frame_length_reset(0.5);
+    RateLimit overlay_refresh(4.f);
+
+    while (const auto* renderings = snapshots.read()) {
+        frame_length.update(clock.restart());
+
+        {
+            Profiler::Zone zone("draw");
+            batch.clear();
+            batch.add(*renderings);
+
+            app.clear(sf::Color::White);
+            app.draw(batch);
+
+            if (frame_length_reset.check()) {
+                frame_length_reset.renew();
+                frame_length.reset();
+            }
+
+            frame_rate.setString("Min: " + std::to_string(1.f/frame_length.max.asSeconds()) +
+                                 "Max: " + std::to_string(1.f/frame_length.min.asSeconds()) +
+                                 "Cur: " + std::to_string(1.f/frame_length.current.asSeconds()));
+            app.draw(frame_rate);
+
+            if (overlay_refresh.check()) {
+                overlay_refresh.renew();
+                overlay.update(profiler);
+            }
+            app.draw(overlay);
+        }
+
+        {
+            Profiler::Zone zone("display");
+            app.display();
+        }
+        profiler.end_frame();
+    }
+
+    app.setActive(false);
+}
+
 int main(int argc, char *argv[])
 {
     sf::Font font;
@@ -71,11 +126,8 @@ int main(int argc, char *argv[])
     frame_rate.setColor(sf::Color::Blue);
     frame_rate.setPosition(sf::Vector2f(0.f, 0.f));
 
-    sf::Text timer;
-    timer.setFont(font);
-    timer.setCharacterSize(50);
-    timer.setColor(sf::Color::Blue);
-    timer.setPosition(sf::Vector2f(0.f, 40.f));
+    ProfilerOverlay overlay(font);
+    overlay.set_position(sf::Vector2f(0.f, 60.f));
 
     std::cout << "Version " << shooty_face_VERSION_MAJOR
               << "."        << shooty_face_VERSION_MINOR
@@ -83,102 +135,29 @@ int main(int argc, char *argv[])
               << std::endl;
 
     auto& game = Game::instance();
+    auto& profiler = Profiler::instance();
 
     sf::RenderWindow app(sf::VideoMode(WINDOW_WIDTH, WINDOW_HEIGHT), "Shooty Face");
     app.setFramerateLimit(250);
 
-    auto& player = *game.add_player();
-    player.get_component<Physics>()->set_position(sf::Vector2f(WINDOW_WIDTH, WINDOW_HEIGHT)/2.f);
-
-    game.entity_collection().push_back(std::make_unique<Gun>(player));
-    Gun& gun = static_cast<Gun&>(*game.entity_collection().back().get());
-    gun.set_ammunition(std::make_unique<BulletAmmunition>());
+    auto scene = DemoScene::build();
+    auto& player = *scene.player;
+    auto& gun = *scene.gun;
+    auto& enemy_example = *scene.enemy_example;
 
-    std::vector<Barrier*> barriers(6); ///< top, left, bottom, right
-    for(auto& barrier : barriers) {
-        barrier = new Barrier();
-        game.entity_collection().emplace_back(barrier);
-    }
-
-    float border_thickness = 20.f;
-    barriers[0]->get_component<Physics>()->set_position({WINDOW_WIDTH/2.f, border_thickness/2.f});
-    barriers[0]->get_component<Physics>()->set_dimensions({WINDOW_WIDTH, border_thickness});
-    barriers[1]->get_component<Physics>()->set_position({border_thickness/2.f, WINDOW_HEIGHT/2.f});
-    barriers[1]->get_component<Physics>()->set_dimensions({border_thickness, WINDOW_HEIGHT});
-    barriers[2]->get_component<Physics>()->set_position({WINDOW_WIDTH/2.f, WINDOW_HEIGHT - border_thickness/2.f});
-    barriers[2]->get_component<Physics>()->set_dimensions({WINDOW_WIDTH, border_thickness});
-    barriers[3]->get_component<Physics>()->set_position({WINDOW_WIDTH - border_thickness/2.f, WINDOW_HEIGHT/2.f});
-    barriers[3]->get_component<Physics>()->set_dimensions({border_thickness, WINDOW_HEIGHT});
-
-    barriers[4]->get_component<Physics>()->set_position({WINDOW_WIDTH/2.f, 3.f*WINDOW_HEIGHT/8.f});
-    barriers[4]->get_component<Physics>()->set_dimensions({WINDOW_WIDTH/2.f, border_thickness});
-    barriers[5]->get_component<Physics>()->set_position({3.f*WINDOW_WIDTH/8.f, WINDOW_HEIGHT/2.f});
-    barriers[5]->get_component<Physics>()->set_dimensions({border_thickness, WINDOW_HEIGHT/2.f});
-    /* barriers[5]->get_component<Physics>()->set_position({border_thickness/2.f, WINDOW_HEIGHT/2.f}); */
-    /* barriers[5]->get_component<Physics>()->set_dimensions({border_thickness, WINDOW_HEIGHT}); */
-    /* barriers[6]->get_component<Physics>()->set_position({WINDOW_WIDTH/2.f, WINDOW_HEIGHT - border_thickness/2.f}); */
-    /* barriers[6]->get_component<Physics>()->set_dimensions({WINDOW_WIDTH, border_thickness}); */
-    /* barriers[7]->get_component<Physics>()->set_position({WINDOW_WIDTH - border_thickness/2.f, WINDOW_HEIGHT/2.f}); */
-    /* barriers[7]->get_component<Physics>()->set_dimensions({border_thickness, WINDOW_HEIGHT}); */
-
-    barriers.clear();
-
-    std::vector<Enemy*> enemies(24);
-    int ndx = 0;
-    for(auto& enemy : enemies) {
-        enemy = new Enemy();
-        enemy->get_component<Health>()->set_health(15.f);
-
-        auto* physics = enemy->get_component<Physics>();
-        if (ndx++ <= 3) {
-            physics->set_dimensions(physics->get_dimensions() * 1.5f);
-        } else {
-            physics->set_move_speed(physics->get_move_speed() * 0.5f);
-        }
+    // the view is what the window shows of the world, for culling and level of detail, read here
+    // as the window belongs to the render thread from now on
+    game.set_view(AABB(app.getView().getCenter(), app.getView().getSize()));
 
-        game.entity_collection().emplace_back(enemy);
-    }
+    Simulation simulation;
+    RenderSnapshots snapshots;
 
+    app.setActive(false);
+    std::thread render_thread(render_frames, std::ref(app), std::ref(snapshots),
+                              std::ref(frame_rate), std::ref(overlay));
 
-    sf::Vector2f zero_offset = {border_thickness + enemies[0]->get_component<Physics>()->get_extents().x,
-                                border_thickness + enemies[0]->get_component<Physics>()->get_extents().y};
-    enemies[0]->get_component<Physics>()->set_position({zero_offset.x, zero_offset.y});
-    enemies[1]->get_component<Physics>()->set_position({zero_offset.x, WINDOW_HEIGHT - zero_offset.y});
-    enemies[2]->get_component<Physics>()->set_position({WINDOW_WIDTH - zero_offset.x, WINDOW_HEIGHT - zero_offset.y});
-    enemies[3]->get_component<Physics>()->set_position({WINDOW_WIDTH - zero_offset.x, zero_offset.y});
-
-    zero_offset = {WINDOW_WIDTH/2.f, WINDOW_HEIGHT/4.f};
-    enemies[4]->get_component<Physics>()->set_position({zero_offset.x - WINDOW_WIDTH/16.f, zero_offset.y});
-    auto& enemy_example = *enemies[4];
-    enemies[5]->get_component<Physics>()->set_position({zero_offset.x - WINDOW_WIDTH/8.f, zero_offset.y});
-    enemies[6]->get_component<Physics>()->set_position({zero_offset.x, zero_offset.y});
-    enemies[7]->get_component<Physics>()->set_position({zero_offset.x + WINDOW_WIDTH/8.f, zero_offset.y});
-    enemies[8]->get_component<Physics>()->set_position({zero_offset.x + WINDOW_WIDTH/16.f, zero_offset.y});
-
-    zero_offset = {WINDOW_WIDTH/4.f, WINDOW_HEIGHT/2.f};
-    enemies[9]->get_component<Physics>()->set_position({zero_offset.x, zero_offset.y - WINDOW_HEIGHT/16.f});
-    enemies[10]->get_component<Physics>()->set_position({zero_offset.x, zero_offset.y - WINDOW_HEIGHT/8.f});
-    enemies[11]->get_component<Physics>()->set_position({zero_offset.x, zero_offset.y});
-    enemies[12]->get_component<Physics>()->set_position({zero_offset.x, zero_offset.y + WINDOW_HEIGHT/8.f});
-    enemies[13]->get_component<Physics>()->set_position({zero_offset.x, zero_offset.y + WINDOW_HEIGHT/16.f});
-
-    zero_offset = {WINDOW_WIDTH/2.f, WINDOW_HEIGHT*3.f/4.f};
-    enemies[14]->get_component<Physics>()->set_position({zero_offset.x - WINDOW_WIDTH/16.f, zero_offset.y});
-    enemies[15]->get_component<Physics>()->set_position({zero_offset.x - WINDOW_WIDTH/8.f, zero_offset.y});
-    enemies[16]->get_component<Physics>()->set_position({zero_offset.x, zero_offset.y});
-    enemies[17]->get_component<Physics>()->set_position({zero_offset.x + WINDOW_WIDTH/8.f, zero_offset.y});
-    enemies[18]->get_component<Physics>()->set_position({zero_offset.x + WINDOW_WIDTH/16.f, zero_offset.y});
-
-    zero_offset = {WINDOW_WIDTH*3.f/4.f, WINDOW_HEIGHT/2.f};
-    enemies[19]->get_component<Physics>()->set_position({zero_offset.x, zero_offset.y - WINDOW_HEIGHT/16.f});
-    enemies[20]->get_component<Physics>()->set_position({zero_offset.x, zero_offset.y - WINDOW_HEIGHT/8.f});
-    enemies[21]->get_component<Physics>()->set_position({zero_offset.x, zero_offset.y});
-    enemies[22]->get_component<Physics>()->set_position({zero_offset.x, zero_offset.y + WINDOW_HEIGHT/8.f});
-    enemies[23]->get_component<Physics>()->set_position({zero_offset.x, zero_offset.y + WINDOW_HEIGHT/16.f});
-
-    enemies.clear();
-
-    while (app.isOpen()) {
+    bool is_running = true;
+    while (is_running) {
         static sf::Clock clock;
 
         sf::Event event;
@@ -186,7 +165,7 @@ int main(int argc, char *argv[])
             switch (event.type) {
 
             case sf::Event::Closed:
-                app.close();
+                is_running = false;
                 break;
 
             case sf::Event::KeyReleased:
@@ -194,7 +173,7 @@ int main(int argc, char *argv[])
                 switch (event.key.code) {
 
                 case sf::Keyboard::Escape:
-                    app.close();
+                    is_running = false;
                     break;
 
                 case sf::Keyboard::W:
@@ -213,6 +192,44 @@ int main(int argc, char *argv[])
                     player.stop_move(Player::Direction::RIGHT);
                     break;
 
+                case sf::Keyboard::B:
+                    // toggle the broad phase engine, to compare them in the same scene
+                    if (dynamic_cast<const SpatialHash*>(&game.get_broad_phase())) {
+                        game.set_broad_phase(std::make_unique<SweepAndPrune>());
+                        std::cout << "Broad Phase: Sweep and Prune" << std::endl;
+                    } else {
+                        game.set_broad_phase(std::make_unique<SpatialHash>(Game::get_tile_dimensions()));
+                        std::cout << "Broad Phase: Spatial Hash" << std::endl;
+                    }
+                    break;
+
+                case sf::Keyboard::N:
+                    // toggle how enemies navigate, to compare them in the same scene
+                    if (AIEnemy::get_navigation() == AIEnemy::Navigation::FLOW_FIELD) {
+                        AIEnemy::set_navigation(AIEnemy::Navigation::PATH_REQUEST);
+                        std::cout << "Navigation: Path Requests" << std::endl;
+                    } else {
+                        AIEnemy::set_navigation(AIEnemy::Navigation::FLOW_FIELD);
+                        std::cout << "Navigation: Flow Field" << std::endl;
+                    }
+                    break;
+
+                case sf::Keyboard::L:
+                    // toggle simulating what is out of view in less detail
+                    game.set_lod_enabled(!game.is_lod_enabled());
+                    std::cout << "Level of Detail: " << (game.is_lod_enabled() ? "on" : "off")
+                              << std::endl;
+                    break;
+
+                case sf::Keyboard::P:
+                    // dump the last few seconds of zones, to open in chrome://tracing
+                    {
+                        std::ofstream trace("trace.json");
+                        profiler.write_chrome_trace(trace);
+                        std::cout << "Profile: trace.json" << std::endl;
+                    }
+                    break;
+
                 default:
                     break;
                 }
@@ -264,125 +281,47 @@ int main(int argc, char *argv[])
         /*     std::cout << "Projectile Count: " << projectile_count << std::endl; */
         /* } */
 
-        static FrameLength frame_length;
-        frame_length.update(clock.restart());
-
-        for(auto& entity : game.entities()) {
-            entity->prepare();
-        }
-
-        for(auto& entity : game.entities()) {
-            entity->refresh(frame_length.current);
-
-            auto remaining = frame_length.current;
-            int loops = 2;
-            bool did_portal = false;
-            while(remaining > sf::Time::Zero && loops--)
-            {
-                auto used = entity->update(remaining);
-                remaining -= used;
-
-                // allow one extra retry for a "portal" move
-                // ie. entity is trying to unstick itself from something
-                if (used == sf::Time::Zero && !did_portal) {
-                    did_portal = true;
-                    ++loops;
-                }
-            }
-
-            entity->flush();
-        }
-
-        /* int entity_count = game.entities().size(); */
-
-        auto& collection = game.entity_collection();
-        collection.erase(
-            std::remove_if(collection.begin(), collection.end(),
-                           [](auto& entity) { return entity->is_dead(); }),
-            collection.end());
-
-        /* int delta_entities = entity_count - collection.size(); */
-        /* if (delta_entities != 0) { */
-        /*     std::cout << */
-        /*         "Size: " << */
-        /*         entity_count - delta_entities << " " << */
-        /*         "Delta: " << */
-        /*         delta_entities << */
-        /*         std::endl; */
-        /* } */
-
-        Graphics::Renderings all_renderings;
-
-        for(auto& entity : game.entities()) {
-            if (entity->has_component<Graphics>()) {
-                add_renderings(all_renderings, entity->get_component<Graphics>()->render());
-            }
-        }
-
-        app.clear(sf::Color::White);
-
-        for(const auto* rendering : all_renderings) {
-            app.draw(*rendering);
-        }
+        simulation.advance(clock.restart());
 
-        auto map = Game::instance().get_map(&enemy_example);
+        // waits for the render thread to take the last frame, so the simulation stays a frame ahead
+        auto& renderings = snapshots.write();
+        Profiler::Zone snapshot_zone("snapshot");
+        game.render(renderings);
 
-        sf::RectangleShape impassable_tile;
-        impassable_tile.setFillColor(sf::Color::Red);
-        impassable_tile.setSize(Game::instance().get_tile_dimensions());
-        impassable_tile.setOutlineColor(sf::Color::Black);
-        impassable_tile.setOutlineThickness(-1.f);
+        const auto tile_dimensions = Game::instance().get_tile_dimensions();
 
         //draw tile map
-        /* sf::Vector2i position = {0, 0}; */
-        /* for(const auto& row : map) { */
-        /*     position.x = 0; */
-        /*     for(const auto& tile : row) { */
-        /*         if (!tile.passable) { */
-        /*             impassable_tile.setPosition(Game::instance().get_position_for(position)); */
-        /*             app.draw(impassable_tile); */
+        // (a View masks the enemy out of the occupancy as it is read, and leaves the grid as it is)
+        /* auto map = Game::instance().get_map(&enemy_example); */
+        /* for (int y = 0; y < map.get_height(); ++y) { */
+        /*     for (int x = 0; x < map.get_width(); ++x) { */
+        /*         if (!map.is_passable({x, y})) { */
+        /*             renderings.push_back(Rendering::rectangle( */
+        /*                 Game::instance().get_position_for({x, y}) + tile_dimensions/2.f, */
+        /*                 tile_dimensions, sf::Color::Red, -1.f, sf::Color::Black)); */
         /*         } */
-        /*         ++position.x; */
         /*     } */
-        /* ++position.y; */
         /* } */
 
         // draw tile path
-        sf::RectangleShape path_tile;
-        path_tile.setSize(Game::instance().get_tile_dimensions());
-        path_tile.setOutlineColor(sf::Color::Black);
-        path_tile.setOutlineThickness(-1.f);
-
         const auto* ai = static_cast<AIEnemy*>(enemy_example.get_component<AI>());
         const auto& path = ai->get_path();
         int path_ndx = 0;
         for(const auto& tile : path) {
-            if (path_ndx == ai->get_path_ndx()) {
-                path_tile.setFillColor(sf::Color::Red);
-            } else {
-                path_tile.setFillColor(sf::Color::Blue);
-            }
+            const auto color = path_ndx == ai->get_path_ndx() ? sf::Color::Red : sf::Color::Blue;
             ++path_ndx;
 
-            path_tile.setPosition(Game::instance().get_position_for(tile));
-            app.draw(path_tile);
+            renderings.push_back(Rendering::rectangle(
+                Game::instance().get_position_for(tile) + tile_dimensions/2.f, tile_dimensions,
+                color, -1.f, sf::Color::Black));
         }
 
-        static RateLimit frame_length_reset(0.5);
-        if (frame_length_reset.check()) {
-            frame_length_reset.renew();
-            frame_length.reset();
-        }
-
-        frame_rate.setString("Min: " + std::to_string(1.f/frame_length.max.asSeconds()) +
-                             "Max: " + std::to_string(1.f/frame_length.min.asSeconds()) +
-                             "Cur: " + std::to_string(1.f/frame_length.current.asSeconds()));
-        app.draw(frame_rate);
+        snapshots.publish();
+    }
 
-        timer.setString("Timer: " + std::to_string(1.f/Game::instance().get_timer().asSeconds()));
-        app.draw(timer);
+    snapshots.close();
+    render_thread.join();
+    app.close();
 
-        app.display();
-    }
     return 0;
 }
@@ -0,0 +1,171 @@
+#include <algorithm>
+
+#include "occupancy_grid.hpp"
+
+OccupancyGrid::View::View(const OccupancyGrid& grid, EntityId ignore_id) :
+    View(grid)
+{
+    if (ignore_id >= grid.footprints_.size() || !grid.footprints_[ignore_id].is_placed) {
+        return;
+    }
+
+    // footprints may hang off the map
+    const auto& footprint = grid.footprints_[ignore_id];
+    ignore_min_.x = std::max(footprint.min.x, 0);
+    ignore_min_.y = std::max(footprint.min.y, 0);
+    ignore_max_.x = std::min(footprint.max.x, grid.dimensions_.x - 1);
+    ignore_max_.y = std::min(footprint.max.y, grid.dimensions_.y - 1);
+}
+
+bool
+OccupancyGrid::View::is_clear(const sf::Vector2i& min, const sf::Vector2i& dimensions) const
+{
+    if (dimensions.x <= 0 || dimensions.y <= 0) {
+        return true;
+    }
+    if (min.x < 0 || min.y < 0 ||
+        min.x + dimensions.x > get_width() || min.y + dimensions.y > get_height()) {
+        return false;
+    }
+
+    const int max_x = min.x + dimensions.x;
+    for (int y = min.y; y < min.y + dimensions.y; ++y) {
+        for (int word = min.x / TileMap::WORD_BITS; word <= (max_x - 1) / TileMap::WORD_BITS;
+             ++word) {
+            const Word mask = TileMap::get_row_mask(word, min.x, max_x);
+            if ((get_word(y, word) & mask) != mask) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+OccupancyGrid::View::Word
+OccupancyGrid::View::get_ignored_bits(int y, int word) const
+{
+    const Word mask = TileMap::get_row_mask(word, ignore_min_.x, ignore_max_.x + 1);
+    if (mask == 0) {
+        return 0;
+    }
+
+    // the footprint counts 1 towards each tile it covers, so those at 1 are covered by it alone
+    Word bits = 0;
+    const int first_x = std::max(ignore_min_.x, word * TileMap::WORD_BITS);
+    const int last_x = std::min(ignore_max_.x, (word + 1) * TileMap::WORD_BITS - 1);
+    for (int x = first_x; x <= last_x; ++x) {
+        if (grid_->counts_[y * grid_->dimensions_.x + x] == 1) {
+            bits |= Word(1) << (x % TileMap::WORD_BITS);
+        }
+    }
+
+    return bits;
+}
+
+void
+OccupancyGrid::resize(const sf::Vector2i& dimensions)
+{
+    if (dimensions == dimensions_) {
+        return;
+    }
+
+    clear();
+    dimensions_ = dimensions;
+    ++version_;
+    counts_.assign(dimensions.x * dimensions.y, 0);
+    map_ = TileMap(dimensions.x, dimensions.y);
+}
+
+void
+OccupancyGrid::clear()
+{
+    dimensions_ = {0, 0};
+    map_ = TileMap();
+    ++version_;
+    counts_.clear();
+    footprints_.clear();
+}
+
+void
+OccupancyGrid::begin_sync()
+{
+    ++generation_;
+}
+
+void
+OccupancyGrid::end_sync()
+{
+    for (EntityId id = 0; id < footprints_.size(); ++id) {
+        if (footprints_[id].is_placed && footprints_[id].generation != generation_) {
+            remove(id);
+        }
+    }
+}
+
+void
+OccupancyGrid::place(EntityId id, const sf::Vector2i& min_tile, const sf::Vector2i& max_tile)
+{
+    if (id >= footprints_.size()) {
+        footprints_.resize(id + 1, Footprint{{0, 0}, {0, 0}, 0, false});
+    }
+
+    auto& footprint = footprints_[id];
+    footprint.generation = generation_;
+    if (footprint.is_placed && footprint.min == min_tile && footprint.max == max_tile) {
+        return;
+    }
+
+    if (footprint.is_placed) {
+        add(footprint, -1);
+    }
+
+    footprint.min = min_tile;
+    footprint.max = max_tile;
+    footprint.is_placed = true;
+    add(footprint, 1);
+}
+
+void
+OccupancyGrid::remove(EntityId id)
+{
+    if (id >= footprints_.size() || !footprints_[id].is_placed) {
+        return;
+    }
+
+    auto& footprint = footprints_[id];
+    add(footprint, -1);
+    footprint.is_placed = false;
+}
+
+int
+OccupancyGrid::get_count(const sf::Vector2i& tile) const
+{
+    if (tile.x < 0 || tile.x >= dimensions_.x || tile.y < 0 || tile.y >= dimensions_.y) {
+        return 0;
+    }
+
+    return counts_[tile.y * dimensions_.x + tile.x];
+}
+
+void
+OccupancyGrid::add(const Footprint& footprint, int delta)
+{
+    // footprints may hang off the map
+    const int min_x = std::max(footprint.min.x, 0);
+    const int min_y = std::max(footprint.min.y, 0);
+    const int max_x = std::min(footprint.max.x, dimensions_.x - 1);
+    const int max_y = std::min(footprint.max.y, dimensions_.y - 1);
+
+    for (int y = min_y; y <= max_y; ++y) {
+        for (int x = min_x; x <= max_x; ++x) {
+            auto& count = counts_[y * dimensions_.x + x];
+            const bool was_passable = count == 0;
+            count += delta;
+            if (was_passable != (count == 0)) {
+                map_.set({x, y}, Tile{count == 0});
+                ++version_;
+            }
+        }
+    }
+}
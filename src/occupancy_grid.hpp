@@ -0,0 +1,143 @@
+#pragma once
+
+#include <vector>
+
+#include <SFML/System/Vector2.hpp>
+
+#include "component_pool.hpp"
+#include "tile_map.hpp"
+
+/** \brief Live TileMap of the tiles covered by solid entities.
+ *
+ * Each tile counts the footprints covering it, and is impassable while that count is non-zero. A
+ * footprint only touches the map when it changes, so syncing an unmoved entity costs a comparison.
+ *
+ * An entity can be left out of the map through a View, which reads the map with its footprint
+ * masked out. Views only read the grid, so they never change its map or its version. */
+class OccupancyGrid
+{
+public:
+    /** \brief The grid's map, with (optionally) one entity's footprint taken out of it.
+     *
+     * Reads the TileMap of the grid, nothing is copied. The tiles only the ignored footprint
+     * covers read as passable, which are looked up as the words of their rows are read. The
+     * footprint is the one placed on construction, so a view is only good until the grid next
+     * changes. */
+    class View
+    {
+    public:
+        using Word = TileMap::Word;
+
+        /** \brief The whole grid. */
+        explicit View(const OccupancyGrid& grid) :
+            grid_(&grid),
+            ignore_min_(0, 0),
+            ignore_max_(-1, -1)
+        { }
+
+        /** \brief The grid, without the footprint of the given entity. */
+        View(const OccupancyGrid& grid, EntityId ignore_id);
+
+        View(View&&)                = default;
+        View(const View&)           = delete;
+        void operator=(const View&) = delete;
+
+        ~View() = default;
+
+        inline int get_width() const { return grid_->map_.get_width(); }
+        inline int get_height() const { return grid_->map_.get_height(); }
+        inline bool contains(const sf::Vector2i& tile) const { return grid_->map_.contains(tile); }
+
+        /** \return true iff the given tile is inside the map and passable. */
+        inline bool is_passable(const sf::Vector2i& tile) const
+        {
+            return contains(tile) &&
+                   ((get_word(tile.y, tile.x / TileMap::WORD_BITS) >>
+                     (tile.x % TileMap::WORD_BITS)) & 1);
+        }
+
+        /** \return The given tile, impassable outside the map. */
+        inline Tile get(const sf::Vector2i& tile) const { return Tile{is_passable(tile)}; }
+
+        /** \return true iff every tile of the given rectangle is inside the map and passable.
+         *
+         * An empty rectangle is always clear. */
+        bool is_clear(const sf::Vector2i& min, const sf::Vector2i& dimensions) const;
+
+        /** \return Bits of tiles [word * WORD_BITS, (word + 1) * WORD_BITS) of row y, set if
+         * passable. */
+        inline Word get_word(int y, int word) const
+        {
+            const auto bits = grid_->map_.get_word(y, word);
+            if (y < ignore_min_.y || y > ignore_max_.y) {
+                return bits;
+            }
+            return bits | get_ignored_bits(y, word);
+        }
+
+    private:
+        /** \return Bits of the given word, in row y, of the tiles only the footprint covers. */
+        Word get_ignored_bits(int y, int word) const;
+
+        const OccupancyGrid* grid_;
+        sf::Vector2i ignore_min_; ///< TL tile of the ignored footprint, clipped to the map
+        sf::Vector2i ignore_max_; ///< BR tile of the ignored footprint inclusive, < min if none
+    };
+
+    OccupancyGrid() :
+        dimensions_(0, 0),
+        generation_(0),
+        version_(0)
+    { }
+    ~OccupancyGrid() = default;
+
+    /** \brief Sizes the map, in tiles. Clears every footprint, unless the size is unchanged. */
+    void resize(const sf::Vector2i& dimensions);
+
+    /** \brief Removes every footprint and empties the map. */
+    void clear();
+
+    /** \brief Starts a sync, after which every remaining entity should be place()d. */
+    void begin_sync();
+
+    /** \brief Removes the footprints which weren't place()d since begin_sync(). */
+    void end_sync();
+
+    /** \brief Sets the footprint of the given entity, updating the map only if it changed.
+     *
+     * \param[in] min_tile TL (min) tile covered by the entity, inclusive.
+     * \param[in] max_tile BR (max) tile covered by the entity, inclusive. */
+    void place(EntityId id, const sf::Vector2i& min_tile, const sf::Vector2i& max_tile);
+
+    /** \brief Removes the footprint of the given entity, if it has one. */
+    void remove(EntityId id);
+
+    /** \return Number of footprints covering the given tile, 0 outside the map. */
+    int get_count(const sf::Vector2i& tile) const;
+
+    inline const TileMap& get_map() const { return map_; }
+    inline const sf::Vector2i& get_dimensions() const { return dimensions_; }
+
+    /** \return Counter which changes whenever any tile of the map does, so copies of the map can
+     * tell whether they are stale. */
+    inline std::size_t get_version() const { return version_; }
+
+private:
+    struct Footprint
+    {
+        sf::Vector2i min;
+        sf::Vector2i max;
+        unsigned generation; ///< of the last sync which placed it
+        bool is_placed;
+    };
+
+    /** \brief Adds delta to the count of each tile under the footprint. */
+    void add(const Footprint& footprint, int delta);
+
+    sf::Vector2i dimensions_;
+    TileMap map_;
+    std::vector<int> counts_;            ///< Indexed by y * width + x
+    std::vector<Footprint> footprints_;  ///< Indexed by EntityId
+    unsigned generation_;
+    std::size_t version_;
+};
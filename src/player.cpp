@@ -7,7 +7,7 @@
 
 Player::Player()
 {
-    set_component<Graphics>(std::make_unique<Graphics>(*this, *this));
+    emplace_component<Graphics>(*this);
 
     auto* physics = add_component<Physics>();
     physics->set_dimensions({20.f, 20.f});
@@ -38,7 +38,10 @@ Player::update(sf::Time elapsed)
 
     float min_percent_safe = 1.f;
     auto box = physics->get_box(elapsed.asSeconds());
-    for(auto& entity : Game::instance().entities()) {
+
+    candidates_.clear();
+    Game::instance().get_collision_candidates(box, candidates_);
+    for(auto* entity : candidates_) {
         if (!Collision::sanity_check(*this, *entity)) {
             continue;
         }
@@ -52,6 +55,7 @@ Player::update(sf::Time elapsed)
                 if (percent_safe == 0.f) {
                     auto unpenetrate = Collision::get_penetration(box, entity_box);
                     entity->get_component<Physics>()->move(unpenetrate);
+                    Game::instance().update_broad_phase(*entity);
                 }
 
                 if (percent_safe < min_percent_safe) {
@@ -67,21 +71,15 @@ Player::update(sf::Time elapsed)
     return used;
 }
 
-const Renderer::Renderings
-Player::render()
+void
+Player::render(Renderings& renderings)
 {
     auto* physics = get_component<Physics>();
+    const float alpha = Game::instance().get_interpolation();
 
-    graphic_.setSize(physics->get_dimensions());
-    graphic_.setOrigin(physics->get_extents());
-    graphic_.setPosition(util::pixelate(physics->get_position()));
-    graphic_.setFillColor(sf::Color::Blue);
-
-    Renderings renderings;
-    renderings.reserve(1);
-    renderings.push_back(&graphic_);
-
-    return std::move(renderings);
+    renderings.push_back(Rendering::rectangle(
+        util::pixelate(physics->get_interpolated_position(alpha)), physics->get_dimensions(),
+        sf::Color::Blue));
 }
 
 void
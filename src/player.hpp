@@ -1,9 +1,8 @@
 #pragma once
 
-#include <SFML/Graphics/RectangleShape.hpp>
-
 #include "components/graphics.hpp"
 #include "entity.hpp"
+#include "broad_phase.hpp"
 
 class Player : public Entity, public Renderer
 {
@@ -22,7 +21,7 @@ public:
     virtual ~Player() = default;
 
     sf::Time update(sf::Time elapsed) override;
-    const Renderings render() override;
+    void render(Renderings& renderings) override;
 
     /** \brief Apply velocity to the player in the given direction.
      *
@@ -37,7 +36,8 @@ public:
     void stop_move(Direction direction);
 
 private:
-    sf::RectangleShape graphic_;
+
+    BroadPhaseIF::Candidates candidates_; ///< Reused by update(), to avoid reallocating each frame
 
     struct MovementDirections
     {
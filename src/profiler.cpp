@@ -0,0 +1,166 @@
+#include <algorithm>
+#include <cmath>
+
+#include "profiler.hpp"
+
+constexpr std::size_t Profiler::SAMPLE_CAPACITY;
+constexpr std::size_t Profiler::FRAME_CAPACITY;
+
+std::atomic<unsigned> Profiler::next_id_(1);
+thread_local unsigned Profiler::thread_profiler_id_ = 0;
+thread_local Profiler::ThreadBuffer* Profiler::thread_buffer_ = nullptr;
+
+Profiler::Profiler() :
+    id_(next_id_++),
+    epoch_(std::chrono::steady_clock::now()),
+    is_enabled_(true),
+    frame_(0)
+{ }
+
+Profiler&
+Profiler::instance()
+{
+    static Profiler profiler;
+    return profiler;
+}
+
+void
+Profiler::record(const char* name, std::int64_t start, std::int64_t end)
+{
+    auto& buffer = get_buffer();
+    std::lock_guard<std::mutex> lock(buffer.mutex);
+
+    buffer.samples[buffer.next] = Sample{name, start, end, frame_};
+    buffer.next = (buffer.next + 1) % SAMPLE_CAPACITY;
+}
+
+void
+Profiler::end_frame()
+{
+    const std::size_t frame = frame_;
+    {
+        std::lock_guard<std::mutex> buffers_lock(buffers_mutex_);
+        for(auto& buffer : buffers_) {
+            std::lock_guard<std::mutex> lock(buffer->mutex);
+
+            // back to the first sample of the frame, then forward, so zones are seen in order
+            std::size_t count = 0;
+            while (count < SAMPLE_CAPACITY) {
+                const auto& sample =
+                    buffer->samples[(buffer->next + SAMPLE_CAPACITY - count - 1) % SAMPLE_CAPACITY];
+                if (sample.name == nullptr || sample.frame != frame) {
+                    break;
+                }
+                ++count;
+            }
+
+            for (std::size_t age = count; age >= 1; --age) {
+                const auto& sample =
+                    buffer->samples[(buffer->next + SAMPLE_CAPACITY - age) % SAMPLE_CAPACITY];
+
+                auto found = histories_.find(sample.name);
+                if (found == histories_.end()) {
+                    found = histories_.emplace(sample.name,
+                                               History{std::vector<float>(FRAME_CAPACITY, 0.f),
+                                                       0, 0.f}).first;
+                    zones_.push_back(sample.name);
+                }
+                found->second.pending += (sample.end - sample.start) / 1e6f;
+            }
+        }
+    }
+
+    // zones missing from the frame took no time in it
+    for(auto& entry : histories_) {
+        auto& history = entry.second;
+        history.totals[history.next] = history.pending;
+        history.next = (history.next + 1) % FRAME_CAPACITY;
+        history.pending = 0.f;
+    }
+
+    ++frame_;
+}
+
+Profiler::Stats
+Profiler::get_stats(const char* name) const
+{
+    const auto found = histories_.find(name);
+    if (found == histories_.end()) {
+        return Stats{0.f, 0.f, 0.f, 0.f, 0.f};
+    }
+    const auto& history = found->second;
+
+    // frames before the zone was first seen count as 0 too, but only frames since construction
+    const auto count = std::min<std::size_t>(frame_, FRAME_CAPACITY);
+    sorted_.clear();
+    for (std::size_t age = 1; age <= count; ++age) {
+        sorted_.push_back(history.totals[(history.next + FRAME_CAPACITY - age) % FRAME_CAPACITY]);
+    }
+
+    Stats stats;
+    stats.last = sorted_.front();
+    std::sort(sorted_.begin(), sorted_.end());
+
+    // nearest rank
+    auto percentile = [this](float p)
+    {
+        const auto rank = static_cast<std::size_t>(std::ceil(p * sorted_.size()));
+        return sorted_[std::max<std::size_t>(rank, 1) - 1];
+    };
+    stats.p50 = percentile(0.50f);
+    stats.p95 = percentile(0.95f);
+    stats.p99 = percentile(0.99f);
+    stats.max = sorted_.back();
+
+    return stats;
+}
+
+void
+Profiler::write_chrome_trace(std::ostream& out) const
+{
+    out << "{\"traceEvents\":[";
+
+    bool is_first = true;
+    std::lock_guard<std::mutex> buffers_lock(buffers_mutex_);
+    for(const auto& buffer : buffers_) {
+        std::lock_guard<std::mutex> lock(buffer->mutex);
+
+        for (std::size_t age = SAMPLE_CAPACITY; age >= 1; --age) {
+            const auto& sample =
+                buffer->samples[(buffer->next + SAMPLE_CAPACITY - age) % SAMPLE_CAPACITY];
+            if (sample.name == nullptr) {
+                continue;
+            }
+
+            // times are in us
+            out << (is_first ? "\n" : ",\n")
+                << "{\"name\":\"" << sample.name << "\",\"ph\":\"X\",\"pid\":0"
+                << ",\"tid\":" << buffer->thread_ndx
+                << ",\"ts\":" << sample.start / 1000 << "." << (sample.start % 1000) / 100
+                << ",\"dur\":" << (sample.end - sample.start) / 1000 << "."
+                << ((sample.end - sample.start) % 1000) / 100
+                << ",\"args\":{\"frame\":" << sample.frame << "}}";
+            is_first = false;
+        }
+    }
+
+    out << "\n],\"displayTimeUnit\":\"ms\"}\n";
+}
+
+Profiler::ThreadBuffer&
+Profiler::get_buffer()
+{
+    if (thread_profiler_id_ != id_) {
+        auto buffer = std::make_unique<ThreadBuffer>();
+        buffer->samples.assign(SAMPLE_CAPACITY, Sample{nullptr, 0, 0, 0});
+        buffer->next = 0;
+
+        std::lock_guard<std::mutex> lock(buffers_mutex_);
+        buffer->thread_ndx = buffers_.size();
+        thread_buffer_ = buffer.get();
+        thread_profiler_id_ = id_;
+        buffers_.push_back(std::move(buffer));
+    }
+
+    return *thread_buffer_;
+}
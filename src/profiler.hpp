@@ -0,0 +1,160 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+/** \brief Times named zones of each frame, on any thread, to see where a frame's time went.
+ *
+ * A Zone records one sample when it goes out of scope. Each thread records into its own ring
+ * buffer, so recording is cheap and never waits on another thread, and the buffers keep the last
+ * SAMPLE_CAPACITY samples of each thread, which write_chrome_trace() dumps for chrome://tracing.
+ *
+ * end_frame() totals the time spent in each zone over the frame, keeping the totals of the last
+ * FRAME_CAPACITY frames for get_stats(). Zone names are compared by content, and must outlive the
+ * profiler, so use string literals.
+ *
+ * Zones may be recorded from any thread, but end_frame(), get_stats() and get_zones() must only
+ * be called from one, the thread running the frame. */
+class Profiler
+{
+public:
+    static constexpr std::size_t SAMPLE_CAPACITY = 1 << 14; ///< Per thread
+    static constexpr std::size_t FRAME_CAPACITY = 240;      ///< Frames of totals, per zone
+
+    /** \brief Times its own scope, as a sample of the given zone. */
+    class Zone
+    {
+    public:
+        /** \brief Records into Profiler::instance(). */
+        explicit Zone(const char* name) :
+            Zone(Profiler::instance(), name)
+        { }
+
+        Zone(Profiler& profiler, const char* name) :
+            profiler_(profiler),
+            name_(name),
+            start_(profiler.is_enabled() ? profiler.now() : -1)
+        { }
+
+        ~Zone()
+        {
+            if (start_ >= 0) {
+                profiler_.record(name_, start_, profiler_.now());
+            }
+        }
+
+        Zone(const Zone&)           = delete;
+        void operator=(const Zone&) = delete;
+
+    private:
+        Profiler& profiler_;
+        const char* name_;
+        std::int64_t start_; ///< ns, -1 when the profiler was disabled
+    };
+
+    struct Sample
+    {
+        const char* name;
+        std::int64_t start;  ///< ns since the profiler was constructed
+        std::int64_t end;    ///< ns since the profiler was constructed
+        std::size_t frame;   ///< in which the sample ended
+    };
+
+    /** \brief Milliseconds spent in a zone per frame, over the frames kept. */
+    struct Stats
+    {
+        float last;          ///< in the last frame ended
+        float p50;
+        float p95;
+        float p99;
+        float max;
+    };
+
+    Profiler();
+    ~Profiler() = default;
+
+    Profiler(const Profiler&)       = delete;
+    void operator=(const Profiler&) = delete;
+
+    /** \brief Profiler shared by the game, started on first use. */
+    static Profiler& instance();
+
+    /** \brief Zones started while disabled record nothing. Enabled by default. */
+    inline void set_enabled(bool is_enabled) { is_enabled_ = is_enabled; }
+    inline bool is_enabled() const { return is_enabled_; }
+
+    /** \return ns since the profiler was constructed. */
+    inline std::int64_t now() const
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - epoch_).count();
+    }
+
+    /** \brief Records a sample of the given zone into the calling thread's buffer. */
+    void record(const char* name, std::int64_t start, std::int64_t end);
+
+    /** \brief Totals the samples of each zone which ended during this frame, then starts the
+     * next one. */
+    void end_frame();
+
+    /** \return Number of frames ended, since construction. */
+    inline std::size_t get_frame() const { return frame_; }
+
+    /** \return Names of the zones seen by end_frame(), in the order they were first seen. */
+    inline const std::vector<const char*>& get_zones() const { return zones_; }
+
+    /** \return Totals for the given zone, all 0 if it was never seen by end_frame(). */
+    Stats get_stats(const char* name) const;
+
+    /** \brief Writes every sample still buffered, as Chrome trace event JSON. */
+    void write_chrome_trace(std::ostream& out) const;
+
+private:
+    struct ThreadBuffer
+    {
+        std::mutex mutex;            ///< only contended while the buffer is read
+        std::size_t thread_ndx;      ///< registration order, so the first is normally main
+        std::vector<Sample> samples; ///< ring of SAMPLE_CAPACITY, oldest at next once full
+        std::size_t next;
+    };
+
+    struct History
+    {
+        std::vector<float> totals;   ///< ring of FRAME_CAPACITY, in ms
+        std::size_t next;
+        float pending;               ///< total of the frame being ended, in ms
+    };
+
+    struct NameLess
+    {
+        inline bool operator()(const char* first, const char* second) const
+        { return std::strcmp(first, second) < 0; }
+    };
+
+    /** \return Buffer of the calling thread, registering it on first use. */
+    ThreadBuffer& get_buffer();
+
+    static std::atomic<unsigned> next_id_;
+
+    static thread_local unsigned thread_profiler_id_; ///< of the profiler thread_buffer_ is in
+    static thread_local ThreadBuffer* thread_buffer_;
+
+    const unsigned id_; ///< Unique among profilers, to tell which one a thread registered with
+    const std::chrono::steady_clock::time_point epoch_;
+    std::atomic<bool> is_enabled_;
+    std::atomic<std::size_t> frame_;
+
+    mutable std::mutex buffers_mutex_; ///< guards buffers_, but not what they point to
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers_;
+
+    std::map<const char*, History, NameLess> histories_;
+    std::vector<const char*> zones_;
+    mutable std::vector<float> sorted_; ///< Reused by get_stats()
+};
@@ -0,0 +1,50 @@
+#include <cstdio>
+
+#include <SFML/Graphics/RenderTarget.hpp>
+
+#include "profiler_overlay.hpp"
+
+ProfilerOverlay::ProfilerOverlay(const sf::Font& font, unsigned character_size)
+{
+    text_.setFont(font);
+    text_.setCharacterSize(character_size);
+    text_.setColor(sf::Color::White);
+
+    background_.setFillColor(sf::Color(0, 0, 0, 160));
+}
+
+void
+ProfilerOverlay::update(const Profiler& profiler)
+{
+    char line[96];
+    std::snprintf(line, sizeof(line), "%-12s %7s %7s %7s %7s %7s\n",
+                  "ms", "last", "p50", "p95", "p99", "max");
+    table_ = line;
+
+    for(const auto* zone : profiler.get_zones()) {
+        const auto stats = profiler.get_stats(zone);
+        std::snprintf(line, sizeof(line), "%-12.12s %7.2f %7.2f %7.2f %7.2f %7.2f\n",
+                      zone, stats.last, stats.p50, stats.p95, stats.p99, stats.max);
+        table_ += line;
+    }
+
+    text_.setString(table_);
+
+    const auto bounds = text_.getLocalBounds();
+    background_.setSize(sf::Vector2f(bounds.left + bounds.width, bounds.top + bounds.height) +
+                        sf::Vector2f(8.f, 8.f));
+}
+
+void
+ProfilerOverlay::set_position(const sf::Vector2f& position)
+{
+    background_.setPosition(position);
+    text_.setPosition(position + sf::Vector2f(4.f, 4.f));
+}
+
+void
+ProfilerOverlay::draw(sf::RenderTarget& target, sf::RenderStates states) const
+{
+    target.draw(background_, states);
+    target.draw(text_, states);
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <string>
+
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/Font.hpp>
+#include <SFML/Graphics/RectangleShape.hpp>
+#include <SFML/Graphics/Text.hpp>
+
+#include "profiler.hpp"
+
+/** \brief Table of the Profiler's zones, drawn over the game: ms in the last frame, and the 50th,
+ * 95th and 99th percentiles and max over the frames kept. */
+class ProfilerOverlay : public sf::Drawable
+{
+public:
+    ProfilerOverlay(const sf::Font& font, unsigned character_size = 16);
+    virtual ~ProfilerOverlay() = default;
+
+    /** \brief Rebuilds the table from the profiler's current stats. */
+    void update(const Profiler& profiler);
+
+    void set_position(const sf::Vector2f& position);
+
+private:
+    void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+
+    sf::RectangleShape background_;
+    sf::Text text_;
+    std::string table_; ///< Reused by update()
+};
@@ -23,7 +23,7 @@ public:
      * Clients should set a target for the projectile first, via set_target().*/
     virtual void fire() = 0;
     virtual sf::Time update(sf::Time elapsed) = 0;
-    virtual const Renderings render() = 0;
+    virtual void render(Renderings& renderings) = 0;
 
 private:
     sf::Vector2f target_; ///< The target of this projectile
@@ -45,6 +45,12 @@ public:
      * but the workarounds are kinda ugly, so we'll live with it. */
     virtual Projectile* create_projectile() = 0;
 
+    /** \brief Takes back a dead projectile made by this ammunition, once the gun is done with it.
+     *
+     * Callee assumes responsibility of the projectile, as for create_projectile(). By default it is
+     * destroyed, but ammunition may keep it to hand out again. */
+    virtual void recycle(Projectile* projectile) { delete projectile; }
+
     /** \brief Prepares this ammunition for the next volley.
      *
      * When to reload is left up to client discretion, as it may vary by ammunition type. */
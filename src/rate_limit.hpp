@@ -27,12 +27,21 @@ class RateLimit : public RateLimitIF
 friend class TestableRateLimit;
 
 public:
-    /** \brief Construct a rate limiter with the given rate.
+    /** \brief Construct a rate limiter with the given rate, on the wall clock.
      *
      * The clock is started on construction, and is restarted via renew(). */
     RateLimit(float rate) :
         RateLimit(rate, std::make_unique<Clock>())
     { }
+
+    /** \brief Construct a rate limiter with the given rate, on the given clock.
+     *
+     * Pass a SimulationClock to limit anything the simulation does, so it happens at the same
+     * steps whatever the frame rate. */
+    RateLimit(float rate, std::unique_ptr<ClockIF> clock) :
+        rate_(rate),
+        clock_(std::move(clock))
+    { }
     virtual ~RateLimit() = default;
 
     inline bool check() const override { return clock_->getElapsedTime().asSeconds() >= 1.f/rate_; }
@@ -40,11 +49,6 @@ public:
     inline void renew() override { clock_->restart(); }
 
 private:
-    RateLimit(float rate, std::unique_ptr<ClockIF> clock) :
-        rate_(rate),
-        clock_(std::move(clock))
-    { }
-
     const float rate_;
     std::unique_ptr<ClockIF> clock_;
 };
@@ -0,0 +1,59 @@
+#include "render_snapshots.hpp"
+
+RenderSnapshots::RenderSnapshots() :
+    back_ndx_(0),
+    is_pending_(false),
+    is_closed_(false)
+{ }
+
+RenderSnapshots::Renderings&
+RenderSnapshots::write()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    has_changed_.wait(lock, [this] { return is_closed_ || !is_pending_; });
+
+    // once the last snapshot is taken, the render thread is done with the buffer before it
+    auto& back = buffers_[back_ndx_];
+    back.clear();
+    return back;
+}
+
+void
+RenderSnapshots::publish()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        back_ndx_ = 1 - back_ndx_;
+        is_pending_ = true;
+    }
+    has_changed_.notify_all();
+}
+
+const RenderSnapshots::Renderings*
+RenderSnapshots::read()
+{
+    const Renderings* front = nullptr;
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        has_changed_.wait(lock, [this] { return is_closed_ || is_pending_; });
+        if (!is_pending_) {
+            return nullptr;
+        }
+
+        is_pending_ = false;
+        front = &buffers_[1 - back_ndx_];
+    }
+    has_changed_.notify_all();
+
+    return front;
+}
+
+void
+RenderSnapshots::close()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        is_closed_ = true;
+    }
+    has_changed_.notify_all();
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <condition_variable>
+#include <mutex>
+
+#include "components/graphics.hpp"
+
+/** \brief Hands whole frames of renderings from the simulation thread to a render thread.
+ *
+ * Two buffers take turns: the simulation fills the back one while the render thread draws the
+ * front one, then publish() swaps their roles. A published snapshot is never written again until
+ * the render thread has moved on to the next one, so it is immutable for as long as it is drawn,
+ * and drawing and displaying a frame overlaps with simulating the next.
+ *
+ * Only one thread may call write() and publish(), and only one other may call read(). */
+class RenderSnapshots
+{
+public:
+    using Renderings = Renderer::Renderings;
+
+    RenderSnapshots();
+    ~RenderSnapshots() = default;
+
+    RenderSnapshots(const RenderSnapshots&) = delete;
+    void operator=(const RenderSnapshots&)  = delete;
+
+    /** \brief Waits until the render thread has taken the last snapshot published, so the
+     * simulation never runs more than a frame ahead of the screen.
+     *
+     * \return Back buffer, cleared, to fill with the next snapshot. Its capacity is kept from the
+     *         frames before, so filling it allocates nothing once it has grown large enough. */
+    Renderings& write();
+
+    /** \brief Hands the back buffer, filled since write(), to the render thread. */
+    void publish();
+
+    /** \brief Lets go of the snapshot read before, then waits for the next one published.
+     *
+     * \return Snapshot to draw, valid until the next call, or nullptr once closed and the last
+     *         snapshot published is read. */
+    const Renderings* read();
+
+    /** \brief Stops read() and write() from waiting, as either thread is shutting down.
+     *
+     * The simulation must stop filling snapshots once closed, as the render thread may still be
+     * drawing the buffer write() would return. */
+    void close();
+
+private:
+    std::mutex mutex_;
+    std::condition_variable has_changed_;
+
+    Renderings buffers_[2];
+    int back_ndx_;    ///< of the buffer the simulation fills, the other is the render thread's
+    bool is_pending_; ///< a snapshot is published which the render thread hasn't taken yet
+    bool is_closed_;
+};
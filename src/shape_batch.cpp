@@ -0,0 +1,142 @@
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+#include <SFML/Graphics/RenderTarget.hpp>
+
+#include "shape_batch.hpp"
+
+/** \return Points around the unit circle, starting at the top as for sf::CircleShape. */
+static const std::array<sf::Vector2f, ShapeBatch::CIRCLE_POINT_COUNT>&
+get_unit_circle()
+{
+    static const auto unit_circle = []
+    {
+        std::array<sf::Vector2f, ShapeBatch::CIRCLE_POINT_COUNT> points;
+        const float pi = 3.141592654f;
+        for (std::size_t ndx = 0; ndx < points.size(); ++ndx) {
+            const float angle = ndx * 2.f * pi / points.size() - pi / 2.f;
+            points[ndx] = sf::Vector2f(std::cos(angle), std::sin(angle));
+        }
+        return points;
+    }();
+
+    return unit_circle;
+}
+
+ShapeBatch::ShapeBatch() :
+    vertices_(sf::Triangles)
+{ }
+
+void
+ShapeBatch::clear()
+{
+    vertices_.clear();
+}
+
+void
+ShapeBatch::add(const Rendering& rendering)
+{
+    switch (rendering.shape) {
+
+    case Rendering::Shape::RECTANGLE:
+        add_rectangle(rendering);
+        break;
+
+    case Rendering::Shape::CIRCLE:
+        add_circle(rendering);
+        break;
+    }
+}
+
+void
+ShapeBatch::add(const Renderer::Renderings& renderings)
+{
+    for(const auto& rendering : renderings) {
+        add(rendering);
+    }
+}
+
+void
+ShapeBatch::draw(sf::RenderTarget& target, sf::RenderStates states) const
+{
+    if (vertices_.getVertexCount() > 0) {
+        target.draw(vertices_, states);
+    }
+}
+
+void
+ShapeBatch::add_quad(sf::Vector2f min, sf::Vector2f max, sf::Color color)
+{
+    const sf::Vertex top_left({min.x, min.y}, color);
+    const sf::Vertex top_right({max.x, min.y}, color);
+    const sf::Vertex bottom_right({max.x, max.y}, color);
+    const sf::Vertex bottom_left({min.x, max.y}, color);
+
+    vertices_.append(top_left);
+    vertices_.append(top_right);
+    vertices_.append(bottom_right);
+    vertices_.append(top_left);
+    vertices_.append(bottom_right);
+    vertices_.append(bottom_left);
+}
+
+void
+ShapeBatch::add_rectangle(const Rendering& rendering)
+{
+    const auto min = rendering.position - rendering.dimensions / 2.f;
+    const auto max = rendering.position + rendering.dimensions / 2.f;
+    if (rendering.outline_thickness == 0.f) {
+        add_quad(min, max, rendering.fill_color);
+        return;
+    }
+
+    // as sf::Shape, the outline grows out of the bounds, or into them when negative, where one as
+    // thick as half the rectangle covers it completely
+    sf::Vector2f inner_min = min;
+    sf::Vector2f inner_max = max;
+    sf::Vector2f outer_min = min;
+    sf::Vector2f outer_max = max;
+    float thickness = rendering.outline_thickness;
+    if (thickness > 0.f) {
+        outer_min -= sf::Vector2f(thickness, thickness);
+        outer_max += sf::Vector2f(thickness, thickness);
+    } else {
+        thickness = std::min({-thickness, rendering.dimensions.x / 2.f,
+                              rendering.dimensions.y / 2.f});
+        inner_min += sf::Vector2f(thickness, thickness);
+        inner_max -= sf::Vector2f(thickness, thickness);
+    }
+
+    add_quad(inner_min, inner_max, rendering.fill_color);
+
+    // top and bottom span the whole width, left and right fit between them
+    add_quad(outer_min, {outer_max.x, inner_min.y}, rendering.outline_color);
+    add_quad({outer_min.x, inner_max.y}, outer_max, rendering.outline_color);
+    add_quad({outer_min.x, inner_min.y}, {inner_min.x, inner_max.y}, rendering.outline_color);
+    add_quad({inner_max.x, inner_min.y}, {outer_max.x, inner_max.y}, rendering.outline_color);
+}
+
+void
+ShapeBatch::add_circle(const Rendering& rendering)
+{
+    const auto& unit_circle = get_unit_circle();
+    const sf::Vertex center(rendering.position, rendering.fill_color);
+    const sf::Vector2f radius = rendering.dimensions / 2.f;
+
+    auto to_vertex = [&](const sf::Vector2f& point)
+    {
+        return sf::Vertex({rendering.position.x + radius.x * point.x,
+                           rendering.position.y + radius.y * point.y}, rendering.fill_color);
+    };
+
+    // a fan of triangles from the center, each to the next point around
+    auto previous = to_vertex(unit_circle.back());
+    for(const auto& point : unit_circle) {
+        const auto next = to_vertex(point);
+        vertices_.append(center);
+        vertices_.append(previous);
+        vertices_.append(next);
+        previous = next;
+    }
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/VertexArray.hpp>
+
+#include "components/graphics.hpp"
+
+/** \brief Draws any number of Renderings in a single draw call.
+ *
+ * Every shape is untextured and alpha blended, so all of them are triangulated into one
+ * sf::VertexArray of sf::Triangles, in the order they were added, and overlap just as they would
+ * if they were drawn one at a time. Outlines are drawn as strips around the fill, rather than over
+ * it, where sf::Shape would draw them: outside the bounds, or inside when the thickness is
+ * negative.
+ *
+ * clear() keeps the array's storage, so a batch reused for every frame stops allocating once it
+ * has grown to fit the largest frame. */
+class ShapeBatch : public sf::Drawable
+{
+public:
+    static constexpr std::size_t CIRCLE_POINT_COUNT = 30; ///< as for sf::CircleShape
+
+    ShapeBatch();
+    virtual ~ShapeBatch() = default;
+
+    /** \brief Removes every shape, for the next frame. */
+    void clear();
+
+    /** \brief Adds the given shape, in front of those already added. */
+    void add(const Rendering& rendering);
+    void add(const Renderer::Renderings& renderings);
+
+    inline const sf::VertexArray& get_vertices() const { return vertices_; }
+
+private:
+    void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+
+    /** \brief Adds the axis aligned rectangle from min to max, as two triangles. */
+    void add_quad(sf::Vector2f min, sf::Vector2f max, sf::Color color);
+
+    void add_rectangle(const Rendering& rendering);
+    void add_circle(const Rendering& rendering);
+
+    sf::VertexArray vertices_; ///< sf::Triangles
+};
@@ -0,0 +1,123 @@
+#include <algorithm>
+
+#include "simulation.hpp"
+
+#include "game.hpp"
+#include "job_system.hpp"
+#include "profiler.hpp"
+#include "components/physics.hpp"
+
+const sf::Time Simulation::DEFAULT_STEP = sf::microseconds(1000000 / 120);
+const std::size_t Simulation::REFRESH_GRAIN = 4;
+
+Simulation::Simulation(sf::Time step, int max_steps) :
+    step_(step),
+    max_steps_(std::max(max_steps, 1)),
+    accumulator_(sf::Time::Zero),
+    step_count_(0)
+{ }
+
+int
+Simulation::advance(sf::Time frame_length)
+{
+    accumulator_ += frame_length;
+
+    int steps = 0;
+    while (accumulator_ >= step_ && steps < max_steps_) {
+        step();
+        accumulator_ -= step_;
+        ++steps;
+    }
+
+    // too far behind to catch up, so let the simulation run slow rather than fall further behind
+    if (accumulator_ >= step_) {
+        accumulator_ = sf::microseconds(accumulator_.asMicroseconds() % step_.asMicroseconds());
+    }
+
+    Game::instance().set_interpolation(get_interpolation());
+    return steps;
+}
+
+void
+Simulation::step()
+{
+    Profiler::Zone step_zone("step");
+    auto& game = Game::instance();
+    const auto& entities = game.entities();
+
+    {
+        Profiler::Zone zone("prepare");
+
+        // the maps are read all through the step, from where the entities ended the last one
+        game.sync_occupancy();
+        for(auto& entity : entities) {
+            if (entity->has_component<Physics>()) {
+                entity->get_component<Physics>()->save_position();
+            }
+            entity->prepare();
+        }
+
+        game.sync_broad_phase();
+    }
+
+    {
+        // intent: each entity works out its move against the world as it was at the start of the
+        // step, writing only to itself, so every core can take a share
+        Profiler::Zone zone("refresh");
+        JobSystem::instance().parallel_for(entities.size(), REFRESH_GRAIN,
+            [&entities, this](std::size_t begin, std::size_t end)
+            {
+                Profiler::Zone zone("refresh_job");
+                for (auto ndx = begin; ndx < end; ++ndx) {
+                    entities[ndx]->refresh(step_);
+                }
+            });
+    }
+
+    {
+        // resolve: entities move in order, each seeing those before it where they ended up, so the
+        // result is the same however the intents were scheduled
+        Profiler::Zone zone("update");
+        for(auto& entity : entities) {
+            auto remaining = step_;
+            int loops = 2;
+            bool did_portal = false;
+            while(remaining > sf::Time::Zero && loops--)
+            {
+                auto used = entity->update(remaining);
+                remaining -= used;
+
+                // allow one extra retry for a "portal" move
+                // ie. entity is trying to unstick itself from something
+                if (used == sf::Time::Zero && !did_portal) {
+                    did_portal = true;
+                    ++loops;
+                }
+            }
+
+            game.update_broad_phase(*entity);
+        }
+    }
+
+    {
+        Profiler::Zone zone("flush");
+        for(auto& entity : entities) {
+            entity->flush();
+        }
+    }
+
+    {
+        Profiler::Zone zone("erase");
+        const auto is_dead = [](const auto& entity) { return entity->is_dead(); };
+
+        // the broad phase stays synced for render() until an entity is actually erased
+        if (std::any_of(entities.begin(), entities.end(), is_dead)) {
+            auto& collection = game.entity_collection();
+            collection.erase(std::remove_if(collection.begin(), collection.end(), is_dead),
+                             collection.end());
+        }
+    }
+
+    game.advance_simulated_time(step_);
+    ++step_count_;
+}
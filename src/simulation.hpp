@@ -0,0 +1,58 @@
+#pragma once
+
+#include <SFML/System/Time.hpp>
+
+/** \brief Steps the game forward in fixed increments of time, independent of the frame rate.
+ *
+ * Each frame's length is added to an accumulator, and as many whole steps as it covers are run.
+ * The time left over is carried to the next frame, and the rendered frame is interpolated that far
+ * into the next step (see Game::set_interpolation()). Every step sees the same time delta, and
+ * timers such as rate limits run on the simulated time rather than the wall clock (see
+ * SimulationClock), so the same steps give the same result at any frame rate, and the cost is set by
+ * the step rate alone. Paths requested from the PathService are the exception: they arrive whenever
+ * a worker finds them.
+ *
+ * Each step has two phases. In the first, every entity refresh()es in parallel on the JobSystem,
+ * working out what it intends to do from the world as it was at the start of the step. In the
+ * second, entities update() one at a time in order, resolving those intents against each other, so
+ * the result doesn't depend on how the first phase was scheduled.
+ *
+ * Runs on the Game singleton, but knows nothing of the window, so it can be driven and timed on
+ * its own. */
+class Simulation
+{
+public:
+    static const sf::Time DEFAULT_STEP; ///< 120 Hz
+    static const std::size_t REFRESH_GRAIN; ///< Most entities refreshed by one job
+
+    /** \param[in] step Length of each step.
+     *  \param[in] max_steps Most steps run by one advance(). Time past that is dropped, so a slow
+     *             frame doesn't make the next one slower still. */
+    explicit Simulation(sf::Time step = DEFAULT_STEP, int max_steps = 8);
+    ~Simulation() = default;
+
+    /** \brief Adds the frame's length to the accumulator, and runs the steps it covers.
+     *
+     * Also sets the Game's interpolation to the fraction of a step left over.
+     *
+     * \return Number of steps run. */
+    int advance(sf::Time frame_length);
+
+    /** \brief Runs exactly one step, whatever the accumulated time. */
+    void step();
+
+    /** \return Fraction of a step accumulated but not yet run, in [0, 1). */
+    inline float get_interpolation() const
+    { return accumulator_.asSeconds() / step_.asSeconds(); }
+
+    inline sf::Time get_step() const { return step_; }
+
+    /** \return Number of steps run, since construction. */
+    inline std::size_t get_step_count() const { return step_count_; }
+
+private:
+    sf::Time step_;
+    int max_steps_;
+    sf::Time accumulator_; ///< Time not yet stepped through
+    std::size_t step_count_;
+};
@@ -0,0 +1,159 @@
+#include <algorithm>
+#include <cmath>
+
+#include "spatial_hash.hpp"
+#include "components/physics.hpp"
+
+constexpr std::size_t SpatialHash::NO_ENTRY;
+
+SpatialHash::SpatialHash(sf::Vector2f cell_dimensions, std::size_t bucket_count) :
+    cell_dimensions_(cell_dimensions)
+{
+    std::size_t count = 1;
+    while (count < bucket_count) {
+        count <<= 1;
+    }
+
+    bucket_mask_ = count - 1;
+    buckets_.resize(count);
+}
+
+void
+SpatialHash::clear()
+{
+    for(const auto& entry : entries_) {
+        entry_for_id_[entry.id] = NO_ENTRY;
+    }
+
+    for(auto& bucket : buckets_) {
+        bucket.clear();
+    }
+
+    entries_.clear();
+}
+
+void
+SpatialHash::rebuild(const Entities& entities)
+{
+    clear();
+
+    for(const auto& entity : entities) {
+        if (entity->has_component<Physics>()) {
+            insert(*entity);
+        }
+    }
+}
+
+void
+SpatialHash::insert(Entity& entity)
+{
+    const auto id = entity.get_id();
+    if (id >= entry_for_id_.size()) {
+        entry_for_id_.resize(id + 1, NO_ENTRY);
+    }
+
+    entry_for_id_[id] = entries_.size();
+    entries_.push_back(Entry{&entity, id, cells_for(entity.get_component<Physics>()->get_box())});
+
+    add_to_buckets(entries_.size() - 1);
+}
+
+void
+SpatialHash::update(const Entity& entity)
+{
+    const auto id = entity.get_id();
+    if (id >= entry_for_id_.size() || entry_for_id_[id] == NO_ENTRY) {
+        return;
+    }
+
+    const auto entry_ndx = entry_for_id_[id];
+    const auto cells = cells_for(entity.get_component<Physics>()->get_box());
+    if (cells == entries_[entry_ndx].cells) {
+        return;
+    }
+
+    remove_from_buckets(entry_ndx);
+    entries_[entry_ndx].cells = cells;
+    add_to_buckets(entry_ndx);
+}
+
+void
+SpatialHash::query(const AABB& box, Candidates& candidates) const
+{
+    const auto first = candidates.size();
+    const auto cells = cells_for(AABB::state_space_for(box));
+
+    for (int y = cells.min.y; y <= cells.max.y; ++y) {
+        for (int x = cells.min.x; x <= cells.max.x; ++x) {
+            for(auto entry_ndx : buckets_[bucket_for(x, y)]) {
+                const auto& entry = entries_[entry_ndx];
+
+                // skip entries which only share this bucket via a hash collision
+                if (entry.cells.min.x > cells.max.x || entry.cells.max.x < cells.min.x ||
+                    entry.cells.min.y > cells.max.y || entry.cells.max.y < cells.min.y) {
+                    continue;
+                }
+
+                candidates.push_back(entry.entity);
+            }
+        }
+    }
+
+    // entities spanning several cells are found once per cell
+    auto insertion_order = [this](const Entity* first, const Entity* second)
+    {
+        return entry_for_id_[first->get_id()] < entry_for_id_[second->get_id()];
+    };
+    std::sort(candidates.begin() + first, candidates.end(), insertion_order);
+    candidates.erase(std::unique(candidates.begin() + first, candidates.end()), candidates.end());
+}
+
+SpatialHash::CellRange
+SpatialHash::cells_for(const AABB& box) const
+{
+    const auto min = box.get_min_corner();
+    const auto max = box.get_max_corner();
+
+    return CellRange{
+        sf::Vector2i(std::floor(min.x / cell_dimensions_.x), std::floor(min.y / cell_dimensions_.y)),
+        sf::Vector2i(std::floor(max.x / cell_dimensions_.x), std::floor(max.y / cell_dimensions_.y))};
+}
+
+std::size_t
+SpatialHash::bucket_for(int x, int y) const
+{
+    // large primes, from Teschner et al. "Optimized Spatial Hashing for Collision Detection"
+    const auto hash = (static_cast<std::size_t>(x) * 73856093u) ^
+                      (static_cast<std::size_t>(y) * 19349663u);
+    return hash & bucket_mask_;
+}
+
+void
+SpatialHash::add_to_buckets(std::size_t entry_ndx)
+{
+    const auto& cells = entries_[entry_ndx].cells;
+
+    for (int y = cells.min.y; y <= cells.max.y; ++y) {
+        for (int x = cells.min.x; x <= cells.max.x; ++x) {
+            auto& bucket = buckets_[bucket_for(x, y)];
+
+            // several cells of a large entry may hash to the same bucket
+            if (bucket.empty() || bucket.back() != entry_ndx) {
+                bucket.push_back(entry_ndx);
+            }
+        }
+    }
+}
+
+void
+SpatialHash::remove_from_buckets(std::size_t entry_ndx)
+{
+    const auto& cells = entries_[entry_ndx].cells;
+
+    for (int y = cells.min.y; y <= cells.max.y; ++y) {
+        for (int x = cells.min.x; x <= cells.max.x; ++x) {
+            auto& bucket = buckets_[bucket_for(x, y)];
+            bucket.erase(std::remove(bucket.begin(), bucket.end(), entry_ndx), bucket.end());
+        }
+    }
+}
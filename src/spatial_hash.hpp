@@ -0,0 +1,79 @@
+#pragma once
+
+#include <vector>
+
+#include <SFML/System/Vector2.hpp>
+
+#include "AABB.hpp"
+#include "broad_phase.hpp"
+#include "entity.hpp"
+
+/** \brief Uniform grid broad phase for collision queries.
+ *
+ * Space is divided into cells (typically one per map tile), and each cell is hashed into one of a
+ * fixed number of buckets. Entities are stored in every bucket their AABB overlaps, so a query
+ * only has to look at the buckets under the queried box, rather than at every entity.
+ *
+ * Works best when entities are spread out and similarly sized. Besides the usual false positives,
+ * entities may share a bucket through a hash collision. */
+class SpatialHash : public BroadPhaseIF
+{
+public:
+    /** \param[in] cell_dimensions <width, height> of each cell.
+     *  \param[in] bucket_count Number of hash buckets, rounded up to the next power of two. */
+    SpatialHash(sf::Vector2f cell_dimensions, std::size_t bucket_count = 4096);
+    virtual ~SpatialHash() = default;
+
+    void clear() override;
+
+    /** \brief Clears, then inserts each of the given entities with a Physics component. */
+    void rebuild(const Entities& entities) override;
+
+    /** \brief Adds the given entity at its current position.
+     *
+     * The entity must have a Physics component. Entities are returned from query() in the order
+     * they were inserted. */
+    void insert(Entity& entity);
+
+    /** \brief Moves the given entity to the cells for its current position.
+     *
+     * Cheap when the entity hasn't left its cells, which is the common case from frame to frame. */
+    void update(const Entity& entity) override;
+
+    /** \brief Collects the entities whose cells overlap the state space of the given box. */
+    void query(const AABB& box, Candidates& candidates) const override;
+
+    inline std::size_t size() const override { return entries_.size(); }
+
+private:
+    struct CellRange
+    {
+        sf::Vector2i min; ///< TL cell, inclusive
+        sf::Vector2i max; ///< BR cell, inclusive
+
+        inline bool operator==(const CellRange& other) const
+        { return min == other.min && max == other.max; }
+    };
+
+    struct Entry
+    {
+        Entity* entity;
+        EntityId id;     ///< saved, as the entity may be destroyed before the next clear()
+        CellRange cells; ///< cells this entry is currently stored in
+    };
+
+    static constexpr std::size_t NO_ENTRY = static_cast<std::size_t>(-1);
+
+    CellRange cells_for(const AABB& box) const;
+    std::size_t bucket_for(int x, int y) const;
+
+    void add_to_buckets(std::size_t entry_ndx);
+    void remove_from_buckets(std::size_t entry_ndx);
+
+    sf::Vector2f cell_dimensions_;
+    std::size_t bucket_mask_; ///< bucket_count - 1, bucket_count is a power of two
+
+    std::vector<Entry> entries_;                   ///< In insertion order
+    std::vector<std::vector<std::size_t>> buckets_; ///< Indices into entries_
+    std::vector<std::size_t> entry_for_id_;         ///< Entity id -> index into entries_
+};
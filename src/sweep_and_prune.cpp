@@ -0,0 +1,326 @@
+#include <algorithm>
+
+#include "sweep_and_prune.hpp"
+#include "components/physics.hpp"
+
+constexpr std::size_t SweepAndPrune::NO_ENTRY;
+
+SweepAndPrune::SweepAndPrune(float large_extent) :
+    large_extent_(large_extent),
+    sweep_axis_(0),
+    max_extent_(0.f)
+{ }
+
+void
+SweepAndPrune::clear()
+{
+    for(const auto& entry : entries_) {
+        entry_for_id_[entry.id] = NO_ENTRY;
+    }
+
+    entries_.clear();
+    endpoints_[0].clear();
+    endpoints_[1].clear();
+    large_.clear();
+    max_extent_ = 0.f;
+}
+
+void
+SweepAndPrune::rebuild(const Entities& entities)
+{
+    // match the entities to the entries from the last rebuild, in their new order
+    const auto old_count = entries_.size();
+    remap_.assign(old_count, NO_ENTRY);
+
+    auto& entries = rebuilt_;
+    entries.clear();
+
+    for(const auto& entity : entities) {
+        if (!entity->has_component<Physics>()) {
+            continue;
+        }
+
+        const auto id = entity->get_id();
+        if (id < entry_for_id_.size() && entry_for_id_[id] != NO_ENTRY) {
+            const auto old_ndx = entry_for_id_[id];
+            if (entries_[old_ndx].entity == entity.get()) {
+                remap_[old_ndx] = entries.size();
+            }
+        }
+
+        entries.push_back(Entry{entity.get(), id, {}, {}, {}, {}, false});
+        set_bounds(entries.back(), *entity);
+    }
+
+    for(const auto& entry : entries_) {
+        entry_for_id_[entry.id] = NO_ENTRY;
+    }
+    entries_.swap(entries);
+
+    for(std::size_t ndx = 0; ndx < entries_.size(); ++ndx) {
+        const auto id = entries_[ndx].id;
+        if (id >= entry_for_id_.size()) {
+            entry_for_id_.resize(id + 1, NO_ENTRY);
+        }
+        entry_for_id_[id] = ndx;
+    }
+
+    // keep the endpoints of matched entries in their previous order, then append the new ones
+    is_matched_.assign(entries_.size(), false);
+    for(const auto new_ndx : remap_) {
+        if (new_ndx != NO_ENTRY) {
+            is_matched_[new_ndx] = true;
+        }
+    }
+
+    for (int axis = 0; axis < 2; ++axis) {
+        auto& endpoints = endpoints_[axis];
+
+        endpoints.erase(
+            std::remove_if(endpoints.begin(), endpoints.end(),
+                           [this](const Endpoint& endpoint) { return remap_[endpoint.entry] == NO_ENTRY; }),
+            endpoints.end());
+
+        for(auto& endpoint : endpoints) {
+            endpoint.entry = remap_[endpoint.entry];
+            const auto& entry = entries_[endpoint.entry];
+            endpoint.value = endpoint.is_max ? entry.max[axis] : entry.min[axis];
+        }
+
+        for(std::size_t ndx = 0; ndx < entries_.size(); ++ndx) {
+            if (!is_matched_[ndx]) {
+                endpoints.push_back(Endpoint{entries_[ndx].min[axis], ndx, false});
+                endpoints.push_back(Endpoint{entries_[ndx].max[axis], ndx, true});
+            }
+        }
+
+        sort_axis(axis);
+    }
+
+    choose_sweep_axis();
+}
+
+void
+SweepAndPrune::update(const Entity& entity)
+{
+    const auto id = entity.get_id();
+    if (id >= entry_for_id_.size() || entry_for_id_[id] == NO_ENTRY) {
+        return;
+    }
+
+    auto& entry = entries_[entry_for_id_[id]];
+    const auto old_min_x = entry.min[0];
+    const auto old_min_y = entry.min[1];
+    set_bounds(entry, entity);
+
+    const bool is_moving_up[2] = {entry.min[0] > old_min_x, entry.min[1] > old_min_y};
+    for (int axis = 0; axis < 2; ++axis) {
+        endpoints_[axis][entry.min_at[axis]].value = entry.min[axis];
+        endpoints_[axis][entry.max_at[axis]].value = entry.max[axis];
+
+        // move the leading endpoint first, so the trailing one isn't held back by it
+        if (is_moving_up[axis]) {
+            bubble(axis, entry.max_at[axis]);
+            bubble(axis, entry.min_at[axis]);
+        } else {
+            bubble(axis, entry.min_at[axis]);
+            bubble(axis, entry.max_at[axis]);
+        }
+    }
+
+    if (!entry.is_large) {
+        max_extent_ = std::max(max_extent_, entry.max[sweep_axis_] - entry.min[sweep_axis_]);
+    }
+}
+
+void
+SweepAndPrune::query(const AABB& box, Candidates& candidates) const
+{
+    const auto first = candidates.size();
+    const auto space = AABB::state_space_for(box);
+    const float min[2] = {space.get_min_corner().x, space.get_min_corner().y};
+    const float max[2] = {space.get_max_corner().x, space.get_max_corner().y};
+
+    // no entry which starts before this can reach the queried box
+    const auto& endpoints = endpoints_[sweep_axis_];
+    const Endpoint start{min[sweep_axis_] - max_extent_, 0, false};
+
+    for(auto it = std::lower_bound(endpoints.begin(), endpoints.end(), start);
+        it != endpoints.end() && it->value <= max[sweep_axis_];
+        ++it) {
+        if (it->is_max) {
+            continue;
+        }
+
+        const auto& entry = entries_[it->entry];
+        if (!entry.is_large && overlaps(entry, min, max)) {
+            candidates.push_back(entry.entity);
+        }
+    }
+
+    for(auto entry_ndx : large_) {
+        const auto& entry = entries_[entry_ndx];
+        if (overlaps(entry, min, max)) {
+            candidates.push_back(entry.entity);
+        }
+    }
+
+    auto rebuild_order = [this](const Entity* first, const Entity* second)
+    {
+        return entry_for_id_[first->get_id()] < entry_for_id_[second->get_id()];
+    };
+    std::sort(candidates.begin() + first, candidates.end(), rebuild_order);
+}
+
+void
+SweepAndPrune::pairs(Pairs& pairs) const
+{
+    const auto first = pairs.size();
+    const auto other_axis = 1 - sweep_axis_;
+
+    active_.clear();
+    for(const auto& endpoint : endpoints_[sweep_axis_]) {
+        if (endpoint.is_max) {
+            auto it = std::find(active_.begin(), active_.end(), endpoint.entry);
+            *it = active_.back();
+            active_.pop_back();
+            continue;
+        }
+
+        const auto& entry = entries_[endpoint.entry];
+        for(auto active_ndx : active_) {
+            const auto& active = entries_[active_ndx];
+            if (entry.min[other_axis] > active.max[other_axis] ||
+                entry.max[other_axis] < active.min[other_axis]) {
+                continue;
+            }
+
+            if (active_ndx < endpoint.entry) {
+                pairs.emplace_back(active.entity, entry.entity);
+            } else {
+                pairs.emplace_back(entry.entity, active.entity);
+            }
+        }
+
+        active_.push_back(endpoint.entry);
+    }
+
+    auto rebuild_order = [this](const Pair& lhs, const Pair& rhs)
+    {
+        const auto lhs_first = entry_for_id_[lhs.first->get_id()];
+        const auto rhs_first = entry_for_id_[rhs.first->get_id()];
+        if (lhs_first != rhs_first) {
+            return lhs_first < rhs_first;
+        }
+        return entry_for_id_[lhs.second->get_id()] < entry_for_id_[rhs.second->get_id()];
+    };
+    std::sort(pairs.begin() + first, pairs.end(), rebuild_order);
+}
+
+void
+SweepAndPrune::set_bounds(Entry& entry, const Entity& entity)
+{
+    const auto box = entity.get_component<Physics>()->get_box();
+    const auto min = box.get_min_corner();
+    const auto max = box.get_max_corner();
+
+    entry.min[0] = min.x;
+    entry.min[1] = min.y;
+    entry.max[0] = max.x;
+    entry.max[1] = max.y;
+}
+
+void
+SweepAndPrune::sort_axis(int axis)
+{
+    auto& endpoints = endpoints_[axis];
+
+    // insertion sort, as the endpoints are mostly in order from the last frame
+    for (std::size_t ndx = 1; ndx < endpoints.size(); ++ndx) {
+        const auto endpoint = endpoints[ndx];
+
+        auto at = ndx;
+        while (at > 0 && endpoint < endpoints[at - 1]) {
+            endpoints[at] = endpoints[at - 1];
+            --at;
+        }
+        endpoints[at] = endpoint;
+    }
+
+    for (std::size_t ndx = 0; ndx < endpoints.size(); ++ndx) {
+        place(axis, ndx);
+    }
+}
+
+void
+SweepAndPrune::bubble(int axis, std::size_t at)
+{
+    auto& endpoints = endpoints_[axis];
+
+    while (at > 0 && endpoints[at] < endpoints[at - 1]) {
+        std::swap(endpoints[at], endpoints[at - 1]);
+        place(axis, at);
+        place(axis, --at);
+    }
+
+    while (at + 1 < endpoints.size() && endpoints[at + 1] < endpoints[at]) {
+        std::swap(endpoints[at], endpoints[at + 1]);
+        place(axis, at);
+        place(axis, ++at);
+    }
+}
+
+void
+SweepAndPrune::place(int axis, std::size_t at)
+{
+    const auto& endpoint = endpoints_[axis][at];
+    auto& entry = entries_[endpoint.entry];
+
+    if (endpoint.is_max) {
+        entry.max_at[axis] = at;
+    } else {
+        entry.min_at[axis] = at;
+    }
+}
+
+void
+SweepAndPrune::choose_sweep_axis()
+{
+    // sweep along the axis with the most spread, so the fewest boxes overlap along it
+    float sum[2] = {0.f, 0.f};
+    float sum_squares[2] = {0.f, 0.f};
+
+    for(const auto& entry : entries_) {
+        for (int axis = 0; axis < 2; ++axis) {
+            const auto center = (entry.min[axis] + entry.max[axis]) / 2.f;
+            sum[axis] += center;
+            sum_squares[axis] += center * center;
+        }
+    }
+
+    const auto count = static_cast<float>(std::max<std::size_t>(entries_.size(), 1));
+    const auto variance_x = sum_squares[0] / count - (sum[0] / count) * (sum[0] / count);
+    const auto variance_y = sum_squares[1] / count - (sum[1] / count) * (sum[1] / count);
+    sweep_axis_ = variance_y > variance_x ? 1 : 0;
+
+    large_.clear();
+    max_extent_ = 0.f;
+    for (std::size_t ndx = 0; ndx < entries_.size(); ++ndx) {
+        auto& entry = entries_[ndx];
+        const auto extent = entry.max[sweep_axis_] - entry.min[sweep_axis_];
+
+        entry.is_large = extent > large_extent_;
+        if (entry.is_large) {
+            large_.push_back(ndx);
+        } else {
+            max_extent_ = std::max(max_extent_, extent);
+        }
+    }
+}
+
+bool
+SweepAndPrune::overlaps(const Entry& entry, const float min[2], const float max[2]) const
+{
+    return entry.min[0] <= max[0] && entry.max[0] >= min[0] &&
+           entry.min[1] <= max[1] && entry.max[1] >= min[1];
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <utility>
+#include <vector>
+
+#include <SFML/System/Vector2.hpp>
+
+#include "AABB.hpp"
+#include "broad_phase.hpp"
+#include "entity.hpp"
+
+/** \brief Sweep and prune broad phase for collision queries.
+ *
+ * The min and max endpoints of every entity's box are kept sorted along both the x and y axis.
+ * Entities move little from one frame to the next, so the endpoint lists are nearly sorted already
+ * when rebuilt, and are restored with an insertion sort rather than sorted from scratch.
+ *
+ * Queries and pairs are swept along whichever axis the entities are most spread out on. Unlike a
+ * uniform grid, the cost does not depend on how many entities crowd into the same few cells, so
+ * it holds up when enemies cluster around the player. */
+class SweepAndPrune : public BroadPhaseIF
+{
+public:
+    using Pair  = std::pair<Entity*, Entity*>;
+    using Pairs = std::vector<Pair>;
+
+    /** \param[in] large_extent Entities longer than this along the sweep axis are tested
+     *                          separately, so they don't widen the range every query scans. */
+    SweepAndPrune(float large_extent = 200.f);
+    virtual ~SweepAndPrune() = default;
+
+    void clear() override;
+
+    /** \brief Syncs with the given entities, keeping the sorted endpoints from the last rebuild.
+     *
+     * Entities which are gone are dropped, new entities are added, and the endpoints are re-sorted
+     * from their previous order. */
+    void rebuild(const Entities& entities) override;
+
+    /** \brief Moves the endpoints of the given entity to their sorted positions.
+     *
+     * Only the entity's own endpoints are moved, by as many places as it passed other endpoints. */
+    void update(const Entity& entity) override;
+
+    /** \brief Collects the entities whose boxes overlap the state space of the given box. */
+    void query(const AABB& box, Candidates& candidates) const override;
+
+    /** \brief Collects every pair of entities whose boxes overlap.
+     *
+     * Each pair is given once, with the first entity earlier in rebuild() order than the second.
+     * Pairs are appended sorted by the first, then the second entity, ready for
+     * Collision::narrow_test(). */
+    void pairs(Pairs& pairs) const;
+
+    inline std::size_t size() const override { return entries_.size(); }
+
+    /** \return 0 when sweeping along x, 1 when sweeping along y. */
+    inline int get_sweep_axis() const { return sweep_axis_; }
+
+private:
+    struct Entry
+    {
+        Entity* entity;
+        EntityId id;           ///< saved, as the entity may be destroyed before the next rebuild()
+        float min[2];          ///< min corner, <x, y>
+        float max[2];          ///< max corner, <x, y>
+        std::size_t min_at[2]; ///< index of the min endpoint, per axis
+        std::size_t max_at[2]; ///< index of the max endpoint, per axis
+        bool is_large;         ///< longer than large_extent_ along the sweep axis
+    };
+
+    struct Endpoint
+    {
+        float value;
+        std::size_t entry; ///< index into entries_
+        bool is_max;
+
+        /** \brief Sorts by value, with min endpoints before max endpoints of the same value, so
+         * touching boxes overlap. */
+        inline bool operator<(const Endpoint& other) const
+        {
+            return value < other.value || (value == other.value && !is_max && other.is_max);
+        }
+    };
+
+    static constexpr std::size_t NO_ENTRY = static_cast<std::size_t>(-1);
+
+    void set_bounds(Entry& entry, const Entity& entity);
+
+    void sort_axis(int axis);
+    void bubble(int axis, std::size_t at);
+    void place(int axis, std::size_t at);
+
+    void choose_sweep_axis();
+
+    bool overlaps(const Entry& entry, const float min[2], const float max[2]) const;
+
+    float large_extent_;
+    int sweep_axis_;
+    float max_extent_;                    ///< longest entry along the sweep axis, not counting large
+    std::vector<Entry> entries_;          ///< In rebuild() order
+    std::vector<Endpoint> endpoints_[2];  ///< Sorted along x and y
+    std::vector<std::size_t> large_;      ///< Indices into entries_, for large entries
+    std::vector<std::size_t> entry_for_id_; ///< Entity id -> index into entries_
+
+    std::vector<Entry> rebuilt_;       ///< Reused by rebuild(), swapped with entries_
+    std::vector<std::size_t> remap_;   ///< Reused by rebuild(), old -> new index into entries_
+    std::vector<bool> is_matched_;     ///< Reused by rebuild(), per new index into entries_
+    mutable std::vector<std::size_t> active_; ///< Reused by pairs()
+};
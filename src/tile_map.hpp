@@ -1,5 +1,12 @@
 #pragma once
 
+#include <algorithm>
+#include <cstdint>
+#include <initializer_list>
+#include <vector>
+
+#include <SFML/System/Vector2.hpp>
+
 /** \brief A Tile is either passable or not. */
 struct Tile
 {
@@ -16,5 +23,156 @@ struct Tile
     }
 };
 
-/** \brief 2D vector of tiles, [y_vector][x_vector]. */
-using TileMap = std::vector<std::vector<Tile>>;
+/** \brief 2D grid of tiles, bit-packed.
+ *
+ * Each row is a run of words, one bit per tile, set for passable tiles. Bits past the end of a row
+ * are always clear, so whole rows can be compared, and rectangles tested, a word at a time. Every
+ * location outside the map is impassable. */
+class TileMap
+{
+public:
+    using Word = std::uint64_t;
+    static constexpr int WORD_BITS = 64;
+
+    TileMap() :
+        width_(0),
+        height_(0),
+        words_per_row_(0)
+    { }
+
+    /** \brief Map of the given size, with every tile set to value. */
+    TileMap(int width, int height, Tile value = Tile{true}) :
+        width_(width),
+        height_(height),
+        words_per_row_((width + WORD_BITS - 1) / WORD_BITS),
+        words_(words_per_row_ * height, 0)
+    {
+        if (value.passable) {
+            fill({0, 0}, {width, height}, value);
+        }
+    }
+
+    /** \brief Map of the given rows, [y][x]. Every row is the length of the first. */
+    TileMap(std::initializer_list<std::initializer_list<Tile>> rows) :
+        TileMap(rows.size() == 0 ? 0 : rows.begin()->size(), rows.size(), Tile{false})
+    {
+        int y = 0;
+        for(const auto& row : rows) {
+            int x = 0;
+            for(const auto tile : row) {
+                set({x++, y}, tile);
+            }
+            ++y;
+        }
+    }
+
+    ~TileMap() = default;
+
+    inline int get_width() const { return width_; }
+    inline int get_height() const { return height_; }
+    inline bool empty() const { return width_ == 0 || height_ == 0; }
+
+    /** \return true iff the given tile is inside the map. */
+    inline bool contains(const sf::Vector2i& tile) const
+    {
+        return tile.x >= 0 && tile.x < width_ && tile.y >= 0 && tile.y < height_;
+    }
+
+    /** \return true iff the given tile is inside the map and passable. */
+    inline bool is_passable(const sf::Vector2i& tile) const
+    {
+        return contains(tile) &&
+               ((get_word(tile.y, tile.x / WORD_BITS) >> (tile.x % WORD_BITS)) & 1);
+    }
+
+    /** \return The given tile, impassable outside the map. */
+    inline Tile get(const sf::Vector2i& tile) const { return Tile{is_passable(tile)}; }
+
+    /** \brief Sets the given tile, which must be inside the map. */
+    inline void set(const sf::Vector2i& tile, Tile value)
+    {
+        const Word bit = Word(1) << (tile.x % WORD_BITS);
+        auto& word = words_[tile.y * words_per_row_ + tile.x / WORD_BITS];
+        word = value.passable ? (word | bit) : (word & ~bit);
+    }
+
+    /** \brief Sets every tile of the given rectangle, clipped to the map, a word at a time. */
+    inline void fill(const sf::Vector2i& min, const sf::Vector2i& dimensions, Tile value)
+    {
+        const int min_x = std::max(min.x, 0);
+        const int min_y = std::max(min.y, 0);
+        const int max_x = std::min(min.x + dimensions.x, width_);
+        const int max_y = std::min(min.y + dimensions.y, height_);
+        if (min_x >= max_x) {
+            return;
+        }
+
+        for (int y = min_y; y < max_y; ++y) {
+            for (int word = min_x / WORD_BITS; word <= (max_x - 1) / WORD_BITS; ++word) {
+                const Word mask = get_row_mask(word, min_x, max_x);
+                auto& bits = words_[y * words_per_row_ + word];
+                bits = value.passable ? (bits | mask) : (bits & ~mask);
+            }
+        }
+    }
+
+    /** \return true iff every tile of the given rectangle is inside the map and passable.
+     *
+     * An empty rectangle is always clear. */
+    inline bool is_clear(const sf::Vector2i& min, const sf::Vector2i& dimensions) const
+    {
+        if (dimensions.x <= 0 || dimensions.y <= 0) {
+            return true;
+        }
+        if (min.x < 0 || min.y < 0 ||
+            min.x + dimensions.x > width_ || min.y + dimensions.y > height_) {
+            return false;
+        }
+
+        const int max_x = min.x + dimensions.x;
+        for (int y = min.y; y < min.y + dimensions.y; ++y) {
+            for (int word = min.x / WORD_BITS; word <= (max_x - 1) / WORD_BITS; ++word) {
+                const Word mask = get_row_mask(word, min.x, max_x);
+                if ((get_word(y, word) & mask) != mask) {
+                    return false;
+                }
+            }
+        }
+
+        return true;
+    }
+
+    /** \return Bits of tiles [word * WORD_BITS, (word + 1) * WORD_BITS) of row y, set if
+     * passable. */
+    inline Word get_word(int y, int word) const { return words_[y * words_per_row_ + word]; }
+    inline int get_words_per_row() const { return words_per_row_; }
+
+    /** \return Bits of the given word which hold tiles [min_x, max_x) of a row. */
+    static inline Word get_row_mask(int word, int min_x, int max_x)
+    {
+        const int low = std::max(min_x - word * WORD_BITS, 0);
+        const int high = std::min(max_x - word * WORD_BITS, int(WORD_BITS));
+        if (low >= high) {
+            return 0;
+        }
+
+        const Word below_high = high == WORD_BITS ? ~Word(0) : (Word(1) << high) - 1;
+        return below_high & ~((Word(1) << low) - 1);
+    }
+
+    inline bool operator==(const TileMap& map) const
+    {
+        return width_ == map.width_ && height_ == map.height_ && words_ == map.words_;
+    }
+
+    inline bool operator!=(const TileMap& map) const
+    {
+        return !(*this == map);
+    }
+
+private:
+    int width_;
+    int height_;
+    int words_per_row_;
+    std::vector<Word> words_; ///< Indexed by y * words_per_row + x / WORD_BITS
+};
@@ -3,9 +3,8 @@ set(TEST_NAME "AABB_tests")
 add_executable(
     ${TEST_NAME}
     ${TEST_NAME}.cpp
-    ${CMAKE_SOURCE_DIR}/src/AABB.cpp
 )
-target_link_libraries(${TEST_NAME} ${GTEST_LIBRARIES} ${SFML_LIBRARIES})
+target_link_libraries(${TEST_NAME} shooty_face_core ${GTEST_LIBRARIES})
 
 add_test(NAME ${TEST_NAME} COMMAND ${TEST_NAME})
 
@@ -185,6 +185,43 @@ TEST_F(Collisions, WhenNarrowTestGives0_DamagesTheEntity)
     EXPECT_EQ(50.f-Bullet::DAMAGE, entity_->get_component<Health>()->get_health());
 }
 
+TEST_F(Collisions, OutOfViewWithLOD_CastsARayInstead_ThenDamagesEntity)
+{
+    entity_->add_component<Health>()->set_health(50.f);
+
+    Game::instance().set_view(AABB({1000.f, 1000.f}, {100.f, 100.f}));
+    Game::instance().set_lod_enabled(true);
+
+    ON_CALL(collision_, sanity_check(Ref(bullet_), Ref(*entity_))).WillByDefault(Return(true));
+
+    EXPECT_CALL(collision_, broad_test(_, _)).Times(0);
+    EXPECT_CALL(collision_, narrow_test(_, _)).Times(0);
+    EXPECT_CALL(collision_, ray_cast(sf::Vector2f(10.f, 10.f), sf::Vector2f(8.f, 0.f), _))
+        .WillOnce(Return(0.5f));
+
+    auto ret = sut.update(sf::seconds(2.f));
+    EXPECT_EQ(sf::seconds(1.f), ret);
+
+    EXPECT_TRUE(bullet_.is_dead());
+    EXPECT_EQ(50.f-Bullet::DAMAGE, entity_->get_component<Health>()->get_health());
+}
+
+TEST_F(Collisions, InViewWithLOD_DoesNarrowTest)
+{
+    auto box = bullet_.get_component<Physics>()->get_box(2.f);
+
+    Game::instance().set_lod_enabled(true);
+
+    ON_CALL(collision_, sanity_check(Ref(bullet_), Ref(*entity_))).WillByDefault(Return(true));
+    ON_CALL(collision_, broad_test(box, _)).WillByDefault(Return(true));
+
+    EXPECT_CALL(collision_, ray_cast(_, _, _)).Times(0);
+    EXPECT_CALL(collision_, narrow_test(box, _)).WillOnce(Return(1.f));
+
+    auto ret = sut.update(sf::seconds(2.f));
+    EXPECT_EQ(sf::seconds(2.f), ret);
+}
+
 class MultiCollisions : public TestableAIBullet
 {
 protected:
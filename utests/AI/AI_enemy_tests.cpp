@@ -3,6 +3,10 @@
 
 #include "AI/AI_enemy.hpp"
 
+#include <chrono>
+#include <thread>
+
+#include "barrier.hpp"
 #include "enemy.hpp"
 #include "mocks/collision_mock.hpp"
 #include "mocks/entity_mock.hpp"
@@ -25,6 +29,33 @@ protected:
     {
         ON_CALL(*rate_limit_, check()).WillByDefault(Return(true));
     }
+
+    /** \return true iff the last prepare() refreshed the path, to be read by the next refresh(). */
+    bool has_refreshed_path() const { return sut.flow_field_ != nullptr; }
+
+    /** \return How the last path requested was searched for. */
+    PathService::Search get_search() const { return sut.request_.search; }
+
+    bool has_path() const { return sut.has_path_; }
+
+    /** \brief Requests a path once, then prepares until it is collected.
+     *
+     * \return Number of paths cached, once it is. */
+    std::size_t request_and_collect_path()
+    {
+        auto& cache = AIEnemy::get_path_cache();
+        cache.clear();
+        EXPECT_CALL(*rate_limit_, check()).WillOnce(Return(true)).WillRepeatedly(Return(false));
+
+        sut.prepare();
+        for (int wait = 0; wait < 1000 && sut.is_waiting_; ++wait) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            sut.prepare();
+        }
+        EXPECT_FALSE(sut.is_waiting_);
+
+        return cache.get_size();
+    }
 };
 
 
@@ -108,6 +139,107 @@ TEST_F(Update, TracksThePlayerPosition)
     EXPECT_EQ(sf::Vector2f(10.f, 20.f), physics->get_position());
 }
 
+TEST_F(Update, WithPathRequests_TracksThePlayerUntilAPathIsReady)
+{
+    AIEnemy::set_navigation(AIEnemy::Navigation::PATH_REQUEST);
+    auto* physics = enemy_.get_component<Physics>();
+
+    sut.prepare();
+    sut.refresh(sf::seconds(0.5f));
+    auto dt_used = sut.update(sf::seconds(0.5f));
+
+    EXPECT_EQ(sf::seconds(0.5f), dt_used);
+    EXPECT_EQ(sf::Vector2f(11.5f, 22.f), physics->get_position());
+
+    // the path found is only the player's tile, so the enemy keeps tracking them
+    sut.prepare();
+    sut.refresh(sf::seconds(1.f));
+    dt_used = sut.update(sf::seconds(1.f));
+
+    EXPECT_EQ(sf::seconds(0.5f), dt_used);
+    EXPECT_EQ(sf::Vector2f(13.f, 24.f), physics->get_position());
+
+    AIEnemy::set_navigation(AIEnemy::Navigation::FLOW_FIELD);
+}
+
+TEST_F(Update, WithPathRequests_CachesThePathsFound)
+{
+    AIEnemy::set_navigation(AIEnemy::Navigation::PATH_REQUEST);
+    enemy_.get_component<Physics>()->set_position({200.f, 200.f});
+    Game::instance().sync_occupancy();
+
+    EXPECT_EQ(1, request_and_collect_path());
+
+    AIEnemy::set_navigation(AIEnemy::Navigation::FLOW_FIELD);
+}
+
+TEST_F(Update, WithPathRequests_FarFromThePlayer_SearchesOverClusters)
+{
+    AIEnemy::set_navigation(AIEnemy::Navigation::PATH_REQUEST);
+    Game::instance().sync_occupancy();
+
+    EXPECT_EQ(1, request_and_collect_path());
+    EXPECT_EQ(PathService::Search::DIRECT, get_search());
+
+    enemy_.get_component<Physics>()->set_position({800.f, 600.f});
+    EXPECT_EQ(1, request_and_collect_path());
+    EXPECT_EQ(PathService::Search::HIERARCHICAL, get_search());
+    EXPECT_TRUE(has_path());
+    const auto player_box = player_->get_component<Physics>()->get_box();
+    EXPECT_EQ(Game::get_tile_for(player_box.get_min_corner()), sut.get_path().back());
+
+    AIEnemy::set_navigation(AIEnemy::Navigation::FLOW_FIELD);
+}
+
+TEST_F(Update, WithPathRequests_FromInsideAnObstacle_DoesNotCacheThePath)
+{
+    AIEnemy::set_navigation(AIEnemy::Navigation::PATH_REQUEST);
+    enemy_.get_component<Physics>()->set_position({200.f, 200.f});
+
+    // the enemy was pushed into the barrier, and only it may search out through it
+    auto* barrier = new Barrier;
+    barrier->get_component<Physics>()->set_position({210.f, 210.f});
+    barrier->get_component<Physics>()->set_dimensions({40.f, 40.f});
+    Game::instance().entity_collection().emplace_back(barrier);
+    Game::instance().sync_occupancy();
+
+    EXPECT_EQ(0, request_and_collect_path());
+
+    AIEnemy::set_navigation(AIEnemy::Navigation::FLOW_FIELD);
+}
+
+TEST_F(Update, OutOfViewWithLOD_RefreshesThePathLessOften)
+{
+    Game::instance().set_view(AABB({1000.f, 1000.f}, {100.f, 100.f}));
+    Game::instance().set_lod_enabled(true);
+
+    // the first refresh is never skipped, so a new enemy has a path
+    for (int refresh = 0; refresh < 2 * AIEnemy::OFF_SCREEN_REFRESH_DIVISOR; ++refresh) {
+        sut.prepare();
+        EXPECT_EQ(refresh % AIEnemy::OFF_SCREEN_REFRESH_DIVISOR == 0, has_refreshed_path());
+        sut.refresh(sf::seconds(0.5f));
+    }
+
+    // back in view, every refresh is done
+    Game::instance().set_view(AABB({0.f, 0.f}, {100.f, 100.f}));
+    for (int refresh = 0; refresh < AIEnemy::OFF_SCREEN_REFRESH_DIVISOR; ++refresh) {
+        sut.prepare();
+        EXPECT_TRUE(has_refreshed_path());
+        sut.refresh(sf::seconds(0.5f));
+    }
+}
+
+TEST_F(Update, OutOfViewWithoutLOD_RefreshesThePathEveryTime)
+{
+    Game::instance().set_view(AABB({1000.f, 1000.f}, {100.f, 100.f}));
+
+    for (int refresh = 0; refresh < AIEnemy::OFF_SCREEN_REFRESH_DIVISOR; ++refresh) {
+        sut.prepare();
+        EXPECT_TRUE(has_refreshed_path());
+        sut.refresh(sf::seconds(0.5f));
+    }
+}
+
 class Collisions : public TestableAIEnemy
 {
 protected:
@@ -1,3 +1,6 @@
+#include <chrono>
+#include <iostream>
+
 #include <gtest.h>
 #include <gmock.h>
 
@@ -69,7 +72,7 @@ TEST_F(OneDimensionalMapInY, UnblockedFromStartToFinish_BecauseStartIsEnd)
     sf::Vector2i start = {0, 0};
     sf::Vector2i end   = {0, 0};
     ASSERT_EQ(start, end);
-    EXPECT_EQ(map.at(start.y).at(start.x), st);
+    EXPECT_EQ(map.get(start), st);
 
     auto path = AStar::run(start, end, dimensions, map);
 
@@ -83,8 +86,8 @@ TEST_F(OneDimensionalMapInY, UnblockedFromStartToFinish_BecausePathIsPassable)
 {
     sf::Vector2i start = {0, 0};
     sf::Vector2i end   = {3, 0};
-    ASSERT_EQ(map.at(start.y).at(start.x), st);
-    ASSERT_EQ(map.at(end.y).at(end.x), nd);
+    ASSERT_EQ(map.get(start), st);
+    ASSERT_EQ(map.get(end), nd);
 
     auto path = AStar::run(start, end, dimensions, map);
 
@@ -115,7 +118,7 @@ TEST_F(OneDimensionalMapInX, UnblockedFromStartToFinish_BecauseStartIsEnd)
     sf::Vector2i start = {0, 0};
     sf::Vector2i end   = {0, 0};
     ASSERT_EQ(start, end);
-    EXPECT_EQ(map.at(start.y).at(start.x), st);
+    EXPECT_EQ(map.get(start), st);
 
     auto path = AStar::run(start, end, dimensions, map);
 
@@ -129,8 +132,8 @@ TEST_F(OneDimensionalMapInX, UnblockedFromStartToFinish_BecausePathIsPassable)
 {
     sf::Vector2i start = {0, 0};
     sf::Vector2i end   = {0, 3};
-    ASSERT_EQ(map.at(start.y).at(start.x), st);
-    ASSERT_EQ(map.at(end.y).at(end.x), nd);
+    ASSERT_EQ(map.get(start), st);
+    ASSERT_EQ(map.get(end), nd);
 
     auto path = AStar::run(start, end, dimensions, map);
 
@@ -171,8 +174,8 @@ TEST_F(NarrowPassages, EntityIsSmallerThanGapWidth_HasPath)
 {
     sf::Vector2i start = {0, 1};
     sf::Vector2i end   = {4, 1};
-    ASSERT_EQ(passable.at(start.y).at(start.x), st);
-    ASSERT_EQ(passable.at(end.y).at(end.x), nd);
+    ASSERT_EQ(passable.get(start), st);
+    ASSERT_EQ(passable.get(end), nd);
 
     auto path = AStar::run(start, end, dimensions, passable);
 
@@ -190,8 +193,8 @@ TEST_F(NarrowPassages, EntityIsTooWideToFitThroughNarrowGap_HasNoPath)
 {
     sf::Vector2i start = {0, 1};
     sf::Vector2i end   = {4, 1};
-    ASSERT_EQ(impassable.at(start.y).at(start.x), st);
-    ASSERT_EQ(impassable.at(end.y).at(end.x), nd);
+    ASSERT_EQ(impassable.get(start), st);
+    ASSERT_EQ(impassable.get(end), nd);
 
     auto path = AStar::run(start, end, dimensions, impassable);
 
@@ -217,8 +220,8 @@ TEST_F(VerticalObstables, NavigatesAroundThem)
 {
     sf::Vector2i start = {0, 3};
     sf::Vector2i end   = {6, 3};
-    ASSERT_EQ(map.at(start.y).at(start.x), st);
-    ASSERT_EQ(map.at(end.y).at(end.x), nd);
+    ASSERT_EQ(map.get(start), st);
+    ASSERT_EQ(map.get(end), nd);
 
     auto path = AStar::run(start, end, dimensions, map);
 
@@ -267,8 +270,8 @@ TEST_F(HorizontalObstables, NavigatesAroundThem)
 {
     sf::Vector2i start = {0, 6};
     sf::Vector2i end   = {0, 0};
-    ASSERT_EQ(map.at(start.y).at(start.x), st);
-    ASSERT_EQ(map.at(end.y).at(end.x), nd);
+    ASSERT_EQ(map.get(start), st);
+    ASSERT_EQ(map.get(end), nd);
 
     auto path = AStar::run(start, end, dimensions, map);
 
@@ -317,8 +320,8 @@ TEST_F(LargeOpenSpace, FindsMostDirectRoute)
 {
     sf::Vector2i start = {0, 5};
     sf::Vector2i end   = {5, 0};
-    ASSERT_EQ(map.at(start.y).at(start.x), st);
-    ASSERT_EQ(map.at(end.y).at(end.x), nd);
+    ASSERT_EQ(map.get(start), st);
+    ASSERT_EQ(map.get(end), nd);
 
     auto path = AStar::run(start, end, dimensions, map);
 
@@ -337,3 +340,193 @@ TEST_F(LargeOpenSpace, FindsMostDirectRoute)
     EXPECT_EQ(sf::Vector2i({4, 0}), path.path[9]);
     EXPECT_EQ(sf::Vector2i(end),    path.path[10]);
 }
+
+class RepeatedRuns : public TestableAStar
+{
+protected:
+    sf::Vector2i dimensions = {1, 1};
+
+    TileMap wide = {
+   /*    0   1   2   3  */
+   /*0*/{st, go, go, nd},
+   /*1*/{go, go, go, go},
+    };
+
+    TileMap narrow = {
+   /*    0   1  */
+   /*0*/{st, no},
+   /*1*/{go, no},
+   /*2*/{no, nd},
+    };
+};
+
+TEST_F(RepeatedRuns, StateFromPreviousRunsDoesNotLeakIntoTheNext)
+{
+    EXPECT_TRUE(AStar::run({0, 0}, {3, 0}, dimensions, wide).has_path);
+
+    // (1, 1) was reached in the previous run, but is impassable here
+    EXPECT_FALSE(AStar::run({0, 0}, {1, 2}, dimensions, narrow).has_path);
+
+    auto path = AStar::run({0, 0}, {3, 0}, dimensions, wide);
+    EXPECT_TRUE(path.has_path);
+    EXPECT_EQ(4, path.path.size());
+}
+
+class JumpPointSearch : public TestableAStar
+{
+protected:
+    /** \brief Checks that the given path is a contiguous 4-connected walk from start to end. */
+    void expect_walk(const AStar::Path& path, sf::Vector2i start, sf::Vector2i end)
+    {
+        ASSERT_FALSE(path.empty());
+        EXPECT_EQ(start, path.front());
+        EXPECT_EQ(end, path.back());
+
+        for (std::size_t ndx = 1; ndx < path.size(); ++ndx) {
+            const auto step = path[ndx] - path[ndx - 1];
+            EXPECT_EQ(1, std::abs(step.x) + std::abs(step.y)) << "at " << ndx;
+        }
+    }
+};
+
+TEST_F(JumpPointSearch, NavigatesAroundObstacles_WithTheShortestPath)
+{
+    sf::Vector2i dimensions = {1, 2};
+    TileMap map = {
+   /*    0   1   2   3   4   5   6  */
+   /*0*/{go, go, go, no, go, go, go},
+   /*1*/{go, go, go, no, go, go, go},
+   /*2*/{go, no, go, no, go, no, go},
+   /*3*/{st, no, go, go, go, no, nd},
+   /*4*/{st, no, go, go, go, no, nd},
+    };
+
+    auto path = AStar::run({0, 3}, {6, 3}, dimensions, map, AStar::Mode::JUMP_POINT);
+
+    EXPECT_TRUE(path.has_path);
+    EXPECT_EQ(19, path.path.size());
+    expect_walk(path.path, {0, 3}, {6, 3});
+}
+
+TEST_F(JumpPointSearch, EntityIsTooWideToFitThroughNarrowGap_HasNoPath)
+{
+    sf::Vector2i dimensions = {1, 3};
+    TileMap map = {
+        {no, no, no, no, no},
+        {st, go, go, go, nd},
+        {st, go, go, go, nd},
+        {st, go, no, go, nd},
+        {no, no, no, no, no},
+    };
+
+    EXPECT_FALSE(AStar::run({0, 1}, {4, 1}, dimensions, map, AStar::Mode::JUMP_POINT).has_path);
+}
+
+TEST_F(JumpPointSearch, FindsPathsAsShortAsAStar)
+{
+    std::srand(11);
+
+    for (int trial = 0; trial < 50; ++trial) {
+        TileMap map(24, 24);
+        for (int y = 0; y < map.get_height(); ++y) {
+            for (int x = 0; x < map.get_width(); ++x) {
+                if (std::rand() % 4 == 0) {
+                    map.set({x, y}, no);
+                }
+            }
+        }
+
+        const sf::Vector2i dimensions(1 + trial % 2, 1 + (trial / 2) % 2);
+        const sf::Vector2i start(std::rand() % 20, std::rand() % 20);
+        const sf::Vector2i end(std::rand() % 20, std::rand() % 20);
+        for (int y = 0; y < dimensions.y; ++y) {
+            for (int x = 0; x < dimensions.x; ++x) {
+                map.set({start.x + x, start.y + y}, go);
+            }
+        }
+
+        auto expected = AStar::run(start, end, dimensions, map);
+        auto actual = AStar::run(start, end, dimensions, map, AStar::Mode::JUMP_POINT);
+
+        ASSERT_EQ(expected.has_path, actual.has_path) << "trial " << trial;
+        if (expected.has_path) {
+            ASSERT_EQ(expected.path.size(), actual.path.size()) << "trial " << trial;
+            expect_walk(actual.path, start, end);
+        }
+    }
+}
+
+/** \brief Times searches over large maps, built by repeating the obstacle maps above.
+ *
+ * Disabled by default, run with --gtest_also_run_disabled_tests --gtest_filter=*Benchmark*. */
+class Benchmark : public TestableAStar
+{
+protected:
+    TileMap vertical = {
+        {go, go, go, no, go, go, go},
+        {go, go, go, no, go, go, go},
+        {go, no, go, no, go, no, go},
+        {go, no, go, go, go, no, go},
+        {go, no, go, go, go, no, go},
+    };
+
+    TileMap horizontal = {
+        {go, go, go, go, go},
+        {no, no, no, go, go},
+        {go, go, go, go, go},
+        {go, go, no, no, no},
+        {go, go, go, go, go},
+        {no, no, no, go, go},
+        {go, go, go, go, go},
+    };
+
+    /** \brief Repeats the given map count times in x and y. */
+    TileMap repeat(const TileMap& shape, int count)
+    {
+        TileMap map(shape.get_width() * count, shape.get_height() * count);
+        for (int y = 0; y < map.get_height(); ++y) {
+            for (int x = 0; x < map.get_width(); ++x) {
+                map.set({x, y}, shape.get({x % shape.get_width(), y % shape.get_height()}));
+            }
+        }
+
+        return map;
+    }
+
+    /** \brief Prints the mean time of a search between opposite corners of the given map. */
+    void time(const char* name, const TileMap& map, const sf::Vector2i& dimensions,
+              AStar::Mode mode)
+    {
+        const sf::Vector2i start(0, 0);
+        const sf::Vector2i end(map.get_width() - dimensions.x, map.get_height() - dimensions.y);
+        ASSERT_TRUE(AStar::run(start, end, dimensions, map, mode).has_path) << name;
+
+        // the clearance is built once, so only the search itself is timed
+        ClearanceMap clearance;
+        clearance.build(map);
+
+        const int runs = 50;
+        const auto begin = std::chrono::steady_clock::now();
+        for (int run = 0; run < runs; ++run) {
+            AStar::run(start, end, dimensions, clearance, mode);
+        }
+        const std::chrono::duration<double, std::micro> elapsed =
+            std::chrono::steady_clock::now() - begin;
+
+        std::cout << name << (mode == AStar::Mode::JUMP_POINT ? " (jump point): " : ": ")
+                  << elapsed.count() / runs << " us" << std::endl;
+    }
+};
+
+TEST_F(Benchmark, DISABLED_Frontier)
+{
+    const auto open = TileMap(140, 140);
+    const auto vertical_map = repeat(vertical, 20);
+    const auto horizontal_map = repeat(horizontal, 20);
+
+    for(auto mode : {AStar::Mode::A_STAR, AStar::Mode::JUMP_POINT}) {
+        time("open space", open, {2, 2}, mode);
+        time("vertical obstacles", vertical_map, {1, 1}, mode);
+        time("horizontal obstacles", horizontal_map, {1, 1}, mode);
+    }
+}
@@ -0,0 +1,104 @@
+#include <gtest.h>
+#include <gmock.h>
+
+#include "AI/clearance_map.hpp"
+
+using namespace testing;
+
+class TestableClearanceMap : public Test
+{
+protected:
+    Tile go = {true};
+    Tile no = {false};
+
+    TileMap map = {
+   /*    0   1   2   3   4  */
+   /*0*/{go, go, go, no, go},
+   /*1*/{go, go, go, go, go},
+   /*2*/{go, go, go, go, go},
+   /*3*/{no, go, go, go, no},
+    };
+
+    ClearanceMap sut;
+
+    TestableClearanceMap() :
+        sut(map)
+    { }
+};
+
+class Build : public TestableClearanceMap { };
+
+TEST_F(Build, ClearanceIsTheLargestPassableSquareFromEachTile)
+{
+    const std::vector<std::vector<int>> expected = {
+        {3, 2, 1, 0, 1},
+        {2, 3, 2, 2, 1},
+        {1, 2, 2, 1, 1},
+        {0, 1, 1, 1, 0},
+    };
+
+    for (int y = 0; y < sut.get_height(); ++y) {
+        for (int x = 0; x < sut.get_width(); ++x) {
+            EXPECT_EQ(expected[y][x], sut.get_clearance({x, y})) << "at " << x << ", " << y;
+        }
+    }
+}
+
+TEST_F(Build, TilesOutsideTheMapHaveNoClearance)
+{
+    EXPECT_EQ(0, sut.get_clearance({-1, 0}));
+    EXPECT_EQ(0, sut.get_clearance({0, -1}));
+    EXPECT_EQ(0, sut.get_clearance({5, 0}));
+    EXPECT_EQ(0, sut.get_clearance({0, 4}));
+}
+
+TEST_F(Build, RebuildingReplacesThePreviousMap)
+{
+    sut.build({{go, go}, {go, go}});
+
+    EXPECT_EQ(2, sut.get_width());
+    EXPECT_EQ(2, sut.get_height());
+    EXPECT_EQ(2, sut.get_clearance({0, 0}));
+    EXPECT_EQ(0, sut.get_clearance({2, 0}));
+}
+
+class Fits : public TestableClearanceMap { };
+
+TEST_F(Fits, SquareAgents)
+{
+    EXPECT_TRUE(sut.fits({0, 0}, {1, 1}));
+    EXPECT_FALSE(sut.fits({3, 0}, {1, 1}));
+
+    EXPECT_TRUE(sut.fits({1, 1}, {2, 2}));
+    EXPECT_FALSE(sut.fits({2, 0}, {2, 2}));
+
+    EXPECT_TRUE(sut.fits({1, 1}, {3, 3}));
+    EXPECT_FALSE(sut.fits({0, 0}, {4, 4}));
+}
+
+TEST_F(Fits, WideAgents)
+{
+    EXPECT_TRUE(sut.fits({0, 1}, {5, 1}));
+    EXPECT_FALSE(sut.fits({0, 0}, {5, 1}));
+
+    EXPECT_TRUE(sut.fits({0, 1}, {4, 2}));
+    EXPECT_TRUE(sut.fits({1, 1}, {3, 2}));
+    EXPECT_FALSE(sut.fits({1, 0}, {3, 2}));
+    EXPECT_FALSE(sut.fits({1, 2}, {4, 2}));
+}
+
+TEST_F(Fits, TallAgents)
+{
+    EXPECT_TRUE(sut.fits({1, 0}, {1, 4}));
+    EXPECT_FALSE(sut.fits({0, 0}, {1, 4}));
+
+    EXPECT_TRUE(sut.fits({1, 0}, {2, 4}));
+    EXPECT_FALSE(sut.fits({3, 0}, {2, 3}));
+}
+
+TEST_F(Fits, AgentsHangingOffTheMapDoNotFit)
+{
+    EXPECT_FALSE(sut.fits({4, 1}, {2, 1}));
+    EXPECT_FALSE(sut.fits({1, 3}, {1, 2}));
+    EXPECT_FALSE(sut.fits({-1, 1}, {2, 1}));
+}
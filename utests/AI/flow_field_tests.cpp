@@ -0,0 +1,288 @@
+#include <gtest.h>
+#include <gmock.h>
+
+#include "AI/flow_field.hpp"
+
+using namespace testing;
+
+class TestableFlowField : public Test
+{
+protected:
+    Tile go = {true};
+    Tile no = {false};
+
+    TileMap map = {
+   /*    0   1   2   3   4   5  */
+   /*0*/{go, go, go, no, go, go},
+   /*1*/{go, go, go, no, go, go},
+   /*2*/{go, go, go, no, go, go},
+   /*3*/{go, go, go, go, go, go},
+   /*4*/{no, no, go, go, no, go},
+    };
+
+    FlowField sut;
+};
+
+class Update : public TestableFlowField { };
+
+TEST_F(Update, DistanceIsStepsToTheGoal)
+{
+    sut.update({4, 0}, {1, 1}, map);
+
+    const std::vector<std::vector<int>> expected = {
+        {10,  9,  8, -1,  0,  1},
+        { 9,  8,  7, -1,  1,  2},
+        { 8,  7,  6, -1,  2,  3},
+        { 7,  6,  5,  4,  3,  4},
+        {-1, -1,  6,  5, -1,  5},
+    };
+
+    for (int y = 0; y < 5; ++y) {
+        for (int x = 0; x < 6; ++x) {
+            EXPECT_EQ(expected[y][x], sut.get_distance({x, y})) << "at " << x << ", " << y;
+        }
+    }
+}
+
+TEST_F(Update, TilesOutsideTheMapAreUnreachable)
+{
+    sut.update({4, 0}, {1, 1}, map);
+
+    EXPECT_EQ(FlowField::NO_PATH, sut.get_distance({-1, 0}));
+    EXPECT_EQ(FlowField::NO_PATH, sut.get_distance({6, 0}));
+    EXPECT_EQ(FlowField::NO_PATH, sut.get_distance({0, 5}));
+}
+
+TEST_F(Update, LargeAgentsOnlyPassWhereTheyFit)
+{
+    sut.update({4, 0}, {2, 2}, map);
+
+    // the gap below the wall is too narrow for the larger agent
+    EXPECT_EQ(0, sut.get_distance({4, 0}));
+    EXPECT_EQ(2, sut.get_distance({4, 2}));
+    EXPECT_EQ(FlowField::NO_PATH, sut.get_distance({0, 0}));
+    EXPECT_EQ(FlowField::NO_PATH, sut.get_distance({5, 0}));
+}
+
+TEST_F(Update, GoalIsReachedEvenWhereTheAgentDoesNotFit)
+{
+    sut.update({5, 0}, {2, 2}, map);
+
+    EXPECT_EQ(0, sut.get_distance({5, 0}));
+    EXPECT_EQ(1, sut.get_distance({4, 0}));
+}
+
+TEST_F(Update, UnchangedGoalAndMap_DoesNotSearchAgain)
+{
+    EXPECT_TRUE(sut.update({4, 0}, {1, 1}, map));
+    EXPECT_FALSE(sut.update({4, 0}, {1, 1}, map));
+    EXPECT_EQ(1, sut.get_build_count());
+
+    EXPECT_TRUE(sut.update({0, 0}, {1, 1}, map));
+    EXPECT_EQ(10, sut.get_distance({4, 0}));
+    EXPECT_EQ(2, sut.get_build_count());
+}
+
+class Repair : public TestableFlowField { };
+
+TEST_F(Repair, ChangedTiles_AreRepairedWithoutSearchingAgain)
+{
+    sut.update({0, 0}, {1, 1}, map);
+
+    map.set({3, 3}, no);
+    EXPECT_TRUE(sut.update({0, 0}, {1, 1}, map));
+    EXPECT_EQ(FlowField::NO_PATH, sut.get_distance({4, 0}));
+    EXPECT_EQ(FlowField::NO_PATH, sut.get_distance({3, 3}));
+    EXPECT_EQ(7, sut.get_distance({3, 4}));
+
+    map.set({3, 3}, go);
+    map.set({3, 1}, go);
+    EXPECT_TRUE(sut.update({0, 0}, {1, 1}, map));
+    EXPECT_EQ(6, sut.get_distance({4, 0}));
+    EXPECT_EQ(6, sut.get_distance({3, 3}));
+
+    EXPECT_EQ(1, sut.get_build_count());
+}
+
+TEST_F(Repair, SmallChangesToALargeMap_ExpandOnlyNearbyTiles)
+{
+    TileMap large(300, 300);
+    sut.update({0, 0}, {2, 2}, large);
+
+    large.set({150, 150}, no);
+    sut.update({0, 0}, {2, 2}, large);
+
+    // every location the agent would cover the tile from is blocked
+    EXPECT_EQ(FlowField::NO_PATH, sut.get_distance({149, 149}));
+    EXPECT_EQ(FlowField::NO_PATH, sut.get_distance({150, 150}));
+    EXPECT_EQ(301, sut.get_distance({151, 150}));
+    EXPECT_EQ(1, sut.get_build_count());
+    EXPECT_LT(sut.get_expanded_count(), 20);
+}
+
+TEST_F(Repair, MatchesAFreshSearch)
+{
+    std::srand(3);
+
+    for (int trial = 0; trial < 20; ++trial) {
+        TileMap random(24, 24);
+        for (int y = 0; y < random.get_height(); ++y) {
+            for (int x = 0; x < random.get_width(); ++x) {
+                if (std::rand() % 5 == 0) {
+                    random.set({x, y}, no);
+                }
+            }
+        }
+
+        const sf::Vector2i dimensions(1 + trial % 2, 1 + trial % 3 / 2);
+        const sf::Vector2i goal(std::rand() % 24, std::rand() % 24);
+        FlowField repaired;
+        repaired.update(goal, dimensions, random);
+
+        for (int step = 0; step < 10; ++step) {
+            // flip a few tiles, sometimes walling off or opening up whole regions
+            for (int flip = 0; flip < 1 + std::rand() % 4; ++flip) {
+                const sf::Vector2i tile(std::rand() % 24, std::rand() % 24);
+                random.set(tile, Tile{!random.is_passable(tile)});
+            }
+
+            FlowField fresh;
+            fresh.update(goal, dimensions, random);
+            repaired.update(goal, dimensions, random);
+
+            for (int y = 0; y < 24; ++y) {
+                for (int x = 0; x < 24; ++x) {
+                    ASSERT_EQ(fresh.get_distance({x, y}), repaired.get_distance({x, y}))
+                        << "trial " << trial << ", step " << step << " at " << x << ", " << y;
+                }
+            }
+        }
+
+        EXPECT_EQ(1, repaired.get_build_count());
+    }
+}
+
+class MoveGoal : public TestableFlowField { };
+
+TEST_F(MoveGoal, AFewSteps_MovesTheFieldWithoutSearchingAgain)
+{
+    sut.update({0, 0}, {1, 1}, map);
+
+    EXPECT_TRUE(sut.update({2, 1}, {1, 1}, map));
+    EXPECT_EQ(0, sut.get_distance({2, 1}));
+    EXPECT_EQ(3, sut.get_distance({0, 0}));
+    EXPECT_EQ(7, sut.get_distance({4, 0}));
+    EXPECT_EQ(1, sut.get_build_count());
+
+    // further than MAX_GOAL_STEPS
+    EXPECT_TRUE(sut.update({5, 0}, {1, 1}, map));
+    EXPECT_EQ(11, sut.get_distance({0, 0}));
+    EXPECT_EQ(2, sut.get_build_count());
+}
+
+TEST_F(MoveGoal, AgentDoesNotFitOnTheOldGoal_SearchesAgain)
+{
+    sut.update({2, 0}, {2, 2}, map);
+
+    // the agent would cover the wall at {3, 0}, so only fits there while it is the goal
+    EXPECT_TRUE(sut.update({1, 0}, {2, 2}, map));
+    EXPECT_EQ(0, sut.get_distance({1, 0}));
+    EXPECT_EQ(FlowField::NO_PATH, sut.get_distance({2, 0}));
+    EXPECT_EQ(2, sut.get_build_count());
+}
+
+TEST_F(MoveGoal, MatchesAFreshSearch)
+{
+    std::srand(7);
+
+    for (int trial = 0; trial < 20; ++trial) {
+        TileMap random(24, 24);
+        for (int y = 0; y < random.get_height(); ++y) {
+            for (int x = 0; x < random.get_width(); ++x) {
+                if (std::rand() % 5 == 0) {
+                    random.set({x, y}, no);
+                }
+            }
+        }
+
+        const sf::Vector2i dimensions(1 + trial % 2, 1 + trial % 3 / 2);
+        sf::Vector2i goal(std::rand() % 24, std::rand() % 24);
+        FlowField moved;
+        moved.update(goal, dimensions, random);
+
+        for (int step = 0; step < 20; ++step) {
+            // wander a few tiles, sometimes further than the goal is moved, and now and then
+            // change the map as well
+            const int reach = 1 + std::rand() % (FlowField::MAX_GOAL_STEPS + 2);
+            goal.x = std::min(std::max(goal.x + std::rand() % (2 * reach + 1) - reach, 0), 23);
+            goal.y = std::min(std::max(goal.y + std::rand() % (2 * reach + 1) - reach, 0), 23);
+            if (std::rand() % 4 == 0) {
+                const sf::Vector2i tile(std::rand() % 24, std::rand() % 24);
+                random.set(tile, Tile{!random.is_passable(tile)});
+            }
+
+            FlowField fresh;
+            fresh.update(goal, dimensions, random);
+            moved.update(goal, dimensions, random);
+
+            for (int y = 0; y < 24; ++y) {
+                for (int x = 0; x < 24; ++x) {
+                    ASSERT_EQ(fresh.get_distance({x, y}), moved.get_distance({x, y}))
+                        << "trial " << trial << ", step " << step << " at " << x << ", " << y;
+                }
+            }
+        }
+    }
+}
+
+class GetPath : public TestableFlowField { };
+
+TEST_F(GetPath, FollowsTheFieldToTheGoal)
+{
+    sut.update({4, 0}, {1, 1}, map);
+
+    AStar::Path path;
+    ASSERT_TRUE(sut.get_path({0, 0}, path));
+
+    ASSERT_EQ(11, path.size());
+    EXPECT_EQ(sf::Vector2i(0, 0), path.front());
+    EXPECT_EQ(sf::Vector2i(4, 0), path.back());
+    for (std::size_t ndx = 1; ndx < path.size(); ++ndx) {
+        const auto step = path[ndx] - path[ndx - 1];
+        EXPECT_EQ(1, std::abs(step.x) + std::abs(step.y)) << "at " << ndx;
+        EXPECT_EQ(sut.get_distance(path[ndx - 1]) - 1, sut.get_distance(path[ndx])) << "at " << ndx;
+    }
+}
+
+TEST_F(GetPath, KeepsItsHeadingOnTies)
+{
+    sut.update({2, 3}, {1, 1}, map);
+
+    AStar::Path path;
+    ASSERT_TRUE(sut.get_path({0, 0}, path));
+
+    // straight down, then straight across
+    EXPECT_THAT(path, ElementsAre(sf::Vector2i(0, 0), sf::Vector2i(0, 1), sf::Vector2i(0, 2),
+                                  sf::Vector2i(0, 3), sf::Vector2i(1, 3), sf::Vector2i(2, 3)));
+}
+
+TEST_F(GetPath, StartIsGoal)
+{
+    sut.update({4, 0}, {1, 1}, map);
+
+    AStar::Path path;
+    ASSERT_TRUE(sut.get_path({4, 0}, path));
+    EXPECT_THAT(path, ElementsAre(sf::Vector2i(4, 0)));
+}
+
+TEST_F(GetPath, UnreachableStart_HasNoPath)
+{
+    map.set({3, 3}, no);
+    sut.update({4, 0}, {1, 1}, map);
+
+    AStar::Path path = {{1, 1}};
+    EXPECT_FALSE(sut.get_path({0, 0}, path));
+    EXPECT_TRUE(path.empty());
+
+    EXPECT_FALSE(sut.get_path({3, 0}, path));
+}
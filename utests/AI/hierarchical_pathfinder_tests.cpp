@@ -0,0 +1,244 @@
+#include <gtest.h>
+#include <gmock.h>
+
+#include "AI/hierarchical_pathfinder.hpp"
+
+using namespace testing;
+
+class TestableHierarchicalPathfinder : public Test
+{
+protected:
+    Tile go = {true};
+    Tile no = {false};
+
+    HierarchicalPathfinder sut;
+
+    TestableHierarchicalPathfinder() :
+        sut(4)
+    { }
+
+    /** \brief Updates the pathfinder with a snapshot of the given map. */
+    void update(const TileMap& map)
+    {
+        sut.update(std::make_shared<const TileMap>(map));
+    }
+
+    /** \brief Finds a path over the given map, as the agent sees it. */
+    AStar::Result run(const sf::Vector2i& start, const sf::Vector2i& end,
+                      const sf::Vector2i& dimensions, const TileMap& local_map,
+                      int refine_count = 2)
+    {
+        return sut.run(start, end, dimensions, ClearanceMap(local_map), refine_count);
+    }
+
+    /** \brief Checks that the given path is a 4-connected walk from start, on which the agent
+     * fits everywhere. */
+    void expect_walk(const AStar::Path& path, sf::Vector2i start, sf::Vector2i dimensions,
+                     const TileMap& map)
+    {
+        ClearanceMap clearance(map);
+
+        ASSERT_FALSE(path.empty());
+        EXPECT_EQ(start, path.front());
+
+        for (std::size_t ndx = 1; ndx < path.size(); ++ndx) {
+            const auto step = path[ndx] - path[ndx - 1];
+            EXPECT_EQ(1, std::abs(step.x) + std::abs(step.y)) << "at " << ndx;
+            EXPECT_TRUE(clearance.fits(path[ndx], dimensions)) << "at " << ndx;
+        }
+    }
+};
+
+class Run : public TestableHierarchicalPathfinder
+{
+protected:
+    TileMap map = {
+   /*    0   1   2   3   4   5   6   7   8   9  */
+   /*0*/{go, go, go, no, go, go, go, go, go, go},
+   /*1*/{go, go, go, no, go, go, go, go, go, go},
+   /*2*/{go, go, go, no, go, go, no, no, no, go},
+   /*3*/{go, go, go, no, go, go, no, go, go, go},
+   /*4*/{go, go, go, no, go, go, no, go, go, go},
+   /*5*/{go, go, go, go, go, go, no, go, go, go},
+   /*6*/{go, go, go, no, no, no, no, go, go, go},
+   /*7*/{go, go, go, go, go, go, go, go, go, go},
+    };
+};
+
+TEST_F(Run, FindsPathsAcrossClusters)
+{
+    update(map);
+    auto result = run({0, 0}, {7, 3}, {1, 1}, map, 100);
+
+    ASSERT_TRUE(result.has_path);
+    expect_walk(result.path, {0, 0}, {1, 1}, map);
+    EXPECT_EQ(sf::Vector2i(7, 3), result.path.back());
+}
+
+TEST_F(Run, StartIsEnd)
+{
+    update(map);
+    auto result = run({1, 1}, {1, 1}, {1, 1}, map);
+
+    EXPECT_TRUE(result.has_path);
+    EXPECT_THAT(result.path, ElementsAre(sf::Vector2i(1, 1)));
+}
+
+TEST_F(Run, EndIsUnreachable_HasNoPath)
+{
+    map.set({9, 3}, no);
+    map.set({9, 4}, no);
+    map.set({9, 5}, no);
+    map.set({8, 5}, no);
+    map.set({7, 5}, no);
+    update(map);
+
+    EXPECT_FALSE(run({0, 0}, {7, 3}, {1, 1}, map).has_path);
+    EXPECT_FALSE(run({0, 0}, {3, 0}, {1, 1}, map).has_path);
+}
+
+TEST_F(Run, OnlyRefinesTheFirstLegs)
+{
+    update(map);
+    auto full = run({0, 0}, {7, 3}, {1, 1}, map, 100);
+    auto partial = run({0, 0}, {7, 3}, {1, 1}, map, 1);
+
+    ASSERT_TRUE(partial.has_path);
+    expect_walk(partial.path, {0, 0}, {1, 1}, map);
+    EXPECT_LT(partial.path.size(), full.path.size());
+}
+
+TEST_F(Run, LargeAgentsUseTheirOwnGraph)
+{
+    update(map);
+
+    // the gap at (3, 5) is too narrow for the larger agent
+    EXPECT_TRUE(run({0, 0}, {4, 0}, {1, 1}, map).has_path);
+    EXPECT_FALSE(run({0, 0}, {4, 0}, {2, 2}, map).has_path);
+
+    auto result = run({4, 0}, {4, 4}, {2, 2}, map, 100);
+    ASSERT_TRUE(result.has_path);
+    expect_walk(result.path, {4, 0}, {2, 2}, map);
+    EXPECT_EQ(sf::Vector2i(4, 4), result.path.back());
+}
+
+TEST_F(Run, SearchesNearStartAndEndOverTheLocalMap)
+{
+    auto shared = map;
+    shared.set({1, 1}, no);
+    update(shared);
+
+    // the agent itself blocks the shared map, but not its own
+    auto result = run({1, 1}, {7, 3}, {1, 1}, map, 100);
+
+    ASSERT_TRUE(result.has_path);
+    expect_walk(result.path, {1, 1}, {1, 1}, map);
+}
+
+TEST_F(Run, BeforeAnyUpdate_HasNoPath)
+{
+    EXPECT_FALSE(run({0, 0}, {7, 3}, {1, 1}, map).has_path);
+}
+
+TEST_F(Run, LocalMapOfAnotherSize_HasNoPath_AndLeavesTheGraphAsItIs)
+{
+    update(map);
+    run({0, 0}, {7, 3}, {1, 1}, map);
+    const auto snapshot = sut.get_map();
+
+    EXPECT_FALSE(run({0, 0}, {7, 3}, {1, 1}, TileMap(16, 16)).has_path);
+    EXPECT_EQ(snapshot, sut.get_map());
+
+    update(map);
+    EXPECT_EQ(0, sut.get_rebuild_count());
+}
+
+TEST_F(Run, PathsAreAsLongAsAStarAtMost_ByASmallMargin)
+{
+    std::srand(5);
+
+    for (int trial = 0; trial < 40; ++trial) {
+        TileMap random(20, 20);
+        for (int y = 0; y < random.get_height(); ++y) {
+            for (int x = 0; x < random.get_width(); ++x) {
+                if (std::rand() % 5 == 0) {
+                    random.set({x, y}, no);
+                }
+            }
+        }
+
+        const sf::Vector2i dimensions(1 + trial % 2, 1 + trial % 2);
+        const sf::Vector2i start(std::rand() % 18, std::rand() % 18);
+        const sf::Vector2i end(std::rand() % 18, std::rand() % 18);
+        for (int y = 0; y < dimensions.y; ++y) {
+            for (int x = 0; x < dimensions.x; ++x) {
+                random.set({start.x + x, start.y + y}, go);
+            }
+        }
+
+        update(random);
+        auto expected = AStar::run(start, end, dimensions, random);
+        auto actual = run(start, end, dimensions, random, 100);
+
+        ASSERT_EQ(expected.has_path, actual.has_path) << "trial " << trial;
+        if (expected.has_path) {
+            expect_walk(actual.path, start, dimensions, random);
+            ASSERT_EQ(end, actual.path.back());
+            EXPECT_GE(actual.path.size(), expected.path.size());
+            EXPECT_LE(actual.path.size(), expected.path.size() * 3 / 2 + 4) << "trial " << trial;
+        }
+    }
+}
+
+class Update : public TestableHierarchicalPathfinder
+{
+protected:
+    TileMap map = TileMap(16, 16);
+};
+
+TEST_F(Update, HoldsTheMapWithoutCopyingIt)
+{
+    auto snapshot = std::make_shared<const TileMap>(map);
+    sut.update(snapshot);
+    EXPECT_EQ(snapshot, sut.get_map());
+    EXPECT_TRUE(sut.get_clearance().fits({0, 0}, {16, 16}));
+
+    sut.run({0, 0}, {15, 15}, {1, 1}, sut.get_clearance());
+    sut.update(snapshot);
+    EXPECT_EQ(0, sut.get_rebuild_count());
+}
+
+TEST_F(Update, UnchangedMap_RebuildsNothing)
+{
+    update(map);
+    run({0, 0}, {15, 15}, {1, 1}, map);
+    EXPECT_EQ(16, sut.get_rebuild_count());
+
+    update(map);
+    EXPECT_EQ(0, sut.get_rebuild_count());
+}
+
+TEST_F(Update, ChangedTile_RebuildsOnlyItsClusterAndNeighbors)
+{
+    update(map);
+    run({0, 0}, {15, 15}, {1, 1}, map);
+
+    map.set({6, 6}, no);
+    update(map);
+    EXPECT_EQ(5, sut.get_rebuild_count());
+}
+
+TEST_F(Update, ChangedTiles_AreSeenByTheNextRun)
+{
+    update(map);
+    EXPECT_TRUE(run({0, 0}, {15, 0}, {1, 1}, map).has_path);
+
+    // wall off the right side
+    map.fill({8, 0}, {1, 16}, no);
+    update(map);
+    EXPECT_FALSE(run({0, 0}, {15, 0}, {1, 1}, map).has_path);
+
+    map.set({8, 15}, go);
+    update(map);
+    EXPECT_TRUE(run({0, 0}, {15, 0}, {1, 1}, map).has_path);
+}
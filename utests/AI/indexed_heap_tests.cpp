@@ -0,0 +1,156 @@
+#include <cstdlib>
+#include <functional>
+#include <queue>
+#include <utility>
+
+#include <gtest.h>
+#include <gmock.h>
+
+#include "AI/indexed_heap.hpp"
+
+using namespace testing;
+
+class TestableIndexedHeap : public Test
+{
+protected:
+    IndexedHeap<float> sut;
+
+    TestableIndexedHeap()
+    {
+        sut.reset(16);
+    }
+
+    /** \brief Pops every index, lowest priority first. */
+    std::vector<std::size_t> drain()
+    {
+        std::vector<std::size_t> indices;
+        while (!sut.empty()) {
+            indices.push_back(sut.top());
+            sut.pop();
+        }
+
+        return indices;
+    }
+};
+
+class Push : public TestableIndexedHeap { };
+
+TEST_F(Push, PopsLowestPriorityFirst)
+{
+    sut.push_or_decrease(3, 5.f);
+    sut.push_or_decrease(1, 2.f);
+    sut.push_or_decrease(7, 9.f);
+    sut.push_or_decrease(2, 1.f);
+
+    EXPECT_EQ(4, sut.size());
+    EXPECT_EQ(1.f, sut.top_priority());
+    EXPECT_THAT(drain(), ElementsAre(2, 1, 3, 7));
+}
+
+TEST_F(Push, TiesGoToTheLowerIndex)
+{
+    for(std::size_t index : {9, 4, 12, 0, 6}) {
+        sut.push_or_decrease(index, 1.f);
+    }
+
+    EXPECT_THAT(drain(), ElementsAre(0, 4, 6, 9, 12));
+}
+
+TEST_F(Push, IndexPastTheCapacity_Grows)
+{
+    sut.push_or_decrease(100, 1.f);
+
+    EXPECT_TRUE(sut.contains(100));
+    EXPECT_THAT(drain(), ElementsAre(100));
+}
+
+class Decrease : public TestableIndexedHeap { };
+
+TEST_F(Decrease, LowerPriority_MovesTheIndexUpWithoutDuplicatingIt)
+{
+    sut.push_or_decrease(0, 4.f);
+    sut.push_or_decrease(1, 5.f);
+    sut.push_or_decrease(2, 6.f);
+
+    EXPECT_TRUE(sut.push_or_decrease(2, 3.f));
+
+    EXPECT_EQ(3, sut.size());
+    EXPECT_THAT(drain(), ElementsAre(2, 0, 1));
+}
+
+TEST_F(Decrease, HigherOrEqualPriority_IsIgnored)
+{
+    sut.push_or_decrease(0, 4.f);
+    sut.push_or_decrease(1, 5.f);
+
+    EXPECT_FALSE(sut.push_or_decrease(0, 6.f));
+    EXPECT_FALSE(sut.push_or_decrease(0, 4.f));
+
+    EXPECT_EQ(4.f, sut.top_priority());
+    EXPECT_THAT(drain(), ElementsAre(0, 1));
+}
+
+TEST_F(Decrease, PoppedIndex_IsPushedAgain)
+{
+    sut.push_or_decrease(0, 1.f);
+    sut.pop();
+    EXPECT_FALSE(sut.contains(0));
+
+    EXPECT_TRUE(sut.push_or_decrease(0, 2.f));
+    EXPECT_TRUE(sut.contains(0));
+}
+
+class Reset : public TestableIndexedHeap { };
+
+TEST_F(Reset, ForgetsQueuedIndices)
+{
+    sut.push_or_decrease(3, 1.f);
+    sut.push_or_decrease(5, 2.f);
+    sut.pop();
+
+    sut.reset(16);
+
+    EXPECT_TRUE(sut.empty());
+    EXPECT_FALSE(sut.contains(3));
+    EXPECT_FALSE(sut.contains(5));
+
+    // priorities from before the reset don't linger
+    EXPECT_TRUE(sut.push_or_decrease(5, 8.f));
+    EXPECT_EQ(8.f, sut.top_priority());
+}
+
+TEST_F(Reset, MatchesAPriorityQueueWithLazyDeletion)
+{
+    std::srand(5);
+
+    for (int trial = 0; trial < 20; ++trial) {
+        sut.reset(64);
+        std::vector<float> best(64, -1.f);
+        std::priority_queue<std::pair<float, std::size_t>,
+                            std::vector<std::pair<float, std::size_t>>,
+                            std::greater<std::pair<float, std::size_t>>> expected;
+
+        for (int step = 0; step < 200; ++step) {
+            if (std::rand() % 3 == 0 && !sut.empty()) {
+                // skip the entries left behind by a decrease
+                while (expected.top().first != best[expected.top().second]) {
+                    expected.pop();
+                }
+
+                ASSERT_EQ(expected.top().second, sut.top()) << "trial " << trial;
+                best[sut.top()] = -1.f;
+                expected.pop();
+                sut.pop();
+                continue;
+            }
+
+            const std::size_t index = std::rand() % 64;
+            const float priority = std::rand() % 100;
+            if (best[index] < 0.f || priority < best[index]) {
+                best[index] = priority;
+                expected.emplace(priority, index);
+            }
+            sut.push_or_decrease(index, priority);
+        }
+    }
+}
@@ -0,0 +1,134 @@
+#include <gtest.h>
+#include <gmock.h>
+
+#include "AI/path_cache.hpp"
+
+using namespace testing;
+
+class TestablePathCache : public Test
+{
+protected:
+    PathCache sut;
+    AStar::Path path;
+
+    sf::Vector2i dimensions = {1, 1};
+
+    TestablePathCache() :
+        sut(4, 10)
+    { }
+
+    /** \brief A straight path from start, along x, to end. */
+    AStar::Result walk(const sf::Vector2i& start, const sf::Vector2i& end)
+    {
+        AStar::Result result{true, {}};
+        for (int x = start.x; x <= end.x; ++x) {
+            result.path.emplace_back(x, start.y);
+        }
+
+        return result;
+    }
+};
+
+class Find : public TestablePathCache { };
+
+TEST_F(Find, Empty_Misses)
+{
+    EXPECT_FALSE(sut.find({0, 0}, {5, 0}, dimensions, 0, path));
+    EXPECT_EQ(1, sut.get_miss_count());
+}
+
+TEST_F(Find, SameStart_GivesTheWholePath)
+{
+    sut.store({0, 0}, {5, 0}, dimensions, 0, walk({0, 0}, {5, 0}));
+
+    ASSERT_TRUE(sut.find({0, 0}, {5, 0}, dimensions, 0, path));
+    EXPECT_EQ(walk({0, 0}, {5, 0}).path, path);
+    EXPECT_EQ(1, sut.get_hit_count());
+}
+
+TEST_F(Find, StartOnACachedPath_GivesItsTail)
+{
+    sut.store({0, 0}, {25, 0}, dimensions, 0, walk({0, 0}, {25, 0}));
+
+    // in the same cluster, and in another one
+    ASSERT_TRUE(sut.find({3, 0}, {25, 0}, dimensions, 0, path));
+    EXPECT_EQ(walk({3, 0}, {25, 0}).path, path);
+
+    ASSERT_TRUE(sut.find({21, 0}, {25, 0}, dimensions, 0, path));
+    EXPECT_EQ(walk({21, 0}, {25, 0}).path, path);
+}
+
+TEST_F(Find, StartOffTheCachedPaths_Misses)
+{
+    sut.store({0, 0}, {5, 0}, dimensions, 0, walk({0, 0}, {5, 0}));
+
+    EXPECT_FALSE(sut.find({0, 1}, {5, 0}, dimensions, 0, path));
+    EXPECT_TRUE(path.empty());
+}
+
+TEST_F(Find, OtherGoalOrSize_Misses)
+{
+    sut.store({0, 0}, {5, 0}, dimensions, 0, walk({0, 0}, {5, 0}));
+
+    EXPECT_FALSE(sut.find({0, 0}, {4, 0}, dimensions, 0, path));
+    EXPECT_FALSE(sut.find({0, 0}, {5, 0}, {2, 1}, 0, path));
+}
+
+TEST_F(Find, PathsToOtherGoalsOfTheGoalCluster_Miss)
+{
+    sut.store({0, 0}, {25, 0}, dimensions, 0, walk({0, 0}, {25, 0}));
+    sut.store({0, 5}, {24, 5}, dimensions, 0, walk({0, 5}, {24, 5}));
+
+    // both paths are indexed under the same clusters, but {12, 0} is only on the one to {25, 0}
+    EXPECT_FALSE(sut.find({12, 0}, {24, 5}, dimensions, 0, path));
+    ASSERT_TRUE(sut.find({12, 5}, {24, 5}, dimensions, 0, path));
+    EXPECT_EQ(walk({12, 5}, {24, 5}).path, path);
+}
+
+TEST_F(Find, NewVersion_DropsEverything)
+{
+    sut.store({0, 0}, {5, 0}, dimensions, 0, walk({0, 0}, {5, 0}));
+
+    EXPECT_FALSE(sut.find({0, 0}, {5, 0}, dimensions, 1, path));
+    EXPECT_EQ(0, sut.get_size());
+}
+
+class Store : public TestablePathCache { };
+
+TEST_F(Store, SameCluster_ReplacesTheEntry)
+{
+    sut.store({0, 0}, {25, 0}, dimensions, 0, walk({0, 0}, {25, 0}));
+    sut.store({1, 2}, {25, 0}, dimensions, 0, walk({1, 2}, {25, 2}));
+
+    EXPECT_EQ(1, sut.get_size());
+    EXPECT_FALSE(sut.find({0, 0}, {25, 0}, dimensions, 0, path));
+    EXPECT_FALSE(sut.find({21, 0}, {25, 0}, dimensions, 0, path));
+    EXPECT_TRUE(sut.find({1, 2}, {25, 0}, dimensions, 0, path));
+    EXPECT_TRUE(sut.find({21, 2}, {25, 0}, dimensions, 0, path));
+}
+
+TEST_F(Store, OverCapacity_DropsTheLeastRecentlyUsed)
+{
+    for (int y = 0; y < 4; ++y) {
+        sut.store({0, y * 10}, {5, 0}, dimensions, 0, walk({0, y * 10}, {5, y * 10}));
+    }
+
+    // using the oldest makes the second oldest the least recently used
+    ASSERT_TRUE(sut.find({0, 0}, {5, 0}, dimensions, 0, path));
+    sut.store({0, 40}, {5, 0}, dimensions, 0, walk({0, 40}, {5, 40}));
+
+    EXPECT_EQ(4, sut.get_size());
+    EXPECT_TRUE(sut.find({0, 0}, {5, 0}, dimensions, 0, path));
+    EXPECT_FALSE(sut.find({0, 10}, {5, 0}, dimensions, 0, path));
+    EXPECT_TRUE(sut.find({0, 40}, {5, 0}, dimensions, 0, path));
+}
+
+TEST_F(Store, NoPathOrOlderVersion_IsNotKept)
+{
+    sut.store({0, 0}, {5, 0}, dimensions, 0, AStar::Result{false, {}});
+    EXPECT_EQ(0, sut.get_size());
+
+    ASSERT_FALSE(sut.find({0, 0}, {5, 0}, dimensions, 2, path));
+    sut.store({0, 0}, {5, 0}, dimensions, 1, walk({0, 0}, {5, 0}));
+    EXPECT_EQ(0, sut.get_size());
+}
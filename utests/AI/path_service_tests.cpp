@@ -0,0 +1,237 @@
+#include <chrono>
+#include <cstdlib>
+#include <thread>
+
+#include <gtest.h>
+#include <gmock.h>
+
+#include "AI/path_service.hpp"
+
+using namespace testing;
+
+class TestablePathService : public Test
+{
+protected:
+    Tile go = {true};
+    Tile no = {false};
+
+    /** \brief Polls the service until the response is ready, or a few seconds have passed. */
+    bool wait_for(PathService& service, PathService::Ticket ticket,
+                  PathService::Response& response)
+    {
+        for (int attempt = 0; attempt < 5000; ++attempt) {
+            if (service.collect(ticket, response)) {
+                return true;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return false;
+    }
+
+    PathService::Request make_request(const sf::Vector2i& start, const sf::Vector2i& end,
+                                      const sf::Vector2i& dimensions, const TileMap& map)
+    {
+        PathService::Request request;
+        request.start = start;
+        request.end = end;
+        request.dimensions = dimensions;
+        request.ignore_min = start;
+        request.ignore_max = start + dimensions - sf::Vector2i(1, 1);
+        request.map = std::make_shared<const TileMap>(map);
+        return request;
+    }
+};
+
+TEST_F(TestablePathService, ThreadCount_IsAtLeastOne)
+{
+    EXPECT_LE(1, PathService::get_default_thread_count());
+
+    PathService service(0);
+    EXPECT_EQ(1, service.get_thread_count());
+}
+
+TEST_F(TestablePathService, Collect_IsFalseUntilSubmitted)
+{
+    PathService service(1);
+    PathService::Response response;
+
+    EXPECT_FALSE(service.collect(0, response));
+}
+
+TEST_F(TestablePathService, Response_MatchesASearchOnTheCallingThread)
+{
+    PathService service(2);
+    TileMap map = {
+        {go, go, go, no, go, go, go},
+        {go, go, go, no, go, go, go},
+        {go, no, go, no, go, no, go},
+        {go, no, go, go, go, no, go},
+        {go, no, go, go, go, no, go},
+    };
+
+    auto ticket = service.submit(make_request({0, 3}, {6, 3}, {1, 2}, map));
+    auto expected = AStar::run({0, 3}, {6, 3}, {1, 2}, map, AStar::Mode::JUMP_POINT);
+
+    PathService::Response response;
+    ASSERT_TRUE(wait_for(service, ticket, response));
+    EXPECT_TRUE(response.result.has_path);
+    EXPECT_EQ(expected.path, response.result.path);
+
+    // collected once only
+    EXPECT_FALSE(service.collect(ticket, response));
+}
+
+TEST_F(TestablePathService, OwnFootprint_IsPassable)
+{
+    PathService service(1);
+    TileMap map(6, 3);
+    map.fill({0, 1}, {2, 1}, no); // the entity itself, as the occupancy would have it
+
+    auto ticket = service.submit(make_request({0, 1}, {4, 1}, {2, 1}, map));
+
+    PathService::Response response;
+    ASSERT_TRUE(wait_for(service, ticket, response));
+    EXPECT_TRUE(response.result.has_path);
+    EXPECT_EQ(5, response.result.path.size());
+
+    // the snapshot is shared, so it is never written to
+    EXPECT_FALSE(map.is_passable({0, 1}));
+}
+
+TEST_F(TestablePathService, SharedSnapshot_IsSearchedAsItIs)
+{
+    PathService service(1);
+    TileMap map(5, 1);
+    map.set({2, 0}, no);
+    auto snapshot = std::make_shared<const TileMap>(map);
+
+    // the wall is only passable for the entity standing in it
+    auto inside = make_request({2, 0}, {4, 0}, {1, 1}, map);
+    inside.map = snapshot;
+    auto outside = make_request({0, 0}, {4, 0}, {1, 1}, map);
+    outside.map = snapshot;
+    auto inside_ticket = service.submit(std::move(inside));
+    auto outside_ticket = service.submit(std::move(outside));
+
+    PathService::Response response;
+    ASSERT_TRUE(wait_for(service, inside_ticket, response));
+    EXPECT_TRUE(response.result.has_path);
+    ASSERT_TRUE(wait_for(service, outside_ticket, response));
+    EXPECT_FALSE(response.result.has_path);
+
+    // a new snapshot is a new version of the map
+    map.set({2, 0}, go);
+    auto opened_ticket = service.submit(make_request({0, 0}, {4, 0}, {1, 1}, map));
+    ASSERT_TRUE(wait_for(service, opened_ticket, response));
+    EXPECT_TRUE(response.result.has_path);
+    EXPECT_EQ(5, response.result.path.size());
+}
+
+TEST_F(TestablePathService, Cancel_DropsTheResponse)
+{
+    PathService service(1);
+    TileMap map(16, 16);
+
+    auto cancelled = service.submit(make_request({0, 0}, {15, 15}, {1, 1}, map));
+    service.cancel(cancelled);
+    auto kept = service.submit(make_request({0, 0}, {15, 0}, {1, 1}, map));
+
+    PathService::Response response;
+    ASSERT_TRUE(wait_for(service, kept, response));
+    EXPECT_EQ(16, response.result.path.size());
+
+    // requests run in order on a single worker, so the cancelled one is done with by now
+    EXPECT_FALSE(service.collect(cancelled, response));
+}
+
+TEST_F(TestablePathService, ManyRequests_AreAllResolved)
+{
+    std::srand(7);
+
+    PathService service(4);
+    TileMap map(32, 32);
+    for (int y = 0; y < map.get_height(); ++y) {
+        for (int x = 0; x < map.get_width(); ++x) {
+            if (std::rand() % 4 == 0) {
+                map.set({x, y}, no);
+            }
+        }
+    }
+    auto snapshot = std::make_shared<const TileMap>(map);
+
+    std::vector<PathService::Ticket> tickets;
+    std::vector<AStar::Result> expected;
+    for (int ndx = 0; ndx < 64; ++ndx) {
+        const sf::Vector2i start(std::rand() % 32, std::rand() % 32);
+        const sf::Vector2i end(std::rand() % 32, std::rand() % 32);
+
+        auto request = make_request(start, end, {1, 1}, map);
+        request.map = snapshot;
+        tickets.push_back(service.submit(std::move(request)));
+
+        auto clear_start = map;
+        clear_start.set(start, go);
+        expected.push_back(AStar::run(start, end, {1, 1}, clear_start, AStar::Mode::JUMP_POINT));
+    }
+
+    for (std::size_t ndx = 0; ndx < tickets.size(); ++ndx) {
+        PathService::Response response;
+        ASSERT_TRUE(wait_for(service, tickets[ndx], response)) << "request " << ndx;
+        EXPECT_EQ(expected[ndx].has_path, response.result.has_path) << "request " << ndx;
+        EXPECT_EQ(expected[ndx].path, response.result.path) << "request " << ndx;
+    }
+}
+
+TEST_F(TestablePathService, HierarchicalRequests_FindWholePaths)
+{
+    std::srand(11);
+
+    PathService service(2);
+    TileMap map(40, 40);
+    for (int y = 0; y < map.get_height(); ++y) {
+        for (int x = 0; x < map.get_width(); ++x) {
+            if (std::rand() % 5 == 0) {
+                map.set({x, y}, no);
+            }
+        }
+    }
+    auto snapshot = std::make_shared<const TileMap>(map);
+
+    std::vector<PathService::Ticket> tickets;
+    std::vector<AStar::Result> expected;
+    for (int ndx = 0; ndx < 16; ++ndx) {
+        const sf::Vector2i start(std::rand() % 40, std::rand() % 40);
+        const sf::Vector2i end(std::rand() % 40, std::rand() % 40);
+
+        auto request = make_request(start, end, {1, 1}, map);
+        request.map = snapshot;
+        request.search = PathService::Search::HIERARCHICAL;
+        tickets.push_back(service.submit(std::move(request)));
+
+        auto clear_start = map;
+        clear_start.set(start, go);
+        expected.push_back(AStar::run(start, end, {1, 1}, clear_start, AStar::Mode::JUMP_POINT));
+    }
+
+    for (std::size_t ndx = 0; ndx < tickets.size(); ++ndx) {
+        PathService::Response response;
+        ASSERT_TRUE(wait_for(service, tickets[ndx], response)) << "request " << ndx;
+        ASSERT_EQ(expected[ndx].has_path, response.result.has_path) << "request " << ndx;
+        if (expected[ndx].has_path) {
+            EXPECT_EQ(expected[ndx].path.back(), response.result.path.back()) << "request " << ndx;
+            EXPECT_GE(response.result.path.size(), expected[ndx].path.size()) << "request " << ndx;
+        }
+    }
+}
+
+TEST_F(TestablePathService, Destructor_DropsPendingRequests)
+{
+    TileMap map(64, 64);
+    auto service = std::make_unique<PathService>(1);
+    for (int ndx = 0; ndx < 32; ++ndx) {
+        service->submit(make_request({0, 0}, {63, 63}, {1, 1}, map));
+    }
+
+    // joins without waiting on the whole queue
+    service.reset();
+}
@@ -0,0 +1,10 @@
+set(TEST_NAME "allocation_counter_tests")
+
+add_executable(
+    ${TEST_NAME}
+    ${TEST_NAME}.cpp
+    ${CMAKE_SOURCE_DIR}/src/allocation_counter.cpp
+)
+target_link_libraries(${TEST_NAME} shooty_face_core ${GTEST_LIBRARIES})
+
+add_test(NAME ${TEST_NAME} COMMAND ${TEST_NAME})
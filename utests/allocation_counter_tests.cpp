@@ -0,0 +1,118 @@
+#include <memory>
+
+#include <gtest.h>
+#include <gmock.h>
+
+#include "allocation_counter.hpp"
+
+#include "demo_scene.hpp"
+#include "game.hpp"
+#include "shape_batch.hpp"
+#include "simulation.hpp"
+#include "components/physics.hpp"
+
+using namespace testing;
+
+class Count : public Test { };
+
+TEST_F(Count, CountsEachAllocation)
+{
+    const auto count = AllocationCounter::get_count();
+    const auto bytes = AllocationCounter::get_bytes();
+
+    std::unique_ptr<char[]> allocation(new char[100]);
+
+    EXPECT_EQ(count + 1, AllocationCounter::get_count());
+    EXPECT_EQ(bytes + 100, AllocationCounter::get_bytes());
+    EXPECT_NE(nullptr, allocation.get());
+}
+
+TEST_F(Count, IgnoresDeallocations)
+{
+    std::unique_ptr<int> allocation(new int(3));
+    const auto count = AllocationCounter::get_count();
+
+    allocation.reset();
+
+    EXPECT_EQ(count, AllocationCounter::get_count());
+}
+
+/** \brief Renders the demo scene as the game does, into buffers kept from frame to frame. */
+class Frame : public Test
+{
+protected:
+    DemoScene scene_;
+    Simulation simulation_;
+    Renderer::Renderings renderings_;
+    ShapeBatch batch_;
+
+    Frame() :
+        scene_(DemoScene::build())
+    { }
+
+    ~Frame()
+    {
+        Game::instance().reset();
+    }
+
+    void render()
+    {
+        renderings_.clear();
+        Game::instance().render(renderings_);
+
+        batch_.clear();
+        batch_.add(renderings_);
+    }
+};
+
+TEST_F(Frame, RendersEveryEntity)
+{
+    render();
+
+    // the gun has no projectiles to render yet
+    EXPECT_EQ(Game::instance().entities().size() - 1, renderings_.size());
+}
+
+TEST_F(Frame, Render_InSteadyState_AllocatesNothing)
+{
+    const auto position = scene_.player->get_component<Physics>()->get_position();
+    for (int shot = 0; shot < 8; ++shot) {
+        scene_.gun->reload();
+        scene_.gun->fire(position + sf::Vector2f(100.f * shot - 350.f, 200.f));
+    }
+    simulation_.step();
+    render();
+
+    // the buffers fit the first frame, and nothing is added after it, only moved or killed
+    for (int frame = 0; frame < 60; ++frame) {
+        simulation_.step();
+
+        const auto count = AllocationCounter::get_count();
+        render();
+        ASSERT_EQ(count, AllocationCounter::get_count()) << "frame " << frame;
+    }
+}
+
+TEST_F(Frame, SustainedFire_InSteadyState_AllocatesNothingToFire)
+{
+    // a shot every step, each hitting the wall below the player before long
+    const auto position = scene_.player->get_component<Physics>()->get_position();
+    auto fire = [this, position]
+    {
+        scene_.gun->reload();
+        scene_.gun->fire(position + sf::Vector2f(0.f, 100.f));
+    };
+    for (int frame = 0; frame < 240; ++frame) {
+        fire();
+        simulation_.step();
+    }
+
+    std::size_t allocations = 0;
+    for (int frame = 0; frame < 60; ++frame) {
+        const auto count = AllocationCounter::get_count();
+        fire();
+        allocations += AllocationCounter::get_count() - count;
+        simulation_.step();
+    }
+    EXPECT_EQ(0, allocations);
+}
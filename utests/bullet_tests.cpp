@@ -11,6 +11,7 @@
 #include "mocks/collision_mock.hpp"
 #include "mocks/entity_mock.hpp"
 #include "mocks/ai_mock.hpp"
+#include "mocks/projectile_mock.hpp"
 
 using namespace testing;
 
@@ -42,11 +43,13 @@ TEST_F(Components, Graphics_ReturnsACircleForThisBullet)
     physics->set_position({100.1f, 200.2f});
     physics->set_dimensions({10.1f, 20.2f});
 
-    const auto renderings = sut.get_component<Graphics>()->render();
-    const auto* graphic = static_cast<const sf::CircleShape*>(renderings[0]);
-
-    EXPECT_EQ(sf::Vector2f(100.f, 200.f), graphic->getPosition());
-    EXPECT_FLOAT_EQ(5.05f, graphic->getRadius());
+    Graphics::Renderings renderings;
+    sut.get_component<Graphics>()->render(renderings);
+    ASSERT_EQ(1, renderings.size());
+    EXPECT_EQ(Rendering::Shape::CIRCLE, renderings[0].shape);
+    EXPECT_EQ(sf::Vector2f(100.f, 200.f), renderings[0].position);
+    EXPECT_FLOAT_EQ(10.1f, renderings[0].dimensions.x);
+    EXPECT_FLOAT_EQ(10.1f, renderings[0].dimensions.y);
 }
 
 class Fire : public TestableBullet { };
@@ -131,6 +134,41 @@ TEST_F(TestableBulletAmmunition, RestartsTheClockOnTheFirstCallAndAfterReload)
     EXPECT_NE(nullptr, projectiles_.back());
 }
 
+TEST_F(TestableBulletAmmunition, RecycledBullets_AreFiredAgain_BeforeMakingNewOnes)
+{
+    auto* first = static_cast<Bullet*>(sut.create_projectile());
+    first->get_component<Physics>()->set_position({10.f, 10.f});
+    first->set_target({20.f, 10.f});
+    first->fire();
+    first->kill();
+
+    sut.recycle(first);
+    EXPECT_EQ(1, sut.get_spare_count());
+
+    // reset, ready to be placed and fired as if new
+    sut.reload();
+    projectiles_.push_back(sut.create_projectile());
+    ASSERT_EQ(first, projectiles_.back());
+    EXPECT_EQ(0, sut.get_spare_count());
+    EXPECT_TRUE(first->is_alive());
+    EXPECT_TRUE(first->get_component<Physics>()->is_static());
+    EXPECT_EQ(sf::Vector2f(0.f, 0.f), first->get_component<Physics>()->get_velocity());
+    EXPECT_TRUE(first->has_component<AI>());
+    EXPECT_TRUE(first->has_component<Graphics>());
+
+    // and once there are none left, new ones are made
+    sut.reload();
+    projectiles_.push_back(sut.create_projectile());
+    EXPECT_NE(nullptr, projectiles_.back());
+    EXPECT_NE(first, projectiles_.back());
+}
+
+TEST_F(TestableBulletAmmunition, OtherProjectiles_AreNotKept)
+{
+    sut.recycle(new ProjectileMock);
+    EXPECT_EQ(0, sut.get_spare_count());
+}
+
 TEST_F(TestableBulletAmmunition, WontFireASecondTimeUntilTimeHasElapsed)
 {
     // first call always succeeds
@@ -354,3 +354,36 @@ TEST_F(Penetration, CalculateTheMinimumPenetrationVector)
     EXPECT_FLOAT_EQ(0.f, Collision::narrow_test(first(), second()));
     EXPECT_EQ(penetration_, Collision::get_penetration(first(), second()));
 }
+
+class RayCast : public TestableCollision
+{
+protected:
+    // box spanning <8, 8> to <12, 12>
+    AABB box_{sf::Vector2f(10.f, 10.f), sf::Vector2f(4.f, 4.f)};
+};
+
+TEST_F(RayCast, HitsTheNearSide)
+{
+    EXPECT_FLOAT_EQ(0.5f, Collision::ray_cast({0.f, 10.f}, {16.f, 0.f}, box_));
+    EXPECT_FLOAT_EQ(0.5f, Collision::ray_cast({10.f, 20.f}, {0.f, -16.f}, box_));
+    EXPECT_FLOAT_EQ(0.25f, Collision::ray_cast({0.f, 0.f}, {32.f, 32.f}, box_));
+}
+
+TEST_F(RayCast, FromInsideIsAnImmediateHit)
+{
+    EXPECT_FLOAT_EQ(0.f, Collision::ray_cast({10.f, 10.f}, {16.f, 0.f}, box_));
+    EXPECT_FLOAT_EQ(0.f, Collision::ray_cast({10.f, 10.f}, {0.f, 0.f}, box_));
+}
+
+TEST_F(RayCast, MissesAreWholeRays)
+{
+    // too short
+    EXPECT_FLOAT_EQ(1.f, Collision::ray_cast({0.f, 10.f}, {8.f, 0.f}, box_));
+    // pointing away
+    EXPECT_FLOAT_EQ(1.f, Collision::ray_cast({0.f, 10.f}, {-16.f, 0.f}, box_));
+    // passing by, parallel and diagonally
+    EXPECT_FLOAT_EQ(1.f, Collision::ray_cast({0.f, 13.f}, {32.f, 0.f}, box_));
+    EXPECT_FLOAT_EQ(1.f, Collision::ray_cast({0.f, 8.f}, {8.f, -8.f}, box_));
+    // still, outside
+    EXPECT_FLOAT_EQ(1.f, Collision::ray_cast({0.f, 0.f}, {0.f, 0.f}, box_));
+}
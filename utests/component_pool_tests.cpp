@@ -0,0 +1,171 @@
+#include <gtest.h>
+#include <gmock.h>
+
+#include "component_pool.hpp"
+#include "entity.hpp"
+
+class StubEntity : public Entity {
+    sf::Time update(sf::Time elapsed) override { return sf::Time::Zero; }
+};
+
+/** \brief Counts its live instances, to check the pool destroys what it constructs. */
+class CountedComponent : public Component
+{
+public:
+    CountedComponent(Entity& entity, int value = 0) :
+        Component(entity),
+        value(value)
+    {
+        ++live_count;
+    }
+
+    virtual ~CountedComponent() { --live_count; }
+
+    int value;
+
+    static int live_count;
+};
+int CountedComponent::live_count = 0;
+
+/** \brief Stands in for a subclassed component, eg. an AIEnemy set as the AI. */
+class DerivedComponent : public CountedComponent
+{
+public:
+    DerivedComponent(Entity& entity) :
+        CountedComponent(entity, 42)
+    { }
+};
+
+using namespace testing;
+
+class TestableComponentPool : public Test
+{
+protected:
+    ComponentPool<CountedComponent>& pool = ComponentPool<CountedComponent>::instance();
+
+    void TearDown() override
+    {
+        EXPECT_EQ(0, pool.size());
+        EXPECT_EQ(0, CountedComponent::live_count);
+    }
+};
+
+class EntityIdentity : public TestableComponentPool { };
+
+TEST_F(EntityIdentity, LiveEntitiesHaveUniqueIds)
+{
+    StubEntity first;
+    StubEntity second;
+    StubEntity third;
+
+    EXPECT_NE(first.get_id(), second.get_id());
+    EXPECT_NE(first.get_id(), third.get_id());
+    EXPECT_NE(second.get_id(), third.get_id());
+}
+
+TEST_F(EntityIdentity, IdsAreRecycledOnceTheEntityIsDestroyed)
+{
+    EntityId id;
+    {
+        StubEntity entity;
+        id = entity.get_id();
+    }
+
+    StubEntity entity;
+    EXPECT_EQ(id, entity.get_id());
+}
+
+class Emplace : public TestableComponentPool { };
+
+TEST_F(Emplace, ConstructsWithTheEntityAndArgs_LookupIsByEntityId)
+{
+    StubEntity entity;
+
+    auto* component = entity.emplace_component<CountedComponent>(7);
+    EXPECT_EQ(7, component->value);
+    EXPECT_EQ(1, pool.size());
+    EXPECT_EQ(component, pool.get(entity.get_id()));
+    EXPECT_EQ(component, entity.get_component<CountedComponent>());
+
+    entity.set_component<CountedComponent>(std::unique_ptr<Component>(nullptr));
+    EXPECT_EQ(nullptr, pool.get(entity.get_id()));
+}
+
+TEST_F(Emplace, ReusesStorageFreedByRemovedComponents)
+{
+    StubEntity entity;
+    entity.add_component<CountedComponent>();
+    auto available = pool.available();
+
+    for (int ndx = 0; ndx < 100; ++ndx) {
+        entity.add_component<CountedComponent>();
+        EXPECT_EQ(1, CountedComponent::live_count);
+        EXPECT_EQ(available, pool.available());
+    }
+}
+
+TEST_F(Emplace, ComponentsSurviveThePoolGrowing)
+{
+    std::vector<std::unique_ptr<StubEntity>> entities;
+    std::vector<CountedComponent*> components;
+
+    auto count = 3 * ComponentPool<CountedComponent>::CHUNK_SIZE;
+    for (int ndx = 0; ndx < count; ++ndx) {
+        entities.emplace_back(new StubEntity());
+        components.push_back(entities.back()->emplace_component<CountedComponent>(ndx));
+    }
+
+    EXPECT_EQ(count, pool.size());
+    for (int ndx = 0; ndx < count; ++ndx) {
+        EXPECT_EQ(components[ndx], entities[ndx]->get_component<CountedComponent>());
+        EXPECT_EQ(ndx, components[ndx]->value);
+    }
+}
+
+class Adopt : public TestableComponentPool { };
+
+TEST_F(Adopt, TakesOwnershipOfSubclassedComponents)
+{
+    StubEntity entity;
+
+    auto* component = entity.set_component<CountedComponent>(std::make_unique<DerivedComponent>(entity));
+    EXPECT_EQ(42, component->value);
+    EXPECT_EQ(1, CountedComponent::live_count);
+
+    // replacing an adopted component with an emplaced one deletes the adopted one
+    entity.add_component<CountedComponent>();
+    EXPECT_EQ(1, CountedComponent::live_count);
+    EXPECT_EQ(0, entity.get_component<CountedComponent>()->value);
+}
+
+class Remove : public TestableComponentPool { };
+
+TEST_F(Remove, DestroyingTheEntityDestroysItsComponentsInEveryPool)
+{
+    {
+        StubEntity entity;
+        entity.add_component<CountedComponent>();
+        entity.add_component<Component>();
+        EXPECT_EQ(1, pool.size());
+    }
+
+    StubEntity entity;
+    EXPECT_FALSE(entity.has_component<CountedComponent>());
+    EXPECT_FALSE(entity.has_component<Component>());
+}
+
+TEST_F(Remove, OtherEntitiesAreUnaffected)
+{
+    StubEntity entity;
+    auto* component = entity.emplace_component<CountedComponent>(3);
+
+    {
+        StubEntity other;
+        other.emplace_component<CountedComponent>(4);
+        EXPECT_EQ(2, pool.size());
+    }
+
+    EXPECT_EQ(component, entity.get_component<CountedComponent>());
+    EXPECT_EQ(3, component->value);
+    entity.set_component<CountedComponent>(std::unique_ptr<Component>(nullptr));
+}
@@ -0,0 +1,9 @@
+set(TEST_NAME "game_tests")
+
+add_executable(
+    ${TEST_NAME}
+    ${TEST_NAME}.cpp
+)
+target_link_libraries(${TEST_NAME} shooty_face_core ${GTEST_LIBRARIES})
+
+add_test(NAME ${TEST_NAME} COMMAND ${TEST_NAME})
@@ -0,0 +1,192 @@
+#include <gtest.h>
+#include <gmock.h>
+
+#include "game.hpp"
+
+#include "AI/path_service.hpp"
+#include "barrier.hpp"
+#include "components/physics.hpp"
+#include "mocks/entity_mock.hpp"
+
+using namespace testing;
+
+/** \brief Renders a circle at the origin, without physics, like the Gun. */
+class Overlay : public EntityMock, public Renderer
+{
+public:
+    Overlay() { emplace_component<Graphics>(*this); }
+
+    void render(Renderings& renderings) override
+    {
+        renderings.push_back(Rendering::circle({0.f, 0.f}, 1.f, sf::Color::Red));
+    }
+};
+
+class TestableGame : public Test
+{
+protected:
+    Game& sut;
+
+    TestableGame() :
+        sut(Game::instance())
+    {
+        // view spanning <100, 100> to <200, 200>
+        sut.set_view(AABB({150.f, 150.f}, {100.f, 100.f}));
+    }
+
+    void TearDown() override
+    {
+        sut.reset();
+    }
+
+    Barrier* add_barrier(sf::Vector2f position)
+    {
+        auto* barrier = new Barrier;
+        barrier->get_component<Physics>()->set_position(position);
+        barrier->get_component<Physics>()->set_dimensions({10.f, 10.f});
+        sut.entity_collection().emplace_back(barrier);
+        return barrier;
+    }
+};
+
+class View : public TestableGame { };
+
+TEST_F(View, ByDefault_IsTheWindow)
+{
+    sut.reset();
+    EXPECT_EQ(AABB({Game::WINDOW_WIDTH / 2.f, Game::WINDOW_HEIGHT / 2.f},
+                   {Game::WINDOW_WIDTH, Game::WINDOW_HEIGHT}),
+              sut.get_view());
+    EXPECT_FALSE(sut.is_lod_enabled());
+}
+
+TEST_F(View, BoxesOverlappingOrTouchingTheView_AreVisible)
+{
+    EXPECT_TRUE(sut.is_visible(AABB({150.f, 150.f}, {10.f, 10.f})));
+    EXPECT_TRUE(sut.is_visible(AABB({95.f, 150.f}, {10.f, 10.f})));
+    EXPECT_TRUE(sut.is_visible(AABB({205.f, 205.f}, {10.f, 10.f})));
+    EXPECT_TRUE(sut.is_visible(AABB({150.f, 150.f}, {1000.f, 1000.f})));
+
+    EXPECT_FALSE(sut.is_visible(AABB({94.f, 150.f}, {10.f, 10.f})));
+    EXPECT_FALSE(sut.is_visible(AABB({150.f, 206.f}, {10.f, 10.f})));
+}
+
+TEST_F(View, BoxesAreVisibleWithoutTheirTrajectory)
+{
+    EXPECT_FALSE(sut.is_visible(AABB({50.f, 150.f}, {10.f, 10.f}, {100.f, 0.f})));
+}
+
+TEST_F(View, OutOfView_IsOnlyLessDetailedWithLOD)
+{
+    const auto hidden = AABB({0.f, 0.f}, {10.f, 10.f});
+    const auto shown = AABB({150.f, 150.f}, {10.f, 10.f});
+
+    EXPECT_TRUE(sut.is_detailed(hidden));
+    EXPECT_TRUE(sut.is_detailed(shown));
+
+    sut.set_lod_enabled(true);
+    EXPECT_FALSE(sut.is_detailed(hidden));
+    EXPECT_TRUE(sut.is_detailed(shown));
+
+    sut.reset();
+    EXPECT_FALSE(sut.is_lod_enabled());
+}
+
+class Render : public TestableGame { };
+
+TEST_F(Render, SkipsEntitiesOutOfView)
+{
+    add_barrier({110.f, 110.f});
+    add_barrier({10.f, 10.f});
+    add_barrier({190.f, 120.f});
+    add_barrier({150.f, 300.f});
+
+    Renderer::Renderings renderings;
+    sut.render(renderings);
+    ASSERT_EQ(2, renderings.size());
+    EXPECT_EQ(sf::Vector2f(110.f, 110.f), renderings[0].position);
+    EXPECT_EQ(sf::Vector2f(190.f, 120.f), renderings[1].position);
+}
+
+TEST_F(Render, SkipsEntitiesOutOfView_ThroughTheBroadPhase)
+{
+    add_barrier({110.f, 110.f});
+    add_barrier({10.f, 10.f});
+    add_barrier({190.f, 120.f});
+    add_barrier({150.f, 300.f});
+    sut.sync_broad_phase();
+
+    Renderer::Renderings renderings;
+    sut.render(renderings);
+    ASSERT_EQ(2, renderings.size());
+    EXPECT_EQ(sf::Vector2f(110.f, 110.f), renderings[0].position);
+    EXPECT_EQ(sf::Vector2f(190.f, 120.f), renderings[1].position);
+
+    // followed as entities move
+    auto* barrier = static_cast<Barrier*>(sut.entities()[1].get());
+    barrier->get_component<Physics>()->set_position({120.f, 190.f});
+    sut.update_broad_phase(*barrier);
+
+    renderings.clear();
+    sut.render(renderings);
+    ASSERT_EQ(3, renderings.size());
+    EXPECT_EQ(sf::Vector2f(120.f, 190.f), renderings[1].position);
+}
+
+TEST_F(Render, EntitiesWithoutPhysics_AlwaysRender)
+{
+    add_barrier({10.f, 10.f});
+    sut.entity_collection().emplace_back(new Overlay);
+    add_barrier({150.f, 150.f});
+
+    for (int synced = 0; synced < 2; ++synced) {
+        if (synced) {
+            sut.sync_broad_phase();
+        }
+
+        Renderer::Renderings renderings;
+        sut.render(renderings);
+        ASSERT_EQ(2, renderings.size());
+        EXPECT_EQ(Rendering::Shape::CIRCLE, renderings[0].shape);
+        EXPECT_EQ(sf::Vector2f(150.f, 150.f), renderings[1].position);
+    }
+}
+
+TEST_F(TestableGame, PathService_IsKeptAcrossReset)
+{
+    // entities cleared by reset() may still cancel their requests on it
+    auto* service = &sut.get_path_service();
+    sut.reset();
+    EXPECT_EQ(service, &sut.get_path_service());
+}
+
+TEST_F(TestableGame, Maps_AreAsOfTheLastSync)
+{
+    auto* barrier = add_barrier({50.f, 50.f});
+    const auto tile = Game::get_tile_for({50.f, 50.f});
+    sut.sync_occupancy();
+    ASSERT_FALSE(sut.get_static_map().is_passable(tile));
+    const auto version = sut.get_static_map_version();
+
+    // reading the maps never syncs them, however the entities changed
+    barrier->get_component<Physics>()->set_position({150.f, 150.f});
+    EXPECT_FALSE(sut.get_static_map().is_passable(tile));
+    EXPECT_EQ(version, sut.get_static_map_version());
+
+    sut.sync_occupancy();
+    EXPECT_TRUE(sut.get_static_map().is_passable(tile));
+    EXPECT_NE(version, sut.get_static_map_version());
+}
+
+TEST_F(TestableGame, MapIgnoringAnEntity_LeavesTheVersionAsItIs)
+{
+    auto* barrier = add_barrier({50.f, 50.f});
+    const auto tile = Game::get_tile_for({50.f, 50.f});
+    sut.sync_occupancy();
+    const auto version = sut.get_static_map_version();
+
+    auto view = sut.get_map(barrier);
+    EXPECT_TRUE(view.is_passable(tile));
+    EXPECT_FALSE(sut.get_map().is_passable(tile));
+    EXPECT_EQ(version, sut.get_static_map_version());
+}
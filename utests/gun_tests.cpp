@@ -3,11 +3,10 @@
 
 #include "gun.hpp"
 
+#include "game.hpp"
 #include "mocks/entity_mock.hpp"
 #include "mocks/projectile_mock.hpp"
 
-#include <SFML/Graphics/RectangleShape.hpp>
-
 using namespace testing;
 
 class TestableGun : public Test
@@ -35,30 +34,68 @@ TEST_F(Components, ExistenceThereof)
     EXPECT_TRUE(sut.has_component<Graphics>());
 }
 
+/** \brief Has the given projectile append two circles, at the given x and y = 1, 2. */
+static void
+expect_render(ProjectileMock& projectile, float x)
+{
+    EXPECT_CALL(projectile, render(_)).WillOnce(Invoke([x](Graphics::Renderings& renderings)
+    {
+        renderings.push_back(Rendering::circle({x, 1.f}, 1.f, sf::Color::Red));
+        renderings.push_back(Rendering::circle({x, 2.f}, 1.f, sf::Color::Red));
+    }));
+}
+
 TEST_F(Components, Graphics_DelegatesToRenderForAllLiveProjectiles)
 {
     ProjectileMock* projectile1 = new ProjectileMock();
     sut_get_magazine().push_back(std::unique_ptr<Projectile>(projectile1));
-
-    Graphics::Renderings renderings1;
-    sf::RectangleShape rendering11; renderings1.push_back(&rendering11);
-    sf::RectangleShape rendering12; renderings1.push_back(&rendering12);
-    EXPECT_CALL(*projectile1, render()).WillOnce(Return(renderings1));
+    expect_render(*projectile1, 1.f);
 
     ProjectileMock* projectile2 = new ProjectileMock();
     sut_get_magazine().push_back(std::unique_ptr<Projectile>(projectile2));
+    expect_render(*projectile2, 2.f);
+
+    Graphics::Renderings renderings;
+    sut.render(renderings);
+    ASSERT_EQ(4, renderings.size());
+    EXPECT_EQ(sf::Vector2f(1.f, 1.f), renderings[0].position);
+    EXPECT_EQ(sf::Vector2f(1.f, 2.f), renderings[1].position);
+    EXPECT_EQ(sf::Vector2f(2.f, 1.f), renderings[2].position);
+    EXPECT_EQ(sf::Vector2f(2.f, 2.f), renderings[3].position);
+}
+
+TEST_F(Components, Graphics_AppendsToTheRenderingsGiven)
+{
+    ProjectileMock* projectile = new ProjectileMock();
+    sut_get_magazine().push_back(std::unique_ptr<Projectile>(projectile));
+    expect_render(*projectile, 1.f);
+
+    Graphics::Renderings renderings = {Rendering::circle({0.f, 0.f}, 1.f, sf::Color::Blue)};
+    sut.render(renderings);
+    ASSERT_EQ(3, renderings.size());
+    EXPECT_EQ(sf::Vector2f(0.f, 0.f), renderings[0].position);
+    EXPECT_EQ(sf::Vector2f(1.f, 1.f), renderings[1].position);
+}
+
+TEST_F(Components, Graphics_SkipsProjectilesOutOfView)
+{
+    Game::instance().set_view(AABB({100.f, 100.f}, {50.f, 50.f}));
+
+    ProjectileMock* hidden = new ProjectileMock();
+    hidden->get_component<Physics>()->set_position({10.f, 10.f});
+    sut_get_magazine().push_back(std::unique_ptr<Projectile>(hidden));
+    EXPECT_CALL(*hidden, render(_)).Times(0);
+
+    ProjectileMock* shown = new ProjectileMock();
+    shown->get_component<Physics>()->set_position({120.f, 80.f});
+    sut_get_magazine().push_back(std::unique_ptr<Projectile>(shown));
+    expect_render(*shown, 1.f);
 
-    Graphics::Renderings renderings2;
-    sf::RectangleShape rendering21; renderings2.push_back(&rendering21);
-    sf::RectangleShape rendering22; renderings2.push_back(&rendering22);
-    EXPECT_CALL(*projectile2, render()).WillOnce(Return(renderings2));
-
-    const auto& renderings = sut.render();
-    EXPECT_EQ(4, renderings.size());
-    EXPECT_EQ(&rendering11, renderings[0]);
-    EXPECT_EQ(&rendering12, renderings[1]);
-    EXPECT_EQ(&rendering21, renderings[2]);
-    EXPECT_EQ(&rendering22, renderings[3]);
+    Graphics::Renderings renderings;
+    sut.render(renderings);
+    EXPECT_EQ(2, renderings.size());
+
+    Game::instance().reset();
 }
 
 class Fire : public TestableGun
@@ -106,7 +143,7 @@ TEST_F(Reload, ProxiesToAmmunition)
 
 class Update : public TestableGun { };
 
-TEST_F(Update, RemovesAllDeadProjectiles)
+TEST_F(Update, RemovesAllDeadProjectiles_GivingThemBackToTheAmmunition)
 {
     ProjectileMock* dead1 = new ProjectileMock(); dead1->kill();
     sut_get_magazine().push_back(std::unique_ptr<Projectile>(dead1));
@@ -120,6 +157,12 @@ TEST_F(Update, RemovesAllDeadProjectiles)
     NiceMock<ProjectileMock>* alive2 = new NiceMock<ProjectileMock>();
     sut_get_magazine().push_back(std::unique_ptr<Projectile>(alive2));
 
+    {
+        InSequence sequence;
+        EXPECT_CALL(*ammunition_, recycle(dead1));
+        EXPECT_CALL(*ammunition_, recycle(dead2));
+    }
+
     auto ret = sut.update(sf::seconds(0.5f));
     EXPECT_EQ(sf::seconds(0.5f), ret);
 
@@ -141,3 +184,18 @@ TEST_F(Update, ProxiesUpdateToEachLiveProjectile)
     auto ret = sut.update(sf::seconds(0.5f));
     EXPECT_EQ(sf::seconds(0.5f), ret);
 }
+
+class Refresh : public TestableGun { };
+
+TEST_F(Refresh, ProxiesRefreshToEachProjectile)
+{
+    ProjectileMock* projectile1 = new ProjectileMock();
+    sut_get_magazine().push_back(std::unique_ptr<Projectile>(projectile1));
+    EXPECT_CALL(*projectile1, refresh(sf::seconds(0.5f)));
+
+    ProjectileMock* projectile2 = new ProjectileMock();
+    sut_get_magazine().push_back(std::unique_ptr<Projectile>(projectile2));
+    EXPECT_CALL(*projectile2, refresh(sf::seconds(0.5f)));
+
+    sut.refresh(sf::seconds(0.5f));
+}
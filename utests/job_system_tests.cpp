@@ -0,0 +1,109 @@
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <gtest.h>
+#include <gmock.h>
+
+#include "job_system.hpp"
+
+using namespace testing;
+
+class TestableJobSystem : public Test
+{
+protected:
+    JobSystem sut;
+
+    TestableJobSystem() :
+        sut(3)
+    { }
+};
+
+TEST_F(TestableJobSystem, ParallelFor_RunsEveryIndexOnce)
+{
+    std::vector<int> counts(10000, 0);
+
+    sut.parallel_for(counts.size(), 7, [&counts](std::size_t begin, std::size_t end) {
+        for (auto ndx = begin; ndx < end; ++ndx) {
+            ++counts[ndx];
+        }
+    });
+
+    EXPECT_THAT(counts, Each(1));
+}
+
+TEST_F(TestableJobSystem, ParallelFor_SplitsTheRangeIntoChunksOfAtMostGrain)
+{
+    std::mutex mutex;
+    std::set<std::pair<std::size_t, std::size_t>> chunks;
+
+    sut.parallel_for(10, 4, [&](std::size_t begin, std::size_t end) {
+        std::lock_guard<std::mutex> lock(mutex);
+        chunks.emplace(begin, end);
+    });
+
+    const std::set<std::pair<std::size_t, std::size_t>> expected = {{0, 4}, {4, 8}, {8, 10}};
+    EXPECT_EQ(expected, chunks);
+}
+
+TEST_F(TestableJobSystem, ParallelFor_WithinTheGrain_RunsOnTheCallingThread)
+{
+    std::vector<std::pair<std::size_t, std::size_t>> chunks;
+    std::thread::id runner;
+
+    sut.parallel_for(5, 8, [&](std::size_t begin, std::size_t end) {
+        chunks.emplace_back(begin, end);
+        runner = std::this_thread::get_id();
+    });
+
+    ASSERT_EQ(1, chunks.size());
+    EXPECT_EQ((std::pair<std::size_t, std::size_t>(0, 5)), chunks[0]);
+    EXPECT_EQ(std::this_thread::get_id(), runner);
+}
+
+TEST_F(TestableJobSystem, ParallelFor_OverNothing_NeverRunsTheBody)
+{
+    bool is_run = false;
+    sut.parallel_for(0, 1, [&is_run](std::size_t, std::size_t) { is_run = true; });
+
+    EXPECT_FALSE(is_run);
+}
+
+TEST_F(TestableJobSystem, ParallelFor_FromWithinAJob_RunsEveryIndex)
+{
+    std::atomic<int> total(0);
+
+    sut.parallel_for(8, 1, [this, &total](std::size_t begin, std::size_t end) {
+        for (auto outer = begin; outer < end; ++outer) {
+            sut.parallel_for(100, 10, [&total](std::size_t begin, std::size_t end) {
+                total += static_cast<int>(end - begin);
+            });
+        }
+    });
+
+    EXPECT_EQ(800, total);
+}
+
+TEST_F(TestableJobSystem, WithNoWorkers_RunsEverythingOnTheCallingThread)
+{
+    JobSystem system(0);
+    EXPECT_EQ(0, system.get_thread_count());
+
+    std::set<std::thread::id> runners;
+    system.parallel_for(100, 1, [&runners](std::size_t, std::size_t) {
+        runners.insert(std::this_thread::get_id());
+    });
+
+    EXPECT_EQ(std::set<std::thread::id>{std::this_thread::get_id()}, runners);
+}
+
+TEST_F(TestableJobSystem, ThreadCount_LeavesACoreForTheCallingThread)
+{
+    const std::size_t cores = std::thread::hardware_concurrency();
+    EXPECT_GE(std::max<std::size_t>(cores, 1) - 1, JobSystem::get_default_thread_count());
+    EXPECT_EQ(3, sut.get_thread_count());
+}
@@ -26,6 +26,7 @@ public:
         ON_CALL(instance(), broad_test(_, _)).WillByDefault(Return(false));
         ON_CALL(instance(), narrow_test(_, _)).WillByDefault(Return(1.f));
         ON_CALL(instance(), get_penetration(_, _)).WillByDefault(Return(sf::Vector2f(0.f, 0.f)));
+        ON_CALL(instance(), ray_cast(_, _, _)).WillByDefault(Return(1.f));
     }
 
     static void clear_defaults()
@@ -39,6 +40,7 @@ public:
     MOCK_METHOD2(broad_test, bool(const AABB&, const AABB&));
     MOCK_METHOD2(narrow_test, float(const AABB&, const AABB&));
     MOCK_METHOD2(get_penetration, sf::Vector2f(const AABB&, const AABB&));
+    MOCK_METHOD3(ray_cast, float(sf::Vector2f, sf::Vector2f, const AABB&));
 
 private:
     friend class testing::NiceMock<CollisionMock>;
@@ -68,3 +70,9 @@ Collision::get_penetration(const AABB& first, const AABB& second)
 {
     return CollisionMock::instance().get_penetration(first, second);
 }
+
+float
+Collision::ray_cast(sf::Vector2f origin, sf::Vector2f ray, const AABB& box)
+{
+    return CollisionMock::instance().ray_cast(origin, ray, box);
+}
@@ -12,16 +12,27 @@ public:
     virtual ~ProjectileMock() = default;
 
     MOCK_METHOD0(fire, void(void));
+    MOCK_METHOD1(refresh, void(sf::Time));
     MOCK_METHOD1(update, sf::Time(sf::Time));
-    MOCK_METHOD0(render, const Renderings(void));
+    MOCK_METHOD1(render, void(Renderings&));
 };
 
 class AmmunitionMock : public Ammunition
 {
 public:
-    AmmunitionMock() = default;
+    /** \brief Destroys recycled projectiles by default, as Ammunition does. */
+    AmmunitionMock()
+    {
+        using namespace testing;
+
+        ON_CALL(*this, recycle(_)).WillByDefault(Invoke([](Projectile* projectile)
+        {
+            delete projectile;
+        }));
+    }
     virtual ~AmmunitionMock() = default;
 
     MOCK_METHOD0(create_projectile, Projectile*(void));
+    MOCK_METHOD1(recycle, void(Projectile*));
     MOCK_METHOD0(reload, void(void));
 };
@@ -0,0 +1,182 @@
+#include <gtest.h>
+#include <gmock.h>
+
+#include "occupancy_grid.hpp"
+
+using namespace testing;
+
+class TestableOccupancyGrid : public Test
+{
+protected:
+    OccupancyGrid sut;
+
+    TestableOccupancyGrid()
+    {
+        sut.resize({6, 4});
+    }
+
+    /** \brief Lists the impassable tiles of the given map or view, in row major order. */
+    template <typename Map>
+    std::vector<sf::Vector2i> blocked(const Map& map)
+    {
+        std::vector<sf::Vector2i> tiles;
+        for (int y = 0; y < map.get_height(); ++y) {
+            for (int x = 0; x < map.get_width(); ++x) {
+                if (!map.is_passable({x, y})) {
+                    tiles.emplace_back(x, y);
+                }
+            }
+        }
+
+        return tiles;
+    }
+};
+
+class Place : public TestableOccupancyGrid { };
+
+TEST_F(Place, BlocksTheTilesUnderTheFootprint)
+{
+    sut.place(3, {1, 1}, {2, 2});
+
+    EXPECT_THAT(blocked(sut.get_map()), ElementsAre(sf::Vector2i(1, 1), sf::Vector2i(2, 1),
+                                                    sf::Vector2i(1, 2), sf::Vector2i(2, 2)));
+    EXPECT_EQ(1, sut.get_count({1, 1}));
+    EXPECT_EQ(0, sut.get_count({0, 0}));
+}
+
+TEST_F(Place, OverlappingFootprintsAreCounted)
+{
+    sut.place(0, {0, 0}, {1, 0});
+    sut.place(1, {1, 0}, {2, 0});
+
+    EXPECT_EQ(1, sut.get_count({0, 0}));
+    EXPECT_EQ(2, sut.get_count({1, 0}));
+
+    sut.remove(0);
+    EXPECT_THAT(blocked(sut.get_map()), ElementsAre(sf::Vector2i(1, 0), sf::Vector2i(2, 0)));
+}
+
+TEST_F(Place, MovingAFootprintUnblocksItsOldTiles)
+{
+    sut.place(0, {0, 0}, {0, 0});
+    sut.place(0, {4, 3}, {4, 3});
+
+    EXPECT_THAT(blocked(sut.get_map()), ElementsAre(sf::Vector2i(4, 3)));
+}
+
+TEST_F(Place, FootprintsAreClippedToTheMap)
+{
+    sut.place(0, {-1, -1}, {0, 0});
+    sut.place(1, {5, 3}, {7, 5});
+
+    EXPECT_THAT(blocked(sut.get_map()), ElementsAre(sf::Vector2i(0, 0), sf::Vector2i(5, 3)));
+    EXPECT_EQ(0, sut.get_count({-1, -1}));
+    EXPECT_EQ(0, sut.get_count({6, 3}));
+
+    sut.remove(0);
+    sut.remove(1);
+    EXPECT_THAT(blocked(sut.get_map()), IsEmpty());
+}
+
+TEST_F(Place, VersionChangesOnlyWhenATileDoes)
+{
+    auto version = sut.get_version();
+
+    sut.place(0, {0, 0}, {1, 0});
+    EXPECT_NE(version, sut.get_version());
+
+    // unmoved, and a footprint under another one, leave every tile as it was
+    version = sut.get_version();
+    sut.place(0, {0, 0}, {1, 0});
+    sut.place(1, {1, 0}, {1, 0});
+    EXPECT_EQ(version, sut.get_version());
+
+    sut.remove(0);
+    EXPECT_NE(version, sut.get_version());
+}
+
+class Sync : public TestableOccupancyGrid { };
+
+TEST_F(Sync, RemovesFootprintsWhichWereNotPlaced)
+{
+    sut.begin_sync();
+    sut.place(0, {0, 0}, {0, 0});
+    sut.place(1, {1, 1}, {1, 1});
+    sut.end_sync();
+
+    sut.begin_sync();
+    sut.place(1, {1, 1}, {1, 1});
+    sut.end_sync();
+
+    EXPECT_THAT(blocked(sut.get_map()), ElementsAre(sf::Vector2i(1, 1)));
+}
+
+TEST_F(Sync, ResizingClearsEverything_UnlessTheSizeIsUnchanged)
+{
+    sut.place(0, {0, 0}, {0, 0});
+
+    sut.resize({6, 4});
+    EXPECT_EQ(1, sut.get_count({0, 0}));
+
+    sut.resize({2, 2});
+    EXPECT_EQ(0, sut.get_count({0, 0}));
+    EXPECT_EQ(2, sut.get_map().get_width());
+    EXPECT_EQ(2, sut.get_map().get_height());
+}
+
+class View : public TestableOccupancyGrid { };
+
+TEST_F(View, IgnoresTheGivenEntity)
+{
+    sut.place(0, {0, 0}, {1, 0});
+    sut.place(1, {1, 0}, {1, 1});
+
+    OccupancyGrid::View view(sut, 0);
+    EXPECT_THAT(blocked(view), ElementsAre(sf::Vector2i(1, 0), sf::Vector2i(1, 1)));
+}
+
+TEST_F(View, LeavesTheGridAsItIs)
+{
+    sut.place(0, {0, 0}, {1, 0});
+    const auto version = sut.get_version();
+
+    OccupancyGrid::View view(sut, 0);
+    EXPECT_THAT(blocked(view), IsEmpty());
+
+    EXPECT_THAT(blocked(sut.get_map()), ElementsAre(sf::Vector2i(0, 0), sf::Vector2i(1, 0)));
+    EXPECT_EQ(1, sut.get_count({0, 0}));
+    EXPECT_EQ(version, sut.get_version());
+}
+
+TEST_F(View, UnknownEntity_SeesTheWholeGrid)
+{
+    sut.place(0, {0, 0}, {0, 0});
+
+    OccupancyGrid::View view(sut, 42);
+    EXPECT_THAT(blocked(view), ElementsAre(sf::Vector2i(0, 0)));
+}
+
+TEST_F(View, FootprintAcrossWords_IsClear)
+{
+    sut.resize({70, 2});
+    sut.place(0, {62, 0}, {65, 1});
+    sut.place(1, {66, 0}, {66, 0});
+
+    OccupancyGrid::View view(sut, 0);
+    EXPECT_TRUE(view.is_clear({62, 0}, {4, 2}));
+    EXPECT_FALSE(view.is_clear({62, 0}, {5, 1}));
+    EXPECT_TRUE(view.is_clear({63, 1}, {5, 1}));
+    EXPECT_THAT(blocked(view), ElementsAre(sf::Vector2i(66, 0)));
+
+    EXPECT_FALSE(sut.get_map().is_clear({62, 0}, {1, 1}));
+}
+
+TEST_F(View, MovedView_KeepsTheFootprintOut)
+{
+    sut.place(0, {0, 0}, {0, 0});
+
+    OccupancyGrid::View first(sut, 0);
+    OccupancyGrid::View second(std::move(first));
+    EXPECT_THAT(blocked(second), IsEmpty());
+    EXPECT_EQ(1, sut.get_count({0, 0}));
+}
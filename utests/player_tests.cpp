@@ -49,11 +49,12 @@ TEST_F(Components, Graphics_ReturnsRectangleForThisPlayer)
     physics->set_position({100.1f, 200.2f});
     physics->set_dimensions({10.1f, 20.2f});
 
-    const auto renderings = sut.get_component<Graphics>()->render();
-    const auto* graphic = static_cast<const sf::RectangleShape*>(renderings[0]);
-
-    EXPECT_EQ(sf::Vector2f(100.f, 200.f), graphic->getPosition());
-    EXPECT_EQ(sf::Vector2f(10.1f, 20.2f), graphic->getSize());
+    Graphics::Renderings renderings;
+    sut.get_component<Graphics>()->render(renderings);
+    ASSERT_EQ(1, renderings.size());
+    EXPECT_EQ(Rendering::Shape::RECTANGLE, renderings[0].shape);
+    EXPECT_EQ(sf::Vector2f(100.f, 200.f), renderings[0].position);
+    EXPECT_EQ(sf::Vector2f(10.1f, 20.2f), renderings[0].dimensions);
 }
 
 class Movement : public TestablePlayer
@@ -0,0 +1,159 @@
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include <gtest.h>
+#include <gmock.h>
+
+#include "profiler.hpp"
+
+using namespace testing;
+
+class TestableProfiler : public Test
+{
+protected:
+    static constexpr std::int64_t MS = 1000000; ///< in ns
+
+    Profiler sut;
+
+    std::string trace()
+    {
+        std::ostringstream out;
+        sut.write_chrome_trace(out);
+        return out.str();
+    }
+
+    /** \return Number of times the given text appears in the trace. */
+    std::size_t count_in_trace(const std::string& text)
+    {
+        const auto json = trace();
+        std::size_t count = 0;
+        for (auto found = json.find(text); found != std::string::npos;
+             found = json.find(text, found + text.size())) {
+            ++count;
+        }
+        return count;
+    }
+};
+constexpr std::int64_t TestableProfiler::MS;
+
+TEST_F(TestableProfiler, Zone_RecordsASampleOfItsScope)
+{
+    {
+        Profiler::Zone zone(sut, "zone");
+    }
+
+    EXPECT_EQ(1, count_in_trace("\"name\":\"zone\""));
+}
+
+TEST_F(TestableProfiler, Zone_WhileDisabled_RecordsNothing)
+{
+    sut.set_enabled(false);
+    {
+        Profiler::Zone zone(sut, "zone");
+    }
+
+    EXPECT_EQ(0, count_in_trace("\"name\""));
+}
+
+TEST_F(TestableProfiler, EndFrame_TotalsEachZoneOverTheFrame)
+{
+    sut.record("update", 0, 2 * MS);
+    sut.record("update", 5 * MS, 6 * MS);
+    sut.record("render", 6 * MS, 10 * MS);
+    sut.end_frame();
+
+    EXPECT_FLOAT_EQ(3.f, sut.get_stats("update").last);
+    EXPECT_FLOAT_EQ(4.f, sut.get_stats("render").last);
+    EXPECT_EQ(1, sut.get_frame());
+}
+
+TEST_F(TestableProfiler, EndFrame_ListsZonesInTheOrderFirstSeen)
+{
+    sut.record("prepare", 0, MS);
+    sut.end_frame();
+    sut.record("update", 0, MS);
+    sut.record("prepare", 0, MS);
+    sut.end_frame();
+
+    ASSERT_EQ(2, sut.get_zones().size());
+    EXPECT_STREQ("prepare", sut.get_zones()[0]);
+    EXPECT_STREQ("update", sut.get_zones()[1]);
+}
+
+TEST_F(TestableProfiler, EndFrame_ZoneMissingFromAFrame_TookNoTime)
+{
+    sut.record("path_search", 0, MS);
+    sut.end_frame();
+    sut.end_frame();
+
+    const auto stats = sut.get_stats("path_search");
+    EXPECT_FLOAT_EQ(0.f, stats.last);
+    EXPECT_FLOAT_EQ(1.f, stats.max);
+}
+
+TEST_F(TestableProfiler, GetStats_GivesPercentilesOverTheFramesKept)
+{
+    for (int ms = 1; ms <= 100; ++ms) {
+        sut.record("update", 0, ms * MS);
+        sut.end_frame();
+    }
+
+    const auto stats = sut.get_stats("update");
+    EXPECT_FLOAT_EQ(100.f, stats.last);
+    EXPECT_FLOAT_EQ(50.f, stats.p50);
+    EXPECT_FLOAT_EQ(95.f, stats.p95);
+    EXPECT_FLOAT_EQ(99.f, stats.p99);
+    EXPECT_FLOAT_EQ(100.f, stats.max);
+}
+
+TEST_F(TestableProfiler, GetStats_ForgetsFramesPastTheCapacity)
+{
+    sut.record("update", 0, 100 * MS);
+    sut.end_frame();
+    for (std::size_t frame = 0; frame < Profiler::FRAME_CAPACITY; ++frame) {
+        sut.record("update", 0, MS);
+        sut.end_frame();
+    }
+
+    EXPECT_FLOAT_EQ(1.f, sut.get_stats("update").max);
+}
+
+TEST_F(TestableProfiler, GetStats_ForAnUnknownZone_IsZero)
+{
+    sut.end_frame();
+
+    EXPECT_FLOAT_EQ(0.f, sut.get_stats("unknown").max);
+}
+
+TEST_F(TestableProfiler, Record_KeepsOnlyTheNewestSamplesOfEachThread)
+{
+    for (std::size_t ndx = 0; ndx < Profiler::SAMPLE_CAPACITY + 10; ++ndx) {
+        sut.record(ndx < 10 ? "old" : "new", 0, MS);
+    }
+
+    EXPECT_EQ(0, count_in_trace("\"name\":\"old\""));
+    EXPECT_EQ(Profiler::SAMPLE_CAPACITY, count_in_trace("\"name\":\"new\""));
+}
+
+TEST_F(TestableProfiler, Record_FromAnotherThread_IsTracedAsThatThread)
+{
+    sut.record("main", 0, MS);
+    std::thread worker([this] { sut.record("worker", 0, 2 * MS); });
+    worker.join();
+    sut.end_frame();
+
+    EXPECT_EQ(1, count_in_trace("\"name\":\"main\",\"ph\":\"X\",\"pid\":0,\"tid\":0"));
+    EXPECT_EQ(1, count_in_trace("\"name\":\"worker\",\"ph\":\"X\",\"pid\":0,\"tid\":1"));
+    EXPECT_FLOAT_EQ(2.f, sut.get_stats("worker").last);
+}
+
+TEST_F(TestableProfiler, WriteChromeTrace_GivesTimesInMicroseconds)
+{
+    sut.record("zone", 1500, 1500 + 2 * MS);
+
+    const auto json = trace();
+    EXPECT_EQ(0, json.find("{\"traceEvents\":["));
+    EXPECT_NE(std::string::npos, json.find("\"ts\":1.5,\"dur\":2000.0"));
+    EXPECT_NE(std::string::npos, json.find("],\"displayTimeUnit\":\"ms\"}"));
+}
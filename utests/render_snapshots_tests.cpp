@@ -0,0 +1,138 @@
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include <gtest.h>
+#include <gmock.h>
+
+#include "render_snapshots.hpp"
+
+using namespace testing;
+
+class TestableRenderSnapshots : public Test
+{
+protected:
+    RenderSnapshots sut;
+
+    /** \brief Publishes a snapshot of count circles, all at <x, 0>. */
+    void publish(float x, std::size_t count = 1)
+    {
+        auto& renderings = sut.write();
+        for (std::size_t ndx = 0; ndx < count; ++ndx) {
+            renderings.push_back(Rendering::circle({x, 0.f}, 1.f, sf::Color::Red));
+        }
+        sut.publish();
+    }
+};
+
+TEST_F(TestableRenderSnapshots, Read_GivesTheSnapshotPublished)
+{
+    publish(1.f, 2);
+
+    const auto* renderings = sut.read();
+    ASSERT_NE(nullptr, renderings);
+    ASSERT_EQ(2, renderings->size());
+    EXPECT_EQ(sf::Vector2f(1.f, 0.f), (*renderings)[0].position);
+
+    // the next snapshot starts empty, in the other buffer
+    publish(2.f);
+
+    const auto* next = sut.read();
+    ASSERT_NE(nullptr, next);
+    EXPECT_NE(renderings, next);
+    ASSERT_EQ(1, next->size());
+    EXPECT_EQ(sf::Vector2f(2.f, 0.f), (*next)[0].position);
+}
+
+TEST_F(TestableRenderSnapshots, Write_KeepsTheCapacityOfTheBuffer)
+{
+    publish(1.f, 100);
+    sut.read();
+    publish(2.f);
+    sut.read();
+
+    EXPECT_LE(100, sut.write().capacity());
+}
+
+TEST_F(TestableRenderSnapshots, Read_WaitsForASnapshot)
+{
+    std::atomic<bool> is_read(false);
+    std::thread reader([this, &is_read] {
+        sut.read();
+        is_read = true;
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_FALSE(is_read);
+
+    publish(1.f);
+    reader.join();
+    EXPECT_TRUE(is_read);
+}
+
+TEST_F(TestableRenderSnapshots, Write_WaitsForTheLastSnapshotToBeRead)
+{
+    publish(1.f);
+
+    std::atomic<bool> is_written(false);
+    std::thread writer([this, &is_written] {
+        sut.write();
+        is_written = true;
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_FALSE(is_written);
+
+    sut.read();
+    writer.join();
+    EXPECT_TRUE(is_written);
+}
+
+TEST_F(TestableRenderSnapshots, Close_StopsWaiting)
+{
+    std::thread reader([this] { EXPECT_EQ(nullptr, sut.read()); });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    sut.close();
+    reader.join();
+
+    // the last snapshot is still read
+    RenderSnapshots closing;
+    closing.write();
+    closing.publish();
+    closing.close();
+    closing.write();
+    EXPECT_NE(nullptr, closing.read());
+    EXPECT_EQ(nullptr, closing.read());
+}
+
+TEST_F(TestableRenderSnapshots, AcrossThreads_EverySnapshotReadIsWhole)
+{
+    const int snapshot_count = 500;
+    std::thread writer([this, snapshot_count] {
+        for (int snapshot = 1; snapshot <= snapshot_count; ++snapshot) {
+            publish(static_cast<float>(snapshot), 64);
+        }
+        sut.close();
+    });
+
+    // each snapshot read is the one after the last, and only ever holds its own renderings
+    float last = 0.f;
+    int mixed = 0;
+    while (const auto* renderings = sut.read()) {
+        ASSERT_EQ(64, renderings->size());
+        const float x = renderings->front().position.x;
+        EXPECT_EQ(last + 1.f, x);
+        last = x;
+
+        std::this_thread::yield();
+        for(const auto& rendering : *renderings) {
+            mixed += rendering.position.x != x;
+        }
+    }
+    writer.join();
+
+    EXPECT_EQ(snapshot_count, last);
+    EXPECT_EQ(0, mixed);
+}
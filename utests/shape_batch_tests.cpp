@@ -0,0 +1,147 @@
+#include <cmath>
+
+#include <gtest.h>
+#include <gmock.h>
+
+#include "shape_batch.hpp"
+
+using namespace testing;
+
+class TestableShapeBatch : public Test
+{
+protected:
+    ShapeBatch sut;
+
+    /** \brief Vertices of the batch from first, up to but excluding last. */
+    std::vector<sf::Vector2f> positions(std::size_t first, std::size_t last) const
+    {
+        std::vector<sf::Vector2f> points;
+        for (auto ndx = first; ndx < last; ++ndx) {
+            points.push_back(sut.get_vertices()[ndx].position);
+        }
+        return points;
+    }
+
+    /** \brief Area covered by the triangles of the batch, from first up to but excluding last. */
+    float area(std::size_t first, std::size_t last) const
+    {
+        float total = 0.f;
+        for (auto ndx = first; ndx + 2 < last + 1; ndx += 3) {
+            const auto a = sut.get_vertices()[ndx].position;
+            const auto b = sut.get_vertices()[ndx + 1].position;
+            const auto c = sut.get_vertices()[ndx + 2].position;
+            total += std::abs((b.x - a.x) * (c.y - a.y) - (c.x - a.x) * (b.y - a.y)) / 2.f;
+        }
+        return total;
+    }
+};
+
+class Add : public TestableShapeBatch { };
+
+TEST_F(Add, DrawsTrianglesOnly)
+{
+    EXPECT_EQ(sf::Triangles, sut.get_vertices().getPrimitiveType());
+    EXPECT_EQ(0, sut.get_vertices().getVertexCount());
+}
+
+TEST_F(Add, Rectangle_IsTwoTrianglesCenteredOnItsPosition)
+{
+    sut.add(Rendering::rectangle({10.f, 20.f}, {4.f, 6.f}, sf::Color::Blue));
+
+    ASSERT_EQ(6, sut.get_vertices().getVertexCount());
+    EXPECT_THAT(positions(0, 6), ElementsAre(sf::Vector2f(8.f, 17.f), sf::Vector2f(12.f, 17.f),
+                                             sf::Vector2f(12.f, 23.f), sf::Vector2f(8.f, 17.f),
+                                             sf::Vector2f(12.f, 23.f), sf::Vector2f(8.f, 23.f)));
+    for (std::size_t ndx = 0; ndx < 6; ++ndx) {
+        EXPECT_EQ(sf::Color::Blue, sut.get_vertices()[ndx].color);
+    }
+}
+
+TEST_F(Add, Rectangle_WithAnOutline_FramesTheFillOutside)
+{
+    sut.add(Rendering::rectangle({10.f, 10.f}, {10.f, 8.f}, sf::Color::Green, 1.f,
+                                 sf::Color::Black));
+
+    // the whole fill, then four strips of outline around it, as sf::RectangleShape draws them
+    ASSERT_EQ(30, sut.get_vertices().getVertexCount());
+    EXPECT_THAT(positions(0, 6), Contains(sf::Vector2f(5.f, 6.f)));
+    EXPECT_THAT(positions(0, 6), Contains(sf::Vector2f(15.f, 14.f)));
+    EXPECT_FLOAT_EQ(10.f * 8.f, area(0, 6));
+    EXPECT_FLOAT_EQ(12.f * 10.f - 10.f * 8.f, area(6, 30));
+    EXPECT_THAT(positions(6, 30), Contains(sf::Vector2f(4.f, 5.f)));
+    EXPECT_THAT(positions(6, 30), Contains(sf::Vector2f(16.f, 15.f)));
+
+    EXPECT_EQ(sf::Color::Green, sut.get_vertices()[0].color);
+    for (std::size_t ndx = 6; ndx < 30; ++ndx) {
+        EXPECT_EQ(sf::Color::Black, sut.get_vertices()[ndx].color);
+    }
+}
+
+TEST_F(Add, Rectangle_WithANegativeOutline_FramesTheFillInside)
+{
+    sut.add(Rendering::rectangle({10.f, 10.f}, {10.f, 8.f}, sf::Color::Green, -1.f,
+                                 sf::Color::Black));
+
+    ASSERT_EQ(30, sut.get_vertices().getVertexCount());
+    EXPECT_THAT(positions(0, 6), Contains(sf::Vector2f(6.f, 7.f)));
+    EXPECT_THAT(positions(0, 6), Contains(sf::Vector2f(14.f, 13.f)));
+    EXPECT_FLOAT_EQ(8.f * 6.f, area(0, 6));
+    EXPECT_FLOAT_EQ(10.f * 8.f - 8.f * 6.f, area(6, 30));
+}
+
+TEST_F(Add, Rectangle_WithANegativeOutlineThickerThanItself_IsAllOutline)
+{
+    sut.add(Rendering::rectangle({10.f, 10.f}, {4.f, 4.f}, sf::Color::Green, -5.f,
+                                 sf::Color::Black));
+
+    EXPECT_FLOAT_EQ(0.f, area(0, 6));
+    EXPECT_FLOAT_EQ(16.f, area(6, sut.get_vertices().getVertexCount()));
+}
+
+TEST_F(Add, Circle_IsAFanOfTrianglesAroundItsPosition)
+{
+    sut.add(Rendering::circle({10.f, 20.f}, 5.f, sf::Color::Red));
+
+    const auto count = sut.get_vertices().getVertexCount();
+    ASSERT_EQ(3 * ShapeBatch::CIRCLE_POINT_COUNT, count);
+    for (std::size_t ndx = 0; ndx < count; ++ndx) {
+        const auto& vertex = sut.get_vertices()[ndx];
+        const auto offset = vertex.position - sf::Vector2f(10.f, 20.f);
+        const float distance = std::sqrt(offset.x * offset.x + offset.y * offset.y);
+
+        EXPECT_EQ(sf::Color::Red, vertex.color);
+        if (ndx % 3 == 0) {
+            EXPECT_FLOAT_EQ(0.f, distance);
+        } else {
+            EXPECT_NEAR(5.f, distance, 1e-4f);
+        }
+    }
+
+    // a regular polygon of CIRCLE_POINT_COUNT sides, inscribed in the circle
+    const float pi = 3.141592654f;
+    const float sides = ShapeBatch::CIRCLE_POINT_COUNT;
+    EXPECT_NEAR(sides / 2.f * 25.f * std::sin(2.f * pi / sides), area(0, count), 1e-3f);
+}
+
+TEST_F(Add, Renderings_AreBatchedInOrder)
+{
+    sut.add(Renderer::Renderings{Rendering::rectangle({0.f, 0.f}, {2.f, 2.f}, sf::Color::Red),
+                                 Rendering::rectangle({5.f, 5.f}, {2.f, 2.f}, sf::Color::Blue)});
+    sut.add(Rendering::rectangle({9.f, 9.f}, {2.f, 2.f}, sf::Color::Green));
+
+    ASSERT_EQ(18, sut.get_vertices().getVertexCount());
+    EXPECT_EQ(sf::Color::Red, sut.get_vertices()[0].color);
+    EXPECT_EQ(sf::Color::Blue, sut.get_vertices()[6].color);
+    EXPECT_EQ(sf::Color::Green, sut.get_vertices()[12].color);
+}
+
+class Clear : public TestableShapeBatch { };
+
+TEST_F(Clear, RemovesEveryShape)
+{
+    sut.add(Rendering::circle({10.f, 20.f}, 5.f, sf::Color::Red));
+    sut.clear();
+
+    EXPECT_EQ(0, sut.get_vertices().getVertexCount());
+    EXPECT_EQ(sf::Triangles, sut.get_vertices().getPrimitiveType());
+}
@@ -0,0 +1,248 @@
+#include <atomic>
+
+#include <gtest.h>
+#include <gmock.h>
+
+#include "simulation.hpp"
+
+#include "barrier.hpp"
+#include "bullet.hpp"
+#include "enemy.hpp"
+#include "game.hpp"
+#include "gun.hpp"
+#include "components/physics.hpp"
+#include "mocks/entity_mock.hpp"
+
+using namespace testing;
+
+/** \brief Records how many entities had refreshed by the time it updates. */
+class RefreshCounter : public Entity
+{
+public:
+    explicit RefreshCounter(std::atomic<int>& refresh_count) :
+        refresh_count_(refresh_count),
+        seen_count_(0)
+    { }
+
+    void refresh(sf::Time frame_length) override { ++refresh_count_; }
+
+    sf::Time update(sf::Time elapsed) override
+    {
+        seen_count_ = refresh_count_;
+        return elapsed;
+    }
+
+    inline int get_seen_count() const { return seen_count_; }
+
+private:
+    std::atomic<int>& refresh_count_;
+    int seen_count_;
+};
+
+/** \brief Holds down the trigger of a gun, firing at the same target every step. */
+class Trigger : public Entity
+{
+public:
+    Trigger(Gun& gun, sf::Vector2f target) :
+        gun_(gun),
+        target_(target)
+    { }
+
+    void prepare() override { gun_.fire(target_); }
+    sf::Time update(sf::Time elapsed) override { return elapsed; }
+
+private:
+    Gun& gun_;
+    sf::Vector2f target_;
+};
+
+class TestableSimulation : public Test
+{
+protected:
+    const sf::Time step_ = sf::milliseconds(10);
+
+    Simulation sut;
+    NiceMock<EntityMock>* entity_;
+
+    TestableSimulation() :
+        sut(step_, 2),
+        entity_(new NiceMock<EntityMock>)
+    {
+        Game::instance().entity_collection().emplace_back(entity_);
+        ON_CALL(*entity_, update(_)).WillByDefault(ReturnArg<0>());
+    }
+
+    void TearDown() override
+    {
+        Game::instance().reset();
+    }
+};
+
+class Advance : public TestableSimulation { };
+
+TEST_F(Advance, RunsTheWholeStepsCovered_AndCarriesTheRest)
+{
+    EXPECT_EQ(2, sut.advance(sf::milliseconds(25)));
+    EXPECT_FLOAT_EQ(0.5f, sut.get_interpolation());
+    EXPECT_FLOAT_EQ(0.5f, Game::instance().get_interpolation());
+
+    EXPECT_EQ(1, sut.advance(sf::milliseconds(5)));
+    EXPECT_FLOAT_EQ(0.f, sut.get_interpolation());
+
+    EXPECT_EQ(0, sut.advance(sf::milliseconds(4)));
+    EXPECT_EQ(3, sut.get_step_count());
+}
+
+TEST_F(Advance, EveryUpdateIsForOneStep_WhateverTheFrameLength)
+{
+    EXPECT_CALL(*entity_, update(step_)).Times(2).WillRepeatedly(ReturnArg<0>());
+
+    sut.advance(sf::milliseconds(13));
+    sut.advance(sf::milliseconds(7));
+}
+
+TEST_F(Advance, TooFarBehind_DropsTheTimePastTheMostSteps)
+{
+    EXPECT_EQ(2, sut.advance(sf::milliseconds(55)));
+    EXPECT_FLOAT_EQ(0.5f, sut.get_interpolation());
+
+    EXPECT_EQ(0, sut.advance(sf::milliseconds(4)));
+}
+
+class Step : public TestableSimulation { };
+
+TEST_F(Step, RemovesDeadEntities)
+{
+    ON_CALL(*entity_, update(_)).WillByDefault(Invoke([this](sf::Time elapsed) {
+        entity_->kill();
+        return elapsed;
+    }));
+
+    sut.step();
+
+    EXPECT_TRUE(Game::instance().entities().empty());
+}
+
+TEST_F(Step, InterpolatesFromThePositionBeforeTheStep)
+{
+    auto* physics = entity_->add_component<Physics>();
+    physics->set_position({10.f, 0.f});
+    physics->set_velocity({100.f, 0.f});
+    ON_CALL(*entity_, update(_)).WillByDefault(Invoke([physics](sf::Time elapsed) {
+        physics->update(elapsed.asSeconds());
+        return elapsed;
+    }));
+
+    sut.step();
+    sut.step();
+
+    EXPECT_EQ(sf::Vector2f(12.f, 0.f), physics->get_position());
+    EXPECT_EQ(sf::Vector2f(11.f, 0.f), physics->get_interpolated_position(0.f));
+    EXPECT_EQ(sf::Vector2f(11.5f, 0.f), physics->get_interpolated_position(0.5f));
+}
+
+TEST_F(Step, RefreshesEveryEntity_BeforeAnyUpdates)
+{
+    std::atomic<int> refresh_count(0);
+    std::vector<RefreshCounter*> counters;
+    for (int ndx = 0; ndx < 32; ++ndx) {
+        counters.push_back(new RefreshCounter(refresh_count));
+        Game::instance().entity_collection().emplace_back(counters.back());
+    }
+
+    sut.step();
+
+    EXPECT_EQ(32, refresh_count);
+    for(auto* counter : counters) {
+        EXPECT_EQ(32, counter->get_seen_count());
+    }
+}
+
+TEST_F(Step, MovesTheSimulatedTimeOnByOneStep)
+{
+    sut.step();
+    sut.step();
+
+    EXPECT_EQ(step_ * 2.f, Game::instance().get_simulated_time());
+}
+
+/** \brief Runs a small scene of enemies chasing a firing player, to compare runs against. */
+class Reproducibility : public Test
+{
+protected:
+    /** \brief Everything about the scene which the simulation may change. */
+    struct State
+    {
+        std::vector<sf::Vector2f> positions; ///< of the entities with physics, in order
+        std::size_t projectile_count;
+        sf::Time simulated_time;
+    };
+
+    void TearDown() override
+    {
+        Game::instance().reset();
+    }
+
+    /** \brief Builds the scene afresh, and advances it by the given frame length, frame_count
+     * times. */
+    State run(sf::Time frame_length, int frame_count)
+    {
+        auto& game = Game::instance();
+        game.reset();
+
+        auto* player = game.add_player();
+        player->get_component<Physics>()->set_position({600.f, 600.f});
+
+        // fired away from the enemies, so every bullet is still in flight at the end
+        auto* gun = new Gun(*player);
+        gun->set_ammunition(std::make_unique<BulletAmmunition>());
+        game.entity_collection().emplace_back(gun);
+        game.entity_collection().emplace_back(new Trigger(*gun, {1200.f, 600.f}));
+
+        auto* barrier = new Barrier;
+        barrier->get_component<Physics>()->set_position({300.f, 400.f});
+        barrier->get_component<Physics>()->set_dimensions({200.f, 20.f});
+        game.entity_collection().emplace_back(barrier);
+
+        for(auto position : {sf::Vector2f(100.f, 100.f), sf::Vector2f(100.f, 1100.f),
+                             sf::Vector2f(300.f, 300.f), sf::Vector2f(200.f, 600.f)}) {
+            auto* enemy = new Enemy;
+            enemy->get_component<Physics>()->set_position(position);
+            game.entity_collection().emplace_back(enemy);
+        }
+
+        Simulation simulation;
+        for (int frame = 0; frame < frame_count; ++frame) {
+            simulation.advance(frame_length);
+        }
+
+        State state;
+        for(const auto& entity : game.entities()) {
+            if (entity->has_component<Physics>()) {
+                state.positions.push_back(entity->get_component<Physics>()->get_position());
+            }
+        }
+        state.projectile_count = gun->get_projectile_count();
+        state.simulated_time = game.get_simulated_time();
+        return state;
+    }
+};
+
+TEST_F(Reproducibility, TheSameStepsAtDifferentFrameRates_GiveTheSameState)
+{
+    // both run 120 steps, a second of simulated time, however long they take on the wall clock
+    const auto slow = run(sf::milliseconds(25), 40);
+    const auto fast = run(sf::milliseconds(10), 100);
+
+    EXPECT_EQ(Simulation::DEFAULT_STEP * 120.f, slow.simulated_time);
+    EXPECT_EQ(slow.simulated_time, fast.simulated_time);
+
+    // the rate limits are on simulated time: a shot every 0.2s of it, and the first straight away
+    EXPECT_EQ(5, slow.projectile_count);
+    EXPECT_EQ(slow.projectile_count, fast.projectile_count);
+
+    ASSERT_EQ(slow.positions.size(), fast.positions.size());
+    for (std::size_t ndx = 0; ndx < slow.positions.size(); ++ndx) {
+        EXPECT_EQ(slow.positions[ndx], fast.positions[ndx]) << "entity " << ndx;
+    }
+}
@@ -0,0 +1,143 @@
+#include <gtest.h>
+#include <gmock.h>
+
+#include "spatial_hash.hpp"
+
+#include "components/physics.hpp"
+#include "mocks/entity_mock.hpp"
+
+using namespace testing;
+
+class TestableSpatialHash : public Test
+{
+protected:
+    SpatialHash sut;
+    SpatialHash::Candidates candidates;
+
+    TestableSpatialHash() :
+        sut({20.f, 20.f}, 64)
+    { }
+
+    /** \brief Adds an entity of the given dimensions, centered on the given position. */
+    EntityMock& add(sf::Vector2f position, sf::Vector2f dimensions = {10.f, 10.f})
+    {
+        entities_.emplace_back(new EntityMock);
+        auto& entity = *entities_.back();
+
+        auto* physics = entity.add_component<Physics>();
+        physics->set_position(position);
+        physics->set_dimensions(dimensions);
+
+        sut.insert(entity);
+        return entity;
+    }
+
+    const SpatialHash::Candidates& query(sf::Vector2f position, sf::Vector2f dimensions = {10.f, 10.f},
+                                         sf::Vector2f trajectory = {0.f, 0.f})
+    {
+        candidates.clear();
+        sut.query(AABB(position, dimensions, trajectory), candidates);
+        return candidates;
+    }
+
+private:
+    std::vector<std::unique_ptr<EntityMock>> entities_;
+};
+
+class Query : public TestableSpatialHash { };
+
+TEST_F(Query, FindsEntitiesInTheSameCells_IgnoresDistantEntities)
+{
+    auto& near = add({30.f, 30.f});
+    add({300.f, 30.f});
+    add({30.f, 300.f});
+
+    EXPECT_THAT(query({35.f, 35.f}), ElementsAre(&near));
+    EXPECT_THAT(query({500.f, 500.f}), IsEmpty());
+}
+
+TEST_F(Query, FindsEntitiesAlongTheTrajectory)
+{
+    add({30.f, 30.f});
+    auto& target = add({230.f, 30.f});
+
+    EXPECT_THAT(query({130.f, 30.f}), IsEmpty());
+    EXPECT_THAT(query({130.f, 30.f}, {10.f, 10.f}, {100.f, 0.f}), ElementsAre(&target));
+}
+
+TEST_F(Query, LargeEntitiesAreFoundOnce_InInsertionOrder)
+{
+    auto& wall = add({200.f, 10.f}, {400.f, 20.f});
+    auto& first = add({50.f, 15.f});
+    auto& second = add({45.f, 25.f});
+
+    EXPECT_THAT(query({50.f, 20.f}, {40.f, 40.f}), ElementsAre(&wall, &first, &second));
+    EXPECT_THAT(query({390.f, 10.f}), ElementsAre(&wall));
+}
+
+TEST_F(Query, AppendsToTheGivenCandidates)
+{
+    auto& entity = add({30.f, 30.f});
+
+    candidates.push_back(nullptr);
+    sut.query(AABB({30.f, 30.f}, {10.f, 10.f}), candidates);
+
+    EXPECT_THAT(candidates, ElementsAre(nullptr, &entity));
+}
+
+class Update : public TestableSpatialHash { };
+
+TEST_F(Update, MovesEntityToItsNewCells)
+{
+    auto& entity = add({30.f, 30.f});
+
+    entity.get_component<Physics>()->set_position({330.f, 330.f});
+    EXPECT_THAT(query({330.f, 330.f}), IsEmpty());
+
+    sut.update(entity);
+    EXPECT_THAT(query({330.f, 330.f}), ElementsAre(&entity));
+    EXPECT_THAT(query({30.f, 30.f}), IsEmpty());
+}
+
+TEST_F(Update, IgnoresEntitiesNotInserted)
+{
+    EntityMock entity;
+    entity.add_component<Physics>()->set_position({30.f, 30.f});
+
+    sut.update(entity);
+    EXPECT_THAT(query({30.f, 30.f}), IsEmpty());
+}
+
+class Clear : public TestableSpatialHash { };
+
+TEST_F(Clear, RemovesAllEntities)
+{
+    auto& entity = add({30.f, 30.f});
+
+    sut.clear();
+    EXPECT_EQ(0, sut.size());
+    EXPECT_THAT(query({30.f, 30.f}), IsEmpty());
+
+    // updating a cleared entity has no effect
+    sut.update(entity);
+    EXPECT_THAT(query({30.f, 30.f}), IsEmpty());
+}
+
+class Rebuild : public TestableSpatialHash { };
+
+TEST_F(Rebuild, InsertsEntitiesWithPhysics_InGivenOrder)
+{
+    SpatialHash::Entities entities;
+    entities.emplace_back(new EntityMock);
+    entities.emplace_back(new EntityMock);
+    entities.emplace_back(new EntityMock);
+    entities[0]->add_component<Physics>()->set_position({35.f, 35.f});
+    entities[2]->add_component<Physics>()->set_position({30.f, 30.f});
+
+    add({300.f, 300.f});
+    sut.rebuild(entities);
+
+    EXPECT_EQ(2, sut.size());
+    EXPECT_THAT(query({30.f, 30.f}), ElementsAre(entities[0].get(), entities[2].get()));
+    EXPECT_THAT(query({300.f, 300.f}), IsEmpty());
+}
@@ -0,0 +1,266 @@
+#include <gtest.h>
+#include <gmock.h>
+
+#include <random>
+
+#include "sweep_and_prune.hpp"
+
+#include "components/physics.hpp"
+#include "mocks/entity_mock.hpp"
+
+using namespace testing;
+
+class TestableSweepAndPrune : public Test
+{
+protected:
+    SweepAndPrune sut;
+    SweepAndPrune::Candidates candidates;
+    SweepAndPrune::Pairs pairs;
+    SweepAndPrune::Entities entities;
+
+    TestableSweepAndPrune() :
+        sut(100.f)
+    { }
+
+    /** \brief Adds an entity of the given dimensions, centered on the given position.
+     *
+     * The entity is indexed from the next rebuild(). */
+    EntityMock& add(sf::Vector2f position, sf::Vector2f dimensions = {10.f, 10.f})
+    {
+        entities.emplace_back(new EntityMock);
+        auto& entity = static_cast<EntityMock&>(*entities.back());
+
+        auto* physics = entity.add_component<Physics>();
+        physics->set_position(position);
+        physics->set_dimensions(dimensions);
+
+        return entity;
+    }
+
+    void move(Entity& entity, sf::Vector2f position)
+    {
+        entity.get_component<Physics>()->set_position(position);
+    }
+
+    const SweepAndPrune::Candidates& query(sf::Vector2f position, sf::Vector2f dimensions = {10.f, 10.f},
+                                           sf::Vector2f trajectory = {0.f, 0.f})
+    {
+        candidates.clear();
+        sut.query(AABB(position, dimensions, trajectory), candidates);
+        return candidates;
+    }
+
+    const SweepAndPrune::Pairs& get_pairs()
+    {
+        pairs.clear();
+        sut.pairs(pairs);
+        return pairs;
+    }
+};
+
+class Query : public TestableSweepAndPrune { };
+
+TEST_F(Query, FindsOverlappingEntities_IgnoresDistantEntities)
+{
+    auto& near = add({30.f, 30.f});
+    add({300.f, 30.f});
+    add({30.f, 300.f});
+    sut.rebuild(entities);
+
+    EXPECT_THAT(query({35.f, 35.f}), ElementsAre(&near));
+    EXPECT_THAT(query({500.f, 500.f}), IsEmpty());
+}
+
+TEST_F(Query, FindsEntitiesAlongTheTrajectory)
+{
+    add({30.f, 30.f});
+    auto& target = add({230.f, 30.f});
+    sut.rebuild(entities);
+
+    EXPECT_THAT(query({130.f, 30.f}), IsEmpty());
+    EXPECT_THAT(query({130.f, 30.f}, {10.f, 10.f}, {100.f, 0.f}), ElementsAre(&target));
+}
+
+TEST_F(Query, FindsLargeEntities_InRebuildOrder)
+{
+    auto& wall = add({200.f, 10.f}, {400.f, 20.f});
+    auto& first = add({50.f, 15.f});
+    auto& second = add({45.f, 25.f});
+    add({300.f, 100.f});
+    sut.rebuild(entities);
+
+    EXPECT_THAT(query({50.f, 20.f}, {40.f, 40.f}), ElementsAre(&wall, &first, &second));
+    EXPECT_THAT(query({390.f, 10.f}), ElementsAre(&wall));
+}
+
+TEST_F(Query, FindsTouchingEntities)
+{
+    auto& entity = add({30.f, 30.f});
+    sut.rebuild(entities);
+
+    EXPECT_THAT(query({40.f, 30.f}), ElementsAre(&entity));
+    EXPECT_THAT(query({40.1f, 30.f}), IsEmpty());
+}
+
+TEST_F(Query, AppendsToTheGivenCandidates)
+{
+    auto& entity = add({30.f, 30.f});
+    sut.rebuild(entities);
+
+    candidates.push_back(nullptr);
+    sut.query(AABB({30.f, 30.f}, {10.f, 10.f}), candidates);
+
+    EXPECT_THAT(candidates, ElementsAre(nullptr, &entity));
+}
+
+class Rebuild : public TestableSweepAndPrune { };
+
+TEST_F(Rebuild, SkipsEntitiesWithoutPhysics)
+{
+    add({30.f, 30.f});
+    entities.emplace_back(new EntityMock);
+    sut.rebuild(entities);
+
+    EXPECT_EQ(1, sut.size());
+}
+
+TEST_F(Rebuild, KeepsMovedEntities_DropsRemovedEntities_AddsNewEntities)
+{
+    auto& moved = add({30.f, 30.f});
+    add({60.f, 30.f});
+    sut.rebuild(entities);
+
+    move(moved, {330.f, 30.f});
+    entities.erase(entities.begin() + 1);
+    auto& added = add({45.f, 30.f});
+    sut.rebuild(entities);
+
+    EXPECT_EQ(2, sut.size());
+    EXPECT_THAT(query({30.f, 30.f}, {40.f, 10.f}), ElementsAre(&added));
+    EXPECT_THAT(query({330.f, 30.f}), ElementsAre(&moved));
+}
+
+TEST_F(Rebuild, SweepsAlongTheAxisWithTheMostSpread)
+{
+    add({30.f, 30.f});
+    add({30.f, 300.f});
+    add({40.f, 600.f});
+    sut.rebuild(entities);
+    EXPECT_EQ(1, sut.get_sweep_axis());
+
+    move(*entities[1], {600.f, 30.f});
+    move(*entities[2], {300.f, 40.f});
+    sut.rebuild(entities);
+    EXPECT_EQ(0, sut.get_sweep_axis());
+}
+
+class Update : public TestableSweepAndPrune { };
+
+TEST_F(Update, MovesEntityToItsNewPosition)
+{
+    auto& entity = add({30.f, 30.f});
+    add({200.f, 30.f});
+    sut.rebuild(entities);
+
+    move(entity, {330.f, 330.f});
+    EXPECT_THAT(query({330.f, 330.f}), IsEmpty());
+
+    sut.update(entity);
+    EXPECT_THAT(query({330.f, 330.f}), ElementsAre(&entity));
+    EXPECT_THAT(query({30.f, 30.f}), IsEmpty());
+}
+
+TEST_F(Update, IgnoresEntitiesNotRebuilt)
+{
+    EntityMock entity;
+    entity.add_component<Physics>()->set_position({30.f, 30.f});
+
+    sut.update(entity);
+    EXPECT_THAT(query({30.f, 30.f}), IsEmpty());
+}
+
+class Pairs : public TestableSweepAndPrune { };
+
+TEST_F(Pairs, EmitsEachOverlappingPairOnce_InRebuildOrder)
+{
+    auto& first = add({30.f, 30.f});
+    auto& second = add({300.f, 30.f});
+    auto& third = add({35.f, 35.f});
+    auto& fourth = add({305.f, 25.f});
+    add({600.f, 600.f});
+    sut.rebuild(entities);
+
+    EXPECT_THAT(get_pairs(), ElementsAre(SweepAndPrune::Pair(&first, &third),
+                                         SweepAndPrune::Pair(&second, &fourth)));
+}
+
+class Clear : public TestableSweepAndPrune { };
+
+TEST_F(Clear, RemovesAllEntities)
+{
+    auto& entity = add({30.f, 30.f});
+    sut.rebuild(entities);
+
+    sut.clear();
+    EXPECT_EQ(0, sut.size());
+    EXPECT_THAT(query({30.f, 30.f}), IsEmpty());
+    EXPECT_THAT(get_pairs(), IsEmpty());
+
+    // updating a cleared entity has no effect
+    sut.update(entity);
+    EXPECT_THAT(query({30.f, 30.f}), IsEmpty());
+}
+
+class Coherence : public TestableSweepAndPrune { };
+
+TEST_F(Coherence, MatchesBruteForceAcrossFrames)
+{
+    std::mt19937 random(7);
+    std::uniform_real_distribution<float> position(0.f, 600.f);
+    std::uniform_real_distribution<float> size(5.f, 40.f);
+    std::uniform_real_distribution<float> step(-15.f, 15.f);
+
+    for (int ndx = 0; ndx < 60; ++ndx) {
+        add({position(random), position(random)}, {size(random), size(random)});
+    }
+    add({300.f, 300.f}, {500.f, 20.f});
+
+    auto overlaps = [](const Entity& first, const Entity& second)
+    {
+        const auto first_box = first.get_component<Physics>()->get_box();
+        const auto second_box = second.get_component<Physics>()->get_box();
+        return first_box.get_min_corner().x <= second_box.get_max_corner().x &&
+               first_box.get_max_corner().x >= second_box.get_min_corner().x &&
+               first_box.get_min_corner().y <= second_box.get_max_corner().y &&
+               first_box.get_max_corner().y >= second_box.get_min_corner().y;
+    };
+
+    for (int frame = 0; frame < 20; ++frame) {
+        sut.rebuild(entities);
+
+        for(auto& entity : entities) {
+            auto* physics = entity->get_component<Physics>();
+            physics->move({step(random), step(random)});
+            sut.update(*entity);
+        }
+
+        SweepAndPrune::Pairs expected_pairs;
+        for (std::size_t first = 0; first < entities.size(); ++first) {
+            const auto box = entities[first]->get_component<Physics>()->get_box();
+
+            SweepAndPrune::Candidates expected;
+            for (std::size_t second = 0; second < entities.size(); ++second) {
+                if (overlaps(*entities[first], *entities[second])) {
+                    expected.push_back(entities[second].get());
+                }
+                if (second > first && overlaps(*entities[first], *entities[second])) {
+                    expected_pairs.emplace_back(entities[first].get(), entities[second].get());
+                }
+            }
+
+            ASSERT_EQ(expected, query(box.get_position(), box.get_dimensions()));
+        }
+
+        ASSERT_EQ(expected_pairs, get_pairs());
+    }
+}
@@ -1,14 +1,32 @@
 include(AI/AI_bullet_tests.cmake)
 include(AI/AI_enemy_tests.cmake)
 include(AI/A_star_tests.cmake)
+include(AI/clearance_map_tests.cmake)
+include(AI/flow_field_tests.cmake)
+include(AI/hierarchical_pathfinder_tests.cmake)
+include(AI/indexed_heap_tests.cmake)
+include(AI/path_cache_tests.cmake)
+include(AI/path_service_tests.cmake)
 include(AABB_tests.cmake)
+include(allocation_counter_tests.cmake)
 include(barrier_tests.cmake)
 include(bullet_tests.cmake)
 include(collision_tests.cmake)
+include(component_pool_tests.cmake)
 include(enemy_tests.cmake)
 include(entity_tests.cmake)
+include(game_tests.cmake)
 include(gun_tests.cmake)
+include(job_system_tests.cmake)
+include(occupancy_grid_tests.cmake)
 include(player_tests.cmake)
+include(profiler_tests.cmake)
 include(rate_limit_tests.cmake)
+include(render_snapshots_tests.cmake)
+include(shape_batch_tests.cmake)
+include(simulation_tests.cmake)
+include(spatial_hash_tests.cmake)
+include(sweep_and_prune_tests.cmake)
+include(tile_map_tests.cmake)
 # include(health_bar_tests.cmake)
 # include(health_tests.cmake)
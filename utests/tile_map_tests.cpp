@@ -0,0 +1,164 @@
+#include <gtest.h>
+#include <gmock.h>
+
+#include "tile_map.hpp"
+
+using namespace testing;
+
+class TestableTileMap : public Test
+{
+protected:
+    Tile go = {true};
+    Tile no = {false};
+};
+
+class Construct : public TestableTileMap { };
+
+TEST_F(Construct, FromRows)
+{
+    TileMap sut = {
+        {go, no, go},
+        {no, go, go},
+    };
+
+    EXPECT_EQ(3, sut.get_width());
+    EXPECT_EQ(2, sut.get_height());
+    EXPECT_TRUE(sut.is_passable({0, 0}));
+    EXPECT_FALSE(sut.is_passable({1, 0}));
+    EXPECT_FALSE(sut.is_passable({0, 1}));
+    EXPECT_TRUE(sut.is_passable({2, 1}));
+}
+
+TEST_F(Construct, FilledWithOneTile)
+{
+    TileMap open(70, 3);
+    TileMap closed(70, 3, no);
+
+    for (int y = 0; y < 3; ++y) {
+        for (int x = 0; x < 70; ++x) {
+            EXPECT_TRUE(open.is_passable({x, y}));
+            EXPECT_FALSE(closed.is_passable({x, y}));
+        }
+    }
+}
+
+TEST_F(Construct, EmptyMap)
+{
+    TileMap sut;
+
+    EXPECT_TRUE(sut.empty());
+    EXPECT_FALSE(sut.contains({0, 0}));
+    EXPECT_FALSE(sut.is_passable({0, 0}));
+}
+
+class Tiles : public TestableTileMap { };
+
+TEST_F(Tiles, OutsideTheMapIsImpassable)
+{
+    TileMap sut(70, 3);
+
+    EXPECT_FALSE(sut.is_passable({-1, 0}));
+    EXPECT_FALSE(sut.is_passable({0, -1}));
+    EXPECT_FALSE(sut.is_passable({70, 0}));
+    EXPECT_FALSE(sut.is_passable({0, 3}));
+}
+
+TEST_F(Tiles, SetOnlyChangesTheGivenTile)
+{
+    TileMap sut(130, 2);
+    sut.set({64, 1}, no);
+
+    EXPECT_FALSE(sut.is_passable({64, 1}));
+    EXPECT_TRUE(sut.is_passable({63, 1}));
+    EXPECT_TRUE(sut.is_passable({65, 1}));
+    EXPECT_TRUE(sut.is_passable({64, 0}));
+
+    sut.set({64, 1}, go);
+    EXPECT_TRUE(sut.is_passable({64, 1}));
+}
+
+TEST_F(Tiles, FillSpansWordsAndIsClippedToTheMap)
+{
+    TileMap sut(130, 4);
+    sut.fill({60, 1}, {80, 2}, no);
+
+    for (int x = 0; x < 130; ++x) {
+        EXPECT_TRUE(sut.is_passable({x, 0})) << "at " << x;
+        EXPECT_EQ(x < 60, sut.is_passable({x, 1})) << "at " << x;
+        EXPECT_EQ(x < 60, sut.is_passable({x, 2})) << "at " << x;
+        EXPECT_TRUE(sut.is_passable({x, 3})) << "at " << x;
+    }
+}
+
+TEST_F(Tiles, BitsPastTheRowAreClear)
+{
+    TileMap sut(70, 1);
+
+    EXPECT_EQ(~TileMap::Word(0), sut.get_word(0, 0));
+    EXPECT_EQ(TileMap::get_row_mask(1, 0, 70), sut.get_word(0, 1));
+    EXPECT_EQ(TileMap::Word(0x3f), sut.get_word(0, 1));
+}
+
+class RowMask : public TestableTileMap { };
+
+TEST_F(RowMask, CoversTheTilesOfTheGivenWord)
+{
+    EXPECT_EQ(TileMap::Word(0x1c), TileMap::get_row_mask(0, 2, 5));
+    EXPECT_EQ(~TileMap::Word(0), TileMap::get_row_mask(1, 0, 200));
+    EXPECT_EQ(TileMap::Word(1) << 63, TileMap::get_row_mask(0, 63, 65));
+    EXPECT_EQ(TileMap::Word(1), TileMap::get_row_mask(1, 63, 65));
+    EXPECT_EQ(TileMap::Word(0), TileMap::get_row_mask(2, 63, 65));
+}
+
+class IsClear : public TestableTileMap { };
+
+TEST_F(IsClear, EveryTileMustBePassable)
+{
+    TileMap sut(130, 10);
+    sut.set({100, 5}, no);
+
+    EXPECT_TRUE(sut.is_clear({0, 0}, {130, 5}));
+    EXPECT_TRUE(sut.is_clear({60, 3}, {40, 7}));
+    EXPECT_FALSE(sut.is_clear({60, 3}, {41, 7}));
+    EXPECT_FALSE(sut.is_clear({100, 5}, {1, 1}));
+    EXPECT_TRUE(sut.is_clear({101, 0}, {29, 10}));
+}
+
+TEST_F(IsClear, RectanglesHangingOffTheMapAreNotClear)
+{
+    TileMap sut(130, 10);
+
+    EXPECT_FALSE(sut.is_clear({-1, 0}, {2, 2}));
+    EXPECT_FALSE(sut.is_clear({0, -1}, {2, 2}));
+    EXPECT_FALSE(sut.is_clear({129, 0}, {2, 1}));
+    EXPECT_FALSE(sut.is_clear({0, 9}, {1, 2}));
+    EXPECT_TRUE(sut.is_clear({0, 0}, {0, 0}));
+}
+
+TEST_F(IsClear, LargeMaps)
+{
+    TileMap sut(512, 512);
+    sut.fill({0, 256}, {511, 1}, no);
+
+    EXPECT_TRUE(sut.is_clear({0, 0}, {512, 256}));
+    EXPECT_FALSE(sut.is_clear({0, 200}, {512, 100}));
+    EXPECT_TRUE(sut.is_clear({511, 0}, {1, 512}));
+}
+
+class Compare : public TestableTileMap { };
+
+TEST_F(Compare, MapsAreEqualWhenTheirSizesAndTilesAre)
+{
+    TileMap first(70, 2);
+    TileMap second(70, 2);
+    EXPECT_EQ(first, second);
+
+    second.set({69, 1}, no);
+    EXPECT_NE(first, second);
+
+    second.set({69, 1}, go);
+    EXPECT_EQ(first, second);
+
+    EXPECT_NE(first, TileMap(70, 3));
+    EXPECT_NE(first, TileMap(71, 2));
+}